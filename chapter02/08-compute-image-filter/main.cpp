@@ -8,6 +8,8 @@
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_vulkan.h>
 
+#include "vk_mipmap.h"
+
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -16,12 +18,46 @@
 #include <stdexcept>
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <string>
+#include <limits>
 
 const uint32_t WIDTH = 1024;
 const uint32_t HEIGHT = 768;
 const int MAX_FRAMES_IN_FLIGHT = 2;
 const uint32_t IMAGE_WIDTH = 512;
 const uint32_t IMAGE_HEIGHT = 512;
+const uint32_t HISTOGRAM_CHANNELS = 4;    // R, G, B, Luminance
+const uint32_t HISTOGRAM_BINS = 256;
+
+// Dirty tile 추적 단위 (filter.comp workgroup 크기와 동일)
+const uint32_t TILE_SIZE = 16;
+const uint32_t TILE_COUNT_X = (IMAGE_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+const uint32_t TILE_COUNT_Y = (IMAGE_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+
+// Timestamp query: [0-1] histogram, [2-3] filter pass, [4-5] mip 생성
+const uint32_t QUERIES_PER_FRAME = 6;
+
+// Custom kernel convolution
+const int FILTER_CUSTOM_KERNEL = 10;
+const uint32_t FFT_SIZE = 1024;              // fft.comp의 FFT_SIZE와 동일 (512 + 커널 크기를 wrap 없이 수용)
+const uint32_t SPECTRUM_CHANNELS = 4;        // 이미지 RGB + 커널
+const int MAX_KERNEL_RADIUS = 127;           // 최대 255x255 커널
+const int MAX_KERNEL_SIZE = 2 * MAX_KERNEL_RADIUS + 1;
+
+// Edge-preserving filters
+const int FILTER_BILATERAL = 11;             // filter.comp (shared memory tile cache)
+const int FILTER_GUIDED = 12;                // guided.comp + integral.comp (SAT box filter)
+const int MAX_BILATERAL_RADIUS = 8;          // filter.comp의 tile cache 크기와 동일
+const int MAX_GUIDED_RADIUS = 16;            // guided.comp 고정소수점 범위와 동일
+const uint32_t GUIDED_CHANNELS = 14;         // 통계 8 + 계수 a/b 6
+
+enum ConvolutionPath {
+    CONVOLUTION_AUTO = 0,
+    CONVOLUTION_DIRECT,
+    CONVOLUTION_SEPARABLE,
+    CONVOLUTION_FFT
+};
 
 // Filter parameters UBO
 struct FilterParams {
@@ -29,6 +65,61 @@ struct FilterParams {
     float intensity;
     float param1;
     float param2;
+    float sigmaSpatial;
+    float sigmaRange;
+    int radius;
+    int bruteForce;
+};
+
+// Histogram SSBO (histogram.comp / histogram_scan.comp / filter.comp 공통 레이아웃)
+struct HistogramData {
+    uint32_t bins[HISTOGRAM_CHANNELS * HISTOGRAM_BINS];
+    uint32_t cdf[HISTOGRAM_CHANNELS * HISTOGRAM_BINS];
+    uint32_t lowBin[HISTOGRAM_CHANNELS];
+    uint32_t highBin[HISTOGRAM_CHANNELS];
+};
+
+// 픽셀 단위 사각형 영역 [x0, x1) x [y0, y1)
+struct DirtyRect {
+    int32_t x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+
+    bool empty() const { return x0 >= x1 || y0 >= y1; }
+
+    void merge(const DirtyRect& other) {
+        if (other.empty()) return;
+        if (empty()) { *this = other; return; }
+        x0 = std::min(x0, other.x0);
+        y0 = std::min(y0, other.y0);
+        x1 = std::max(x1, other.x1);
+        y1 = std::max(y1, other.y1);
+    }
+};
+
+// convolve.comp / fft.comp / fft_convolve.comp 공통 push constants
+struct ConvolvePushConstants {
+    int mode;           // 셰이더별 단계 선택
+    int radius;         // 커널 반경 (K = 2 * radius + 1)
+    int axis;           // fft: 0=rows, 1=columns
+    int inverse;        // fft: 0=forward, 1=inverse
+    int channelOffset;  // fft: spectrum channel 시작 (0=이미지 RGB, 3=커널)
+    float intensity;
+};
+
+// guided.comp / integral.comp push constants
+struct GuidedPushConstants {
+    int mode;           // guided.comp 단계 (0=통계, 1=계수, 2=출력)
+    int radius;
+    float epsilon;
+    int bruteForce;     // 1 = SAT 대신 window 직접 순회
+    int axis;           // integral.comp: 0=rows, 1=columns
+    int channelOffset;  // integral.comp: channel 시작 인덱스
+    float intensity;
+};
+
+// Histogram push constants
+struct HistogramPushConstants {
+    int mode;            // 0=Naive (global atomics), 1=Shared + Subgroup
+    float clipFraction;  // Auto-levels clip 비율
 };
 
 class ComputeImageFilterApp {
@@ -67,18 +158,85 @@ private:
     VkImage sourceImage;
     VkDeviceMemory sourceImageMemory;
     VkImageView sourceImageView;
+    std::vector<uint8_t> sourcePixels;   // CPU 사본 (brush 편집, 부분 업로드용)
+
+    // 부분 업로드용 staging buffer (프레임마다)
+    std::vector<VkBuffer> uploadStagingBuffers;
+    std::vector<VkDeviceMemory> uploadStagingMemory;
+    std::vector<void*> uploadStagingMapped;
 
     // Filtered image (output)
     VkImage filteredImage;
     VkDeviceMemory filteredImageMemory;
-    VkImageView filteredImageView;
+    VkImageView filteredImageView;           // mip 0 (storage)
+    VkImageView filteredSampledView;         // 전체 mip chain (display sampling)
+    uint32_t filteredMipLevels = 1;
     VkSampler imageSampler;
 
+    // Filtered image mip chain (common/modules/vk_mipmap)
+    vk::VulkanMipGenerator mipGenerator;
+    vk::MipChainTarget filteredMipTarget;
+
+    // Separable convolution 중간 결과
+    VkImage tempImage;
+    VkDeviceMemory tempImageMemory;
+    VkImageView tempImageView;
+
+    // Custom kernel convolution (direct / separable / FFT)
+    VkDescriptorSetLayout convolveDescriptorSetLayout;
+    VkPipelineLayout convolvePipelineLayout;
+    VkPipeline convolvePipeline;
+    VkPipeline fftPipeline;
+    VkPipeline fftConvolvePipeline;
+    VkDescriptorSet convolveDescriptorSet;
+
+    VkBuffer kernelWeightsBuffer;
+    VkDeviceMemory kernelWeightsMemory;
+    void* kernelWeightsMapped;
+    VkBuffer spectrumBuffer;                  // [channel][FFT_SIZE][FFT_SIZE] vec2
+    VkDeviceMemory spectrumBufferMemory;
+
+    // Guided filter (통계 + 계수 integral image)
+    VkDescriptorSetLayout guidedDescriptorSetLayout;
+    VkPipelineLayout guidedPipelineLayout;
+    VkPipeline guidedPipeline;
+    VkPipeline integralPipeline;
+    VkDescriptorSet guidedDescriptorSet;
+    VkBuffer guidedBuffer;                    // [GUIDED_CHANNELS][IMAGE_HEIGHT][IMAGE_WIDTH] uint
+    VkDeviceMemory guidedBufferMemory;
+
     // Compute pipeline
     VkDescriptorSetLayout computeDescriptorSetLayout;
     VkPipelineLayout computePipelineLayout;
     VkPipeline computePipeline;
 
+    // Histogram pipelines (build + prefix-sum scan)
+    VkDescriptorSetLayout histogramDescriptorSetLayout;
+    VkPipelineLayout histogramPipelineLayout;
+    VkPipeline histogramPipeline;
+    VkPipeline histogramScanPipeline;
+    VkDescriptorSet histogramDescriptorSet;
+
+    // Histogram buffer (device local) + CPU readback (ImGui 표시용)
+    VkBuffer histogramBuffer;
+    VkDeviceMemory histogramBufferMemory;
+    std::vector<VkBuffer> histogramReadbackBuffers;
+    std::vector<VkDeviceMemory> histogramReadbackMemory;
+    std::vector<void*> histogramReadbackMapped;
+
+    // GPU timestamp (histogram build 시간 측정)
+    VkQueryPool timestampQueryPool;
+    float timestampPeriod = 1.0f;
+    bool timestampsSupported = false;
+    std::vector<bool> computeFrameHistogramBuilt;
+    std::vector<bool> computeFrameFiltered;
+    std::vector<int> computeFrameHistogramMode;
+    std::vector<int> computeFrameEdgeFilter;  // -1 또는 edgeFilterMs 인덱스
+    std::vector<int> computeFrameConvolutionPath;  // -1 또는 측정할 ConvolutionPath (direct / FFT)
+    std::vector<int> computeFrameConvolutionTaps;  // direct 경로의 K²
+    std::vector<bool> computeFrameMipsGenerated;
+    uint32_t subgroupSize = 0;
+
     // Graphics pipeline (fullscreen quad)
     VkDescriptorSetLayout graphicsDescriptorSetLayout;
     VkPipelineLayout graphicsPipelineLayout;
@@ -114,13 +272,77 @@ private:
     int filterType = 0;
     float intensity = 1.0f;
     bool applyVignette = false;
-    bool needsRecompute = true;
-
-    const char* filterNames[8] = {
+    bool needsRecompute = true;      // 필터 파라미터 변경 → 전체 이미지 재계산
+
+    // Incremental refiltering
+    std::vector<uint8_t> dirtyTiles;     // TILE_COUNT_X * TILE_COUNT_Y, 1 = 재계산 필요
+    DirtyRect pendingSourceUpload;       // GPU에 아직 올라가지 않은 source 편집 영역
+    bool histogramDirty = true;
+    bool rebuildHistogramEveryFrame = false;
+    bool refilterEveryFrame = false;
+    uint32_t lastDispatchedTiles = 0;
+    uint32_t lastDispatchCount = 0;
+    float filterPassMs = 0.0f;
+
+    // Mipmaps
+    bool generateMipmaps = true;
+    int mipFilter = static_cast<int>(vk::MipFilter::Box);
+    bool mipSrgb = true;
+    bool mipsDirty = true;
+    float displayLod = -1.0f;                // -1 = 자동 (하드웨어 LOD 선택)
+    float mipGenerationMs = 0.0f;
+    const char* mipFilterNames[2] = { "Box", "Kaiser" };
+
+    // Brush
+    bool brushEnabled = false;
+    float brushRadius = 12.0f;
+    float brushColor[3] = {1.0f, 1.0f, 1.0f};
+
+    const char* filterNames[13] = {
         "None", "Blur", "Sharpen", "Edge Detection",
-        "Emboss", "Grayscale", "Invert", "Sepia"
+        "Emboss", "Grayscale", "Invert", "Sepia",
+        "Auto Levels", "Equalize", "Custom Kernel", "Bilateral",
+        "Guided"
     };
 
+    // Edge-preserving filter settings
+    int bilateralRadius = 4;
+    float bilateralSigmaSpatial = 3.0f;
+    float bilateralSigmaRange = 0.1f;
+    int guidedRadius = 8;
+    float guidedEpsilon = 0.01f;
+    bool bruteForceReference = false;
+    float edgeFilterMs[4] = {};              // [Bilateral, Bilateral brute, Guided, Guided brute]
+
+    // Custom kernel settings
+    int kernelShape = 2;
+    int kernelRadius = 8;
+    int convolutionPathSetting = CONVOLUTION_AUTO;
+    ConvolutionPath activeConvolutionPath = CONVOLUTION_DIRECT;
+    float fftCostEstimate = 600.0f;          // FFT 경로 비용 (direct tap 수 환산), 측정 전 기본값
+    float directMsPerTap = 0.0f;             // direct 경로 filter pass ms / K² (exponential moving average)
+    float fftConvolutionMs = 0.0f;           // FFT 경로 filter pass ms (exponential moving average)
+    bool kernelDirty = true;
+    bool kernelSpectrumDirty = true;
+    bool kernelSeparable = false;
+    int loadedKernelRadius = 0;              // 현재 GPU에 올라간 커널 반경
+    char kernelFilePath[256] = "kernel.pgm";
+    std::string kernelStatus;
+
+    const char* kernelShapeNames[6] = { "Box", "Gaussian", "Disc (Bokeh)", "Hexagon", "Ring", "PGM File" };
+    const char* convolutionPathNames[4] = { "Auto", "Direct", "Separable", "FFT" };
+
+    // Histogram settings
+    int histogramMode = 1;
+    float clipFraction = 0.005f;
+    int histogramChannel = 3;
+    float histogramBuildMs[2] = {0.0f, 0.0f};   // mode별 평균 (exponential moving average)
+    float histogramPlot[HISTOGRAM_CHANNELS][HISTOGRAM_BINS] = {};
+    float histogramPlotMax[HISTOGRAM_CHANNELS] = {};
+
+    const char* histogramModeNames[2] = { "Naive (Global Atomics)", "Shared + Subgroup" };
+    const char* histogramChannelNames[HISTOGRAM_CHANNELS] = { "Red", "Green", "Blue", "Luminance" };
+
     void initWindow() {
         glfwInit();
         glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
@@ -144,19 +366,31 @@ private:
         createImageViews();
         createRenderPass();
         createComputeDescriptorSetLayout();
+        createHistogramDescriptorSetLayout();
+        createConvolveDescriptorSetLayout();
+        createGuidedDescriptorSetLayout();
         createGraphicsDescriptorSetLayout();
         createComputePipeline();
+        createHistogramPipelines();
+        createConvolvePipelines();
+        createGuidedPipelines();
         createGraphicsPipeline();
         createFramebuffers();
         createCommandPools();
         createImages();
         generateProceduralImage();
         createImageSampler();
+        createMipGenerator();
         createUniformBuffers();
+        createHistogramBuffers();
+        createUploadStagingBuffers();
+        createConvolutionBuffers();
+        createGuidedBuffer();
         createDescriptorPool();
         createDescriptorSets();
         createCommandBuffers();
         createSyncObjects();
+        createTimestampQueryPool();
         initImGui();
     }
 
@@ -237,9 +471,29 @@ private:
         vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
         physicalDevice = devices[0];
 
-        VkPhysicalDeviceProperties props;
-        vkGetPhysicalDeviceProperties(physicalDevice, &props);
+        // Histogram/scan 셰이더는 subgroup ballot + arithmetic 연산이 필요 (Vulkan 1.1 core)
+        VkPhysicalDeviceSubgroupProperties subgroupProps{};
+        subgroupProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+
+        VkPhysicalDeviceProperties2 props2{};
+        props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        props2.pNext = &subgroupProps;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &props2);
+
+        const VkPhysicalDeviceProperties& props = props2.properties;
         std::cout << "GPU: " << props.deviceName << std::endl;
+        std::cout << "Subgroup size: " << subgroupProps.subgroupSize << std::endl;
+
+        VkSubgroupFeatureFlags requiredOps = VK_SUBGROUP_FEATURE_BASIC_BIT |
+                                             VK_SUBGROUP_FEATURE_BALLOT_BIT |
+                                             VK_SUBGROUP_FEATURE_ARITHMETIC_BIT;
+        if (!(subgroupProps.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT) ||
+            (subgroupProps.supportedOperations & requiredOps) != requiredOps) {
+            throw std::runtime_error("GPU does not support subgroup ballot/arithmetic in compute shaders!");
+        }
+
+        subgroupSize = subgroupProps.subgroupSize;
+        timestampPeriod = props.limits.timestampPeriod;
     }
 
     void createLogicalDevice() {
@@ -260,6 +514,8 @@ private:
             if (presentSupport) presentFamily = i;
         }
 
+        timestampsSupported = queueFamilies[computeFamily].timestampValidBits > 0;
+
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
         std::set<uint32_t> uniqueQueueFamilies = {graphicsFamily, presentFamily, computeFamily};
         float queuePriority = 1.0f;
@@ -416,7 +672,7 @@ private:
     }
 
     void createComputeDescriptorSetLayout() {
-        std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
+        std::array<VkDescriptorSetLayoutBinding, 4> bindings{};
 
         // Input image
         bindings[0].binding = 0;
@@ -436,6 +692,12 @@ private:
         bindings[2].descriptorCount = 1;
         bindings[2].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
 
+        // Histogram / CDF (auto levels, equalize)
+        bindings[3].binding = 3;
+        bindings[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[3].descriptorCount = 1;
+        bindings[3].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
         VkDescriptorSetLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
         layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
@@ -446,6 +708,87 @@ private:
         }
     }
 
+    void createHistogramDescriptorSetLayout() {
+        std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+
+        // Source image
+        bindings[0].binding = 0;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        // Histogram buffer
+        bindings[1].binding = 1;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &histogramDescriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create histogram descriptor set layout!");
+        }
+    }
+
+    void createConvolveDescriptorSetLayout() {
+        std::array<VkDescriptorSetLayoutBinding, 5> bindings{};
+
+        // 0: source, 1: output, 2: temp (storage images)
+        for (uint32_t i = 0; i < 3; i++) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        // 3: kernel weights, 4: spectrum (storage buffers)
+        for (uint32_t i = 3; i < 5; i++) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &convolveDescriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create convolve descriptor set layout!");
+        }
+    }
+
+    void createGuidedDescriptorSetLayout() {
+        std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
+
+        // 0: source, 1: output (storage images)
+        for (uint32_t i = 0; i < 2; i++) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        // 2: 통계 / 계수 integral image (storage buffer)
+        bindings[2].binding = 2;
+        bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[2].descriptorCount = 1;
+        bindings[2].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &guidedDescriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create guided descriptor set layout!");
+        }
+    }
+
     void createGraphicsDescriptorSetLayout() {
         VkDescriptorSetLayoutBinding samplerBinding{};
         samplerBinding.binding = 0;
@@ -512,6 +855,8 @@ private:
         pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
         pipelineInfo.stage = compShaderStageInfo;
         pipelineInfo.layout = computePipelineLayout;
+        // Dirty tile만 dispatch하기 위해 vkCmdDispatchBase 사용
+        pipelineInfo.flags = VK_PIPELINE_CREATE_DISPATCH_BASE_BIT;
 
         if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &computePipeline) != VK_SUCCESS) {
             throw std::runtime_error("failed to create compute pipeline!");
@@ -520,6 +865,91 @@ private:
         vkDestroyShaderModule(device, compShaderModule, nullptr);
     }
 
+    void createHistogramPipelines() {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(HistogramPushConstants);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &histogramDescriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &histogramPipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create histogram pipeline layout!");
+        }
+
+        histogramPipeline = createComputePipelineFromFile("shaders/histogram_comp.spv", histogramPipelineLayout);
+        histogramScanPipeline = createComputePipelineFromFile("shaders/histogram_scan_comp.spv", histogramPipelineLayout);
+    }
+
+    void createConvolvePipelines() {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(ConvolvePushConstants);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &convolveDescriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &convolvePipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create convolve pipeline layout!");
+        }
+
+        convolvePipeline = createComputePipelineFromFile("shaders/convolve_comp.spv", convolvePipelineLayout);
+        fftPipeline = createComputePipelineFromFile("shaders/fft_comp.spv", convolvePipelineLayout);
+        fftConvolvePipeline = createComputePipelineFromFile("shaders/fft_convolve_comp.spv", convolvePipelineLayout);
+    }
+
+    void createGuidedPipelines() {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(GuidedPushConstants);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &guidedDescriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &guidedPipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create guided pipeline layout!");
+        }
+
+        guidedPipeline = createComputePipelineFromFile("shaders/guided_comp.spv", guidedPipelineLayout);
+        integralPipeline = createComputePipelineFromFile("shaders/integral_comp.spv", guidedPipelineLayout);
+    }
+
+    VkPipeline createComputePipelineFromFile(const std::string& filename, VkPipelineLayout layout) {
+        auto shaderCode = readFile(filename);
+        VkShaderModule shaderModule = createShaderModule(shaderCode);
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = shaderModule;
+        pipelineInfo.stage.pName = "main";
+        pipelineInfo.layout = layout;
+
+        VkPipeline pipeline;
+        if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create compute pipeline: " + filename);
+        }
+
+        vkDestroyShaderModule(device, shaderModule, nullptr);
+        return pipeline;
+    }
+
     void createGraphicsPipeline() {
         auto vertShaderCode = readFile("shaders/fullscreen_vert.spv");
         auto fragShaderCode = readFile("shaders/fullscreen_frag.spv");
@@ -584,6 +1014,14 @@ private:
         pipelineLayoutInfo.setLayoutCount = 1;
         pipelineLayoutInfo.pSetLayouts = &graphicsDescriptorSetLayout;
 
+        // 표시할 mip level (fullscreen.frag)
+        VkPushConstantRange lodPushConstant{};
+        lodPushConstant.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        lodPushConstant.offset = 0;
+        lodPushConstant.size = sizeof(float);
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &lodPushConstant;
+
         if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &graphicsPipelineLayout) != VK_SUCCESS) {
             throw std::runtime_error("failed to create graphics pipeline layout!");
         }
@@ -658,15 +1096,42 @@ private:
         throw std::runtime_error("failed to find suitable memory type!");
     }
 
+    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                      VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = usage;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create buffer!");
+        }
+
+        VkMemoryRequirements memRequirements;
+        vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+
+        if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate buffer memory!");
+        }
+
+        vkBindBufferMemory(device, buffer, bufferMemory, 0);
+    }
+
     void createImage(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage,
-                     VkImage& image, VkDeviceMemory& imageMemory) {
+                     VkImage& image, VkDeviceMemory& imageMemory, uint32_t mipLevels = 1) {
         VkImageCreateInfo imageInfo{};
         imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         imageInfo.imageType = VK_IMAGE_TYPE_2D;
         imageInfo.extent.width = width;
         imageInfo.extent.height = height;
         imageInfo.extent.depth = 1;
-        imageInfo.mipLevels = 1;
+        imageInfo.mipLevels = mipLevels;
         imageInfo.arrayLayers = 1;
         imageInfo.format = format;
         imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
@@ -694,7 +1159,7 @@ private:
         vkBindImageMemory(device, image, imageMemory, 0);
     }
 
-    VkImageView createImageView(VkImage image, VkFormat format) {
+    VkImageView createImageView(VkImage image, VkFormat format, uint32_t levelCount = 1) {
         VkImageViewCreateInfo viewInfo{};
         viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
         viewInfo.image = image;
@@ -702,7 +1167,7 @@ private:
         viewInfo.format = format;
         viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         viewInfo.subresourceRange.baseMipLevel = 0;
-        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.levelCount = levelCount;
         viewInfo.subresourceRange.baseArrayLayer = 0;
         viewInfo.subresourceRange.layerCount = 1;
 
@@ -720,16 +1185,25 @@ private:
             sourceImage, sourceImageMemory);
         sourceImageView = createImageView(sourceImage, VK_FORMAT_R8G8B8A8_UNORM);
 
-        // Filtered image
+        // Filtered image (전체 mip chain, mip 1~는 compute mip generator가 생성)
+        filteredMipLevels = vk::VulkanMipGenerator::mipLevelCount({IMAGE_WIDTH, IMAGE_HEIGHT});
         createImage(IMAGE_WIDTH, IMAGE_HEIGHT, VK_FORMAT_R8G8B8A8_UNORM,
             VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-            filteredImage, filteredImageMemory);
+            filteredImage, filteredImageMemory, filteredMipLevels);
         filteredImageView = createImageView(filteredImage, VK_FORMAT_R8G8B8A8_UNORM);
+        filteredSampledView = createImageView(filteredImage, VK_FORMAT_R8G8B8A8_UNORM, filteredMipLevels);
+
+        // Separable convolution 중간 결과 (가로 pass 출력, 정밀도 유지를 위해 16-bit float)
+        createImage(IMAGE_WIDTH, IMAGE_HEIGHT, VK_FORMAT_R16G16B16A16_SFLOAT,
+            VK_IMAGE_USAGE_STORAGE_BIT,
+            tempImage, tempImageMemory);
+        tempImageView = createImageView(tempImage, VK_FORMAT_R16G16B16A16_SFLOAT);
     }
 
-    void generateProceduralImage() {
+    void generateProceduralPixels() {
         // Generate a procedural test pattern
-        std::vector<uint8_t> pixels(IMAGE_WIDTH * IMAGE_HEIGHT * 4);
+        sourcePixels.resize(IMAGE_WIDTH * IMAGE_HEIGHT * 4);
+        std::vector<uint8_t>& pixels = sourcePixels;
 
         for (uint32_t y = 0; y < IMAGE_HEIGHT; y++) {
             for (uint32_t x = 0; x < IMAGE_WIDTH; x++) {
@@ -782,6 +1256,11 @@ private:
                 pixels[idx + 3] = 255;
             }
         }
+    }
+
+    void generateProceduralImage() {
+        generateProceduralPixels();
+        const std::vector<uint8_t>& pixels = sourcePixels;
 
         // Upload to source image via staging buffer
         VkDeviceSize imageSize = IMAGE_WIDTH * IMAGE_HEIGHT * 4;
@@ -869,13 +1348,21 @@ private:
         vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
             0, 0, nullptr, 0, nullptr, 1, &barrier);
 
-        // Transition filtered image to general
+        // Transition filtered image to general (모든 mip level)
         barrier.image = filteredImage;
+        barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
         barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
         barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
         barrier.srcAccessMask = 0;
         barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
 
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        // Transition temp image to general
+        barrier.image = tempImage;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
         vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
             0, 0, nullptr, 0, nullptr, 1, &barrier);
 
@@ -907,12 +1394,19 @@ private:
         samplerInfo.unnormalizedCoordinates = VK_FALSE;
         samplerInfo.compareEnable = VK_FALSE;
         samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        samplerInfo.minLod = 0.0f;
+        samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
 
         if (vkCreateSampler(device, &samplerInfo, nullptr, &imageSampler) != VK_SUCCESS) {
             throw std::runtime_error("failed to create sampler!");
         }
     }
 
+    void createMipGenerator() {
+        mipGenerator.create(physicalDevice, device, "shaders/mip_downsample_comp.spv");
+        filteredMipTarget = mipGenerator.createTarget(filteredImage, {IMAGE_WIDTH, IMAGE_HEIGHT}, filteredMipLevels);
+    }
+
     void createUniformBuffers() {
         VkDeviceSize bufferSize = sizeof(FilterParams);
 
@@ -944,20 +1438,80 @@ private:
         }
     }
 
+    void createUploadStagingBuffers() {
+        VkDeviceSize bufferSize = IMAGE_WIDTH * IMAGE_HEIGHT * 4;
+
+        uploadStagingBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        uploadStagingMemory.resize(MAX_FRAMES_IN_FLIGHT);
+        uploadStagingMapped.resize(MAX_FRAMES_IN_FLIGHT);
+
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                uploadStagingBuffers[i], uploadStagingMemory[i]);
+            vkMapMemory(device, uploadStagingMemory[i], 0, bufferSize, 0, &uploadStagingMapped[i]);
+        }
+
+        dirtyTiles.assign(TILE_COUNT_X * TILE_COUNT_Y, 1);
+    }
+
+    void createConvolutionBuffers() {
+        // 2D 커널 + separable 가로/세로 성분
+        VkDeviceSize weightsSize = sizeof(float) * (MAX_KERNEL_SIZE * MAX_KERNEL_SIZE + 2 * MAX_KERNEL_SIZE);
+        createBuffer(weightsSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            kernelWeightsBuffer, kernelWeightsMemory);
+        vkMapMemory(device, kernelWeightsMemory, 0, weightsSize, 0, &kernelWeightsMapped);
+
+        VkDeviceSize spectrumSize = sizeof(float) * 2 * SPECTRUM_CHANNELS * FFT_SIZE * FFT_SIZE;
+        createBuffer(spectrumSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            spectrumBuffer, spectrumBufferMemory);
+    }
+
+    void createGuidedBuffer() {
+        VkDeviceSize bufferSize = sizeof(uint32_t) * GUIDED_CHANNELS * IMAGE_WIDTH * IMAGE_HEIGHT;
+        createBuffer(bufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            guidedBuffer, guidedBufferMemory);
+    }
+
+    void createHistogramBuffers() {
+        VkDeviceSize bufferSize = sizeof(HistogramData);
+
+        createBuffer(bufferSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            histogramBuffer, histogramBufferMemory);
+
+        histogramReadbackBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        histogramReadbackMemory.resize(MAX_FRAMES_IN_FLIGHT);
+        histogramReadbackMapped.resize(MAX_FRAMES_IN_FLIGHT);
+
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                histogramReadbackBuffers[i], histogramReadbackMemory[i]);
+            vkMapMemory(device, histogramReadbackMemory[i], 0, bufferSize, 0, &histogramReadbackMapped[i]);
+        }
+    }
+
     void createDescriptorPool() {
-        std::array<VkDescriptorPoolSize, 3> poolSizes{};
+        std::array<VkDescriptorPoolSize, 4> poolSizes{};
         poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-        poolSizes[0].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * 2);
+        poolSizes[0].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * 2 + 1 + 3 + 2);
         poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
         poolSizes[1].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
         poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
         poolSizes[2].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+        poolSizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSizes[3].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT + 1 + 2 + 1);
 
         VkDescriptorPoolCreateInfo poolInfo{};
         poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
         poolInfo.pPoolSizes = poolSizes.data();
-        poolInfo.maxSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * 2);
+        poolInfo.maxSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * 2 + 3);
 
         if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
             throw std::runtime_error("failed to create descriptor pool!");
@@ -1002,7 +1556,12 @@ private:
             bufferInfo.offset = 0;
             bufferInfo.range = sizeof(FilterParams);
 
-            std::array<VkWriteDescriptorSet, 3> computeWrites{};
+            VkDescriptorBufferInfo histogramInfo{};
+            histogramInfo.buffer = histogramBuffer;
+            histogramInfo.offset = 0;
+            histogramInfo.range = sizeof(HistogramData);
+
+            std::array<VkWriteDescriptorSet, 4> computeWrites{};
             computeWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
             computeWrites[0].dstSet = computeDescriptorSets[i];
             computeWrites[0].dstBinding = 0;
@@ -1024,12 +1583,19 @@ private:
             computeWrites[2].descriptorCount = 1;
             computeWrites[2].pBufferInfo = &bufferInfo;
 
+            computeWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            computeWrites[3].dstSet = computeDescriptorSets[i];
+            computeWrites[3].dstBinding = 3;
+            computeWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            computeWrites[3].descriptorCount = 1;
+            computeWrites[3].pBufferInfo = &histogramInfo;
+
             vkUpdateDescriptorSets(device, static_cast<uint32_t>(computeWrites.size()), computeWrites.data(), 0, nullptr);
 
             // Update graphics descriptor set
             VkDescriptorImageInfo samplerInfo{};
             samplerInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            samplerInfo.imageView = filteredImageView;
+            samplerInfo.imageView = filteredSampledView;
             samplerInfo.sampler = imageSampler;
 
             VkWriteDescriptorSet graphicsWrite{};
@@ -1042,6 +1608,107 @@ private:
 
             vkUpdateDescriptorSets(device, 1, &graphicsWrite, 0, nullptr);
         }
+
+        // Histogram descriptor set (source image + histogram buffer, 프레임 간 공유)
+        VkDescriptorSetAllocateInfo histogramAllocInfo{};
+        histogramAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        histogramAllocInfo.descriptorPool = descriptorPool;
+        histogramAllocInfo.descriptorSetCount = 1;
+        histogramAllocInfo.pSetLayouts = &histogramDescriptorSetLayout;
+        vkAllocateDescriptorSets(device, &histogramAllocInfo, &histogramDescriptorSet);
+
+        VkDescriptorImageInfo sourceImageInfo{};
+        sourceImageInfo.imageView = sourceImageView;
+        sourceImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+        VkDescriptorBufferInfo histogramInfo{};
+        histogramInfo.buffer = histogramBuffer;
+        histogramInfo.offset = 0;
+        histogramInfo.range = sizeof(HistogramData);
+
+        std::array<VkWriteDescriptorSet, 2> histogramWrites{};
+        histogramWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        histogramWrites[0].dstSet = histogramDescriptorSet;
+        histogramWrites[0].dstBinding = 0;
+        histogramWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        histogramWrites[0].descriptorCount = 1;
+        histogramWrites[0].pImageInfo = &sourceImageInfo;
+
+        histogramWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        histogramWrites[1].dstSet = histogramDescriptorSet;
+        histogramWrites[1].dstBinding = 1;
+        histogramWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        histogramWrites[1].descriptorCount = 1;
+        histogramWrites[1].pBufferInfo = &histogramInfo;
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(histogramWrites.size()), histogramWrites.data(), 0, nullptr);
+
+        // Convolve descriptor set (direct / separable / FFT 공통)
+        VkDescriptorSetAllocateInfo convolveAllocInfo{};
+        convolveAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        convolveAllocInfo.descriptorPool = descriptorPool;
+        convolveAllocInfo.descriptorSetCount = 1;
+        convolveAllocInfo.pSetLayouts = &convolveDescriptorSetLayout;
+        vkAllocateDescriptorSets(device, &convolveAllocInfo, &convolveDescriptorSet);
+
+        std::array<VkDescriptorImageInfo, 3> convolveImageInfos{};
+        convolveImageInfos[0].imageView = sourceImageView;
+        convolveImageInfos[1].imageView = filteredImageView;
+        convolveImageInfos[2].imageView = tempImageView;
+        for (auto& info : convolveImageInfos) {
+            info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        }
+
+        std::array<VkDescriptorBufferInfo, 2> convolveBufferInfos{};
+        convolveBufferInfos[0].buffer = kernelWeightsBuffer;
+        convolveBufferInfos[0].range = VK_WHOLE_SIZE;
+        convolveBufferInfos[1].buffer = spectrumBuffer;
+        convolveBufferInfos[1].range = VK_WHOLE_SIZE;
+
+        std::array<VkWriteDescriptorSet, 5> convolveWrites{};
+        for (uint32_t i = 0; i < 5; i++) {
+            convolveWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            convolveWrites[i].dstSet = convolveDescriptorSet;
+            convolveWrites[i].dstBinding = i;
+            convolveWrites[i].descriptorCount = 1;
+            if (i < 3) {
+                convolveWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                convolveWrites[i].pImageInfo = &convolveImageInfos[i];
+            } else {
+                convolveWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                convolveWrites[i].pBufferInfo = &convolveBufferInfos[i - 3];
+            }
+        }
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(convolveWrites.size()), convolveWrites.data(), 0, nullptr);
+
+        // Guided filter descriptor set
+        VkDescriptorSetAllocateInfo guidedAllocInfo{};
+        guidedAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        guidedAllocInfo.descriptorPool = descriptorPool;
+        guidedAllocInfo.descriptorSetCount = 1;
+        guidedAllocInfo.pSetLayouts = &guidedDescriptorSetLayout;
+        vkAllocateDescriptorSets(device, &guidedAllocInfo, &guidedDescriptorSet);
+
+        VkDescriptorBufferInfo guidedBufferInfo{};
+        guidedBufferInfo.buffer = guidedBuffer;
+        guidedBufferInfo.range = VK_WHOLE_SIZE;
+
+        std::array<VkWriteDescriptorSet, 3> guidedWrites{};
+        for (uint32_t i = 0; i < 3; i++) {
+            guidedWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            guidedWrites[i].dstSet = guidedDescriptorSet;
+            guidedWrites[i].dstBinding = i;
+            guidedWrites[i].descriptorCount = 1;
+        }
+        guidedWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        guidedWrites[0].pImageInfo = &convolveImageInfos[0];
+        guidedWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        guidedWrites[1].pImageInfo = &convolveImageInfos[1];
+        guidedWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        guidedWrites[2].pBufferInfo = &guidedBufferInfo;
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(guidedWrites.size()), guidedWrites.data(), 0, nullptr);
     }
 
     void createCommandBuffers() {
@@ -1083,6 +1750,26 @@ private:
         }
     }
 
+    void createTimestampQueryPool() {
+        // 프레임마다 QUERIES_PER_FRAME개 (histogram build, filter pass, mip 생성의 시작/끝)
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = MAX_FRAMES_IN_FLIGHT * QUERIES_PER_FRAME;
+
+        if (vkCreateQueryPool(device, &queryPoolInfo, nullptr, &timestampQueryPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create timestamp query pool!");
+        }
+
+        computeFrameHistogramBuilt.assign(MAX_FRAMES_IN_FLIGHT, false);
+        computeFrameFiltered.assign(MAX_FRAMES_IN_FLIGHT, false);
+        computeFrameHistogramMode.assign(MAX_FRAMES_IN_FLIGHT, 0);
+        computeFrameEdgeFilter.assign(MAX_FRAMES_IN_FLIGHT, -1);
+        computeFrameConvolutionPath.assign(MAX_FRAMES_IN_FLIGHT, -1);
+        computeFrameConvolutionTaps.assign(MAX_FRAMES_IN_FLIGHT, 0);
+        computeFrameMipsGenerated.assign(MAX_FRAMES_IN_FLIGHT, false);
+    }
+
     void initImGui() {
         VkDescriptorPoolSize pool_sizes[] = {{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 }};
         VkDescriptorPoolCreateInfo pool_info{};
@@ -1126,12 +1813,24 @@ private:
         // Compute pass
         vkWaitForFences(device, 1, &computeInFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
 
+        // 이 프레임 슬롯의 이전 compute 결과 (histogram, timestamp) 읽기
+        readComputeResults();
+
+        if (kernelDirty) {
+            updateKernel();
+        }
+        updateConvolutionPath();
+
         // Update filter params
         FilterParams params{};
         params.filterType = filterType;
         params.intensity = intensity;
         params.param1 = applyVignette ? 1.0f : 0.0f;
         params.param2 = 0.0f;
+        params.sigmaSpatial = bilateralSigmaSpatial;
+        params.sigmaRange = bilateralSigmaRange;
+        params.radius = bilateralRadius;
+        params.bruteForce = bruteForceReference ? 1 : 0;
         memcpy(filterParamsMapped[currentFrame], &params, sizeof(params));
 
         vkResetFences(device, 1, &computeInFlightFences[currentFrame]);
@@ -1196,19 +1895,762 @@ private:
         currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
     }
 
+    float readTimestampMs(uint32_t firstQuery) {
+        uint64_t timestamps[2];
+        VkResult result = vkGetQueryPoolResults(device, timestampQueryPool, firstQuery, 2,
+            sizeof(timestamps), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+        if (result != VK_SUCCESS) {
+            return -1.0f;
+        }
+        return static_cast<float>(timestamps[1] - timestamps[0]) * timestampPeriod / 1000000.0f;
+    }
+
+    void readComputeResults() {
+        if (computeFrameFiltered[currentFrame] && timestampsSupported) {
+            float ms = readTimestampMs(currentFrame * QUERIES_PER_FRAME + 2);
+            if (ms >= 0.0f) {
+                filterPassMs = ms;
+
+                // Bilateral / guided: fast 경로와 brute-force 기준을 따로 평균
+                int edgeFilter = computeFrameEdgeFilter[currentFrame];
+                if (edgeFilter >= 0) {
+                    float& average = edgeFilterMs[edgeFilter];
+                    average = average == 0.0f ? ms : average * 0.95f + ms * 0.05f;
+                }
+
+                // Custom kernel: direct의 tap당 시간과 FFT 시간의 비율이 Auto 선택 기준 (FFT cost)
+                int convolutionPath = computeFrameConvolutionPath[currentFrame];
+                if (convolutionPath == CONVOLUTION_DIRECT) {
+                    float perTap = ms / static_cast<float>(computeFrameConvolutionTaps[currentFrame]);
+                    directMsPerTap = directMsPerTap == 0.0f ? perTap : directMsPerTap * 0.95f + perTap * 0.05f;
+                } else if (convolutionPath == CONVOLUTION_FFT) {
+                    fftConvolutionMs = fftConvolutionMs == 0.0f ? ms : fftConvolutionMs * 0.95f + ms * 0.05f;
+                }
+                if (directMsPerTap > 0.0f && fftConvolutionMs > 0.0f) {
+                    fftCostEstimate = fftConvolutionMs / directMsPerTap;
+                }
+            }
+        }
+        computeFrameFiltered[currentFrame] = false;
+        computeFrameEdgeFilter[currentFrame] = -1;
+        computeFrameConvolutionPath[currentFrame] = -1;
+
+        if (computeFrameMipsGenerated[currentFrame] && timestampsSupported) {
+            float ms = readTimestampMs(currentFrame * QUERIES_PER_FRAME + 4);
+            if (ms >= 0.0f) {
+                mipGenerationMs = ms;
+            }
+        }
+        computeFrameMipsGenerated[currentFrame] = false;
+
+        if (computeFrameHistogramBuilt[currentFrame]) {
+            readHistogramResults();
+        }
+        computeFrameHistogramBuilt[currentFrame] = false;
+    }
+
+    void readHistogramResults() {
+        if (timestampsSupported) {
+            float ms = readTimestampMs(currentFrame * QUERIES_PER_FRAME);
+            if (ms >= 0.0f) {
+                float& average = histogramBuildMs[computeFrameHistogramMode[currentFrame]];
+                average = average == 0.0f ? ms : average * 0.95f + ms * 0.05f;
+            }
+        }
+
+        const HistogramData* data = static_cast<const HistogramData*>(histogramReadbackMapped[currentFrame]);
+        for (uint32_t c = 0; c < HISTOGRAM_CHANNELS; c++) {
+            histogramPlotMax[c] = 0.0f;
+            for (uint32_t b = 0; b < HISTOGRAM_BINS; b++) {
+                float value = static_cast<float>(data->bins[c * HISTOGRAM_BINS + b]);
+                histogramPlot[c][b] = value;
+                histogramPlotMax[c] = std::max(histogramPlotMax[c], value);
+            }
+        }
+    }
+
+    void recordHistogramCommands(VkCommandBuffer commandBuffer) {
+        // 이전 프레임의 filter pass가 histogram을 다 읽은 뒤에 clear
+        VkBufferMemoryBarrier bufferBarrier{};
+        bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        bufferBarrier.buffer = histogramBuffer;
+        bufferBarrier.offset = 0;
+        bufferBarrier.size = VK_WHOLE_SIZE;
+        bufferBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+        bufferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+
+        vkCmdFillBuffer(commandBuffer, histogramBuffer, 0, sizeof(HistogramData::bins), 0);
+
+        bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        bufferBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+
+        HistogramPushConstants pc{};
+        pc.mode = histogramMode;
+        pc.clipFraction = clipFraction;
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, histogramPipelineLayout,
+            0, 1, &histogramDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, histogramPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(HistogramPushConstants), &pc);
+
+        // 1. Histogram build (timestamp로 측정)
+        if (timestampsSupported) {
+            vkCmdResetQueryPool(commandBuffer, timestampQueryPool, currentFrame * QUERIES_PER_FRAME, 2);
+            vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, timestampQueryPool, currentFrame * QUERIES_PER_FRAME);
+        }
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, histogramPipeline);
+        vkCmdDispatch(commandBuffer, (IMAGE_WIDTH + 15) / 16, (IMAGE_HEIGHT + 15) / 16, 1);
+
+        if (timestampsSupported) {
+            vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, timestampQueryPool, currentFrame * QUERIES_PER_FRAME + 1);
+        }
+
+        bufferBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        bufferBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+
+        // 2. Prefix sum (채널당 workgroup 1개)
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, histogramScanPipeline);
+        vkCmdDispatch(commandBuffer, HISTOGRAM_CHANNELS, 1, 1);
+
+        bufferBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        bufferBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+
+        // 3. ImGui 표시용 readback
+        VkBufferCopy copyRegion{};
+        copyRegion.size = sizeof(HistogramData);
+        vkCmdCopyBuffer(commandBuffer, histogramBuffer, histogramReadbackBuffers[currentFrame], 1, &copyRegion);
+
+        VkBufferMemoryBarrier hostBarrier = bufferBarrier;
+        hostBarrier.buffer = histogramReadbackBuffers[currentFrame];
+        hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+            0, 0, nullptr, 1, &hostBarrier, 0, nullptr);
+
+        computeFrameHistogramBuilt[currentFrame] = true;
+        computeFrameHistogramMode[currentFrame] = histogramMode;
+    }
+
+    // 필터 커널이 참조하는 이웃 픽셀 반경 (3x3 커널 = 1)
+    int filterRadius() const {
+        switch (filterType) {
+            case 1: case 2: case 3: case 4:  // Blur, Sharpen, Edge, Emboss
+                return 1;
+            case FILTER_BILATERAL:
+                return bilateralRadius;
+            default:
+                return 0;
+        }
+    }
+
+    // Histogram 기반 필터, custom kernel(FFT 포함), guided filter(SAT)는 이미지 전체를 다시 계산
+    bool filterNeedsFullImage() const {
+        return filterType == 8 || filterType == 9 || filterType == FILTER_CUSTOM_KERNEL || filterType == FILTER_GUIDED;
+    }
+
+    void markAllTilesDirty() {
+        std::fill(dirtyTiles.begin(), dirtyTiles.end(), 1);
+    }
+
+    // Source 변경 영역을 커널 반경만큼 확장해 tile 단위로 표시
+    void markTilesDirty(const DirtyRect& rect) {
+        if (rect.empty()) return;
+        if (filterNeedsFullImage()) {
+            markAllTilesDirty();
+            return;
+        }
+
+        int radius = filterRadius();
+        int x0 = std::max(rect.x0 - radius, 0);
+        int y0 = std::max(rect.y0 - radius, 0);
+        int x1 = std::min(rect.x1 + radius, static_cast<int>(IMAGE_WIDTH));
+        int y1 = std::min(rect.y1 + radius, static_cast<int>(IMAGE_HEIGHT));
+
+        for (int ty = y0 / TILE_SIZE; ty <= (y1 - 1) / static_cast<int>(TILE_SIZE); ty++) {
+            for (int tx = x0 / TILE_SIZE; tx <= (x1 - 1) / static_cast<int>(TILE_SIZE); tx++) {
+                dirtyTiles[ty * TILE_COUNT_X + tx] = 1;
+            }
+        }
+    }
+
+    // sourcePixels의 rect 영역이 바뀌었음을 알림 (다음 compute pass에서 부분 업로드 + 재필터링)
+    void markSourceDirty(const DirtyRect& rect) {
+        pendingSourceUpload.merge(rect);
+        markTilesDirty(rect);
+        histogramDirty = true;
+    }
+
+    void paintBrush(float imageX, float imageY) {
+        DirtyRect rect;
+        rect.x0 = std::max(static_cast<int>(imageX - brushRadius), 0);
+        rect.y0 = std::max(static_cast<int>(imageY - brushRadius), 0);
+        rect.x1 = std::min(static_cast<int>(imageX + brushRadius) + 1, static_cast<int>(IMAGE_WIDTH));
+        rect.y1 = std::min(static_cast<int>(imageY + brushRadius) + 1, static_cast<int>(IMAGE_HEIGHT));
+        if (rect.empty()) return;
+
+        for (int y = rect.y0; y < rect.y1; y++) {
+            for (int x = rect.x0; x < rect.x1; x++) {
+                float dx = x + 0.5f - imageX;
+                float dy = y + 0.5f - imageY;
+                if (dx * dx + dy * dy > brushRadius * brushRadius) continue;
+
+                size_t idx = (y * IMAGE_WIDTH + x) * 4;
+                sourcePixels[idx + 0] = static_cast<uint8_t>(brushColor[0] * 255);
+                sourcePixels[idx + 1] = static_cast<uint8_t>(brushColor[1] * 255);
+                sourcePixels[idx + 2] = static_cast<uint8_t>(brushColor[2] * 255);
+            }
+        }
+
+        markSourceDirty(rect);
+    }
+
+    // 편집된 source 영역만 staging buffer를 거쳐 GPU로 복사
+    bool recordSourceUpload(VkCommandBuffer commandBuffer) {
+        if (pendingSourceUpload.empty()) {
+            return false;
+        }
+
+        const DirtyRect& rect = pendingSourceUpload;
+        uint32_t width = rect.x1 - rect.x0;
+        uint32_t height = rect.y1 - rect.y0;
+
+        uint8_t* staging = static_cast<uint8_t*>(uploadStagingMapped[currentFrame]);
+        for (uint32_t row = 0; row < height; row++) {
+            size_t srcOffset = ((rect.y0 + row) * IMAGE_WIDTH + rect.x0) * 4;
+            memcpy(staging + row * width * 4, sourcePixels.data() + srcOffset, width * 4);
+        }
+
+        // 이전 compute pass의 source 읽기가 끝난 뒤 복사
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = sourceImage;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = {rect.x0, rect.y0, 0};
+        region.imageExtent = {width, height, 1};
+
+        vkCmdCopyBufferToImage(commandBuffer, uploadStagingBuffers[currentFrame], sourceImage,
+            VK_IMAGE_LAYOUT_GENERAL, 1, &region);
+
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        pendingSourceUpload = DirtyRect{};
+        return true;
+    }
+
+    // Dirty tile을 행 단위 연속 구간(run)으로 묶어 vkCmdDispatchBase로 dispatch
+    void recordDirtyTileDispatches(VkCommandBuffer commandBuffer) {
+        lastDispatchedTiles = 0;
+        lastDispatchCount = 0;
+
+        for (uint32_t ty = 0; ty < TILE_COUNT_Y; ty++) {
+            uint32_t tx = 0;
+            while (tx < TILE_COUNT_X) {
+                if (!dirtyTiles[ty * TILE_COUNT_X + tx]) {
+                    tx++;
+                    continue;
+                }
+
+                uint32_t runStart = tx;
+                while (tx < TILE_COUNT_X && dirtyTiles[ty * TILE_COUNT_X + tx]) {
+                    dirtyTiles[ty * TILE_COUNT_X + tx] = 0;
+                    tx++;
+                }
+
+                // 같은 run이 아래 행에도 있으면 세로로 합쳐서 dispatch 횟수 줄이기
+                uint32_t runLength = tx - runStart;
+                uint32_t rowCount = 1;
+                while (ty + rowCount < TILE_COUNT_Y) {
+                    uint8_t* row = &dirtyTiles[(ty + rowCount) * TILE_COUNT_X];
+                    bool sameRun = std::all_of(row + runStart, row + tx, [](uint8_t d) { return d != 0; }) &&
+                                   (runStart == 0 || !row[runStart - 1]) &&
+                                   (tx == TILE_COUNT_X || !row[tx]);
+                    if (!sameRun) break;
+                    std::fill(row + runStart, row + tx, 0);
+                    rowCount++;
+                }
+
+                vkCmdDispatchBase(commandBuffer, runStart, ty, 0, runLength, rowCount, 1);
+                lastDispatchedTiles += runLength * rowCount;
+                lastDispatchCount++;
+            }
+        }
+    }
+
+    // 커널 이미지 생성 (CPU). 합이 1이 되도록 정규화
+    bool generateKernel(std::vector<float>& weights, int& radius) {
+        if (kernelShape == 5) {
+            return loadKernelPGM(kernelFilePath, weights, radius);
+        }
+
+        kernelStatus.clear();
+        radius = kernelRadius;
+        int size = 2 * radius + 1;
+        weights.assign(size * size, 0.0f);
+
+        float r = static_cast<float>(radius);
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                float dx = (x - radius) / std::max(r, 1.0f);
+                float dy = (y - radius) / std::max(r, 1.0f);
+                float dist = std::sqrt(dx * dx + dy * dy);
+                float edge = 0.5f / std::max(r, 1.0f);   // 1픽셀 안티에일리어싱
+                float w = 0.0f;
+
+                switch (kernelShape) {
+                    case 0:  // Box
+                        w = 1.0f;
+                        break;
+                    case 1:  // Gaussian (sigma = radius / 3)
+                        w = std::exp(-4.5f * (dx * dx + dy * dy));
+                        break;
+                    case 2:  // Disc (bokeh)
+                        w = std::clamp((1.0f + edge - dist) / (2.0f * edge), 0.0f, 1.0f);
+                        break;
+                    case 3: {  // Hexagon (flat-top)
+                        float qx = std::abs(dx), qy = std::abs(dy);
+                        float hex = std::max(qy, 0.866f * qx + 0.5f * qy);
+                        w = std::clamp((0.866f + edge - hex) / (2.0f * edge), 0.0f, 1.0f);
+                        break;
+                    }
+                    case 4:  // Ring (가장자리가 밝은 bokeh)
+                        w = std::clamp((1.0f + edge - dist) / (2.0f * edge), 0.0f, 1.0f) *
+                            (0.3f + 0.7f * std::clamp((dist - 0.6f) / 0.4f, 0.0f, 1.0f));
+                        break;
+                }
+                weights[y * size + x] = w;
+            }
+        }
+        return true;
+    }
+
+    // 8-bit PGM (P2/P5) 커널 이미지 로드. 홀수 정사각형으로 중앙 정렬
+    bool loadKernelPGM(const std::string& path, std::vector<float>& weights, int& radius) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            kernelStatus = "failed to open " + path;
+            return false;
+        }
+
+        auto readToken = [&file]() {
+            std::string token;
+            while (file >> token) {
+                if (token[0] != '#') return token;
+                std::string comment;
+                std::getline(file, comment);
+            }
+            return std::string();
+        };
+
+        std::string magic = readToken();
+        int width = std::atoi(readToken().c_str());
+        int height = std::atoi(readToken().c_str());
+        int maxValue = std::atoi(readToken().c_str());
+        if ((magic != "P2" && magic != "P5") || width <= 0 || height <= 0 || maxValue <= 0 || maxValue > 255) {
+            kernelStatus = "unsupported PGM (8-bit P2/P5 only)";
+            return false;
+        }
+        if (width > MAX_KERNEL_SIZE || height > MAX_KERNEL_SIZE) {
+            kernelStatus = "kernel larger than " + std::to_string(MAX_KERNEL_SIZE) + "px";
+            return false;
+        }
+
+        std::vector<uint8_t> pixels(width * height);
+        if (magic == "P5") {
+            file.get();  // header 뒤 공백 1바이트
+            file.read(reinterpret_cast<char*>(pixels.data()), pixels.size());
+        } else {
+            for (auto& p : pixels) p = static_cast<uint8_t>(std::atoi(readToken().c_str()));
+        }
+        if (!file) {
+            kernelStatus = "truncated PGM";
+            return false;
+        }
+
+        radius = std::max(width, height) / 2;
+        int size = 2 * radius + 1;
+        int offsetX = (size - width) / 2;
+        int offsetY = (size - height) / 2;
+        weights.assign(size * size, 0.0f);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                weights[(y + offsetY) * size + x + offsetX] = pixels[y * width + x] / static_cast<float>(maxValue);
+            }
+        }
+
+        kernelStatus = "loaded " + std::to_string(width) + "x" + std::to_string(height);
+        return true;
+    }
+
+    // Rank-1 검사: K(y, x) = col(y) * row(x) 이면 separable
+    bool analyzeSeparability(const std::vector<float>& weights, int size,
+                             std::vector<float>& row, std::vector<float>& col) {
+        int pivot = static_cast<int>(std::max_element(weights.begin(), weights.end(),
+            [](float a, float b) { return std::abs(a) < std::abs(b); }) - weights.begin());
+        int px = pivot % size, py = pivot / size;
+        float pivotValue = weights[pivot];
+        if (pivotValue == 0.0f) return false;
+
+        row.assign(weights.begin() + py * size, weights.begin() + (py + 1) * size);
+        col.resize(size);
+        for (int y = 0; y < size; y++) {
+            col[y] = weights[y * size + px] / pivotValue;
+        }
+
+        float tolerance = 1e-4f * std::abs(pivotValue);
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                if (std::abs(weights[y * size + x] - col[y] * row[x]) > tolerance) return false;
+            }
+        }
+        return true;
+    }
+
+    void updateKernel() {
+        kernelDirty = false;
+
+        std::vector<float> weights;
+        int radius = 0;
+        if (!generateKernel(weights, radius)) {
+            return;  // 실패 시 이전 커널 유지 (kernelStatus에 이유 표시)
+        }
+
+        float sum = 0.0f;
+        for (float w : weights) sum += w;
+        if (sum <= 0.0f) {
+            kernelStatus = "kernel sum is zero";
+            return;
+        }
+        for (float& w : weights) w /= sum;
+
+        int size = 2 * radius + 1;
+        std::vector<float> row, col;
+        kernelSeparable = analyzeSeparability(weights, size, row, col);
+
+        // 이전 프레임의 compute pass가 weights buffer를 읽고 있을 수 있음 (커널 변경은 드문 UI 이벤트)
+        vkQueueWaitIdle(computeQueue);
+
+        float* dst = static_cast<float*>(kernelWeightsMapped);
+        memcpy(dst, weights.data(), weights.size() * sizeof(float));
+        if (kernelSeparable) {
+            memcpy(dst + size * size, row.data(), size * sizeof(float));
+            memcpy(dst + size * size + size, col.data(), size * sizeof(float));
+        }
+
+        loadedKernelRadius = radius;
+        kernelSpectrumDirty = true;
+        needsRecompute = true;
+    }
+
+    // 커널 크기에 따른 비용(출력 픽셀당 tap 수 환산)으로 경로 선택
+    //   direct    : K²
+    //   separable : 2K (rank-1 커널만)
+    //   FFT       : 커널 크기와 무관한 상수 (fftCostEstimate, direct / FFT timestamp 측정값에서 유도)
+    void updateConvolutionPath() {
+        ConvolutionPath path = static_cast<ConvolutionPath>(convolutionPathSetting);
+        if (path == CONVOLUTION_AUTO) {
+            int size = 2 * loadedKernelRadius + 1;
+            float directCost = static_cast<float>(size * size);
+            float separableCost = kernelSeparable ? 2.0f * size : std::numeric_limits<float>::max();
+
+            path = CONVOLUTION_DIRECT;
+            float best = directCost;
+            if (separableCost < best) { path = CONVOLUTION_SEPARABLE; best = separableCost; }
+            if (fftCostEstimate < best) { path = CONVOLUTION_FFT; }
+        } else if (path == CONVOLUTION_SEPARABLE && !kernelSeparable) {
+            path = CONVOLUTION_DIRECT;
+        }
+
+        if (path != activeConvolutionPath) {
+            activeConvolutionPath = path;
+            needsRecompute = true;
+        }
+    }
+
+    void recordComputeToComputeBarrier(VkCommandBuffer commandBuffer) {
+        VkMemoryBarrier memoryBarrier{};
+        memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    // spectrum의 모든 줄에 1D FFT (channelCount개 channel)
+    void recordFFTPass(VkCommandBuffer commandBuffer, ConvolvePushConstants pc, int axis, int inverse,
+                       int channelOffset, uint32_t channelCount) {
+        pc.axis = axis;
+        pc.inverse = inverse;
+        pc.channelOffset = channelOffset;
+        vkCmdPushConstants(commandBuffer, convolvePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(ConvolvePushConstants), &pc);
+        vkCmdDispatch(commandBuffer, FFT_SIZE, 1, channelCount);
+        recordComputeToComputeBarrier(commandBuffer);
+    }
+
+    void recordFFTConvolveStep(VkCommandBuffer commandBuffer, ConvolvePushConstants pc, int mode) {
+        pc.mode = mode;
+        vkCmdPushConstants(commandBuffer, convolvePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(ConvolvePushConstants), &pc);
+        vkCmdDispatch(commandBuffer, FFT_SIZE / 16, FFT_SIZE / 16, 1);
+        recordComputeToComputeBarrier(commandBuffer);
+    }
+
+    void recordConvolutionCommands(VkCommandBuffer commandBuffer) {
+        ConvolvePushConstants pc{};
+        pc.radius = loadedKernelRadius;
+        pc.intensity = intensity;
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, convolvePipelineLayout,
+            0, 1, &convolveDescriptorSet, 0, nullptr);
+
+        uint32_t groupCountX = (IMAGE_WIDTH + 15) / 16;
+        uint32_t groupCountY = (IMAGE_HEIGHT + 15) / 16;
+
+        switch (activeConvolutionPath) {
+            case CONVOLUTION_DIRECT:
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, convolvePipeline);
+                pc.mode = 0;
+                vkCmdPushConstants(commandBuffer, convolvePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                    0, sizeof(ConvolvePushConstants), &pc);
+                vkCmdDispatch(commandBuffer, groupCountX, groupCountY, 1);
+                break;
+
+            case CONVOLUTION_SEPARABLE:
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, convolvePipeline);
+                pc.mode = 1;
+                vkCmdPushConstants(commandBuffer, convolvePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                    0, sizeof(ConvolvePushConstants), &pc);
+                vkCmdDispatch(commandBuffer, groupCountX, groupCountY, 1);
+                recordComputeToComputeBarrier(commandBuffer);
+
+                pc.mode = 2;
+                vkCmdPushConstants(commandBuffer, convolvePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                    0, sizeof(ConvolvePushConstants), &pc);
+                vkCmdDispatch(commandBuffer, groupCountX, groupCountY, 1);
+                break;
+
+            case CONVOLUTION_FFT:
+            default:
+                // 커널 spectrum은 커널이 바뀔 때만 다시 계산
+                if (kernelSpectrumDirty) {
+                    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, fftConvolvePipeline);
+                    recordFFTConvolveStep(commandBuffer, pc, 1);
+
+                    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, fftPipeline);
+                    recordFFTPass(commandBuffer, pc, 0, 0, 3, 1);
+                    recordFFTPass(commandBuffer, pc, 1, 0, 3, 1);
+                    kernelSpectrumDirty = false;
+                }
+
+                // 이미지 forward FFT → spectrum 곱 → inverse FFT
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, fftConvolvePipeline);
+                recordFFTConvolveStep(commandBuffer, pc, 0);
+
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, fftPipeline);
+                recordFFTPass(commandBuffer, pc, 0, 0, 0, 3);
+                recordFFTPass(commandBuffer, pc, 1, 0, 0, 3);
+
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, fftConvolvePipeline);
+                recordFFTConvolveStep(commandBuffer, pc, 2);
+
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, fftPipeline);
+                recordFFTPass(commandBuffer, pc, 1, 1, 0, 3);
+                recordFFTPass(commandBuffer, pc, 0, 1, 0, 3);
+
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, fftConvolvePipeline);
+                pc.mode = 3;
+                vkCmdPushConstants(commandBuffer, convolvePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                    0, sizeof(ConvolvePushConstants), &pc);
+                vkCmdDispatch(commandBuffer, groupCountX, groupCountY, 1);
+                break;
+        }
+    }
+
+    void recordIntegralPass(VkCommandBuffer commandBuffer, GuidedPushConstants pc, int channelOffset, uint32_t channelCount) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, integralPipeline);
+        pc.channelOffset = channelOffset;
+
+        // Rows → columns
+        pc.axis = 0;
+        vkCmdPushConstants(commandBuffer, guidedPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(GuidedPushConstants), &pc);
+        vkCmdDispatch(commandBuffer, IMAGE_HEIGHT, 1, channelCount);
+        recordComputeToComputeBarrier(commandBuffer);
+
+        pc.axis = 1;
+        vkCmdPushConstants(commandBuffer, guidedPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(GuidedPushConstants), &pc);
+        vkCmdDispatch(commandBuffer, IMAGE_WIDTH, 1, channelCount);
+        recordComputeToComputeBarrier(commandBuffer);
+    }
+
+    void recordGuidedStep(VkCommandBuffer commandBuffer, GuidedPushConstants pc, int mode) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, guidedPipeline);
+        pc.mode = mode;
+        vkCmdPushConstants(commandBuffer, guidedPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(GuidedPushConstants), &pc);
+        vkCmdDispatch(commandBuffer, (IMAGE_WIDTH + 15) / 16, (IMAGE_HEIGHT + 15) / 16, 1);
+    }
+
+    // 통계 → (SAT) → 계수 a, b → (SAT) → 출력
+    // brute-force 기준은 SAT 없이 window를 직접 순회
+    void recordGuidedFilterCommands(VkCommandBuffer commandBuffer) {
+        GuidedPushConstants pc{};
+        pc.radius = guidedRadius;
+        pc.epsilon = guidedEpsilon;
+        pc.bruteForce = bruteForceReference ? 1 : 0;
+        pc.intensity = intensity;
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, guidedPipelineLayout,
+            0, 1, &guidedDescriptorSet, 0, nullptr);
+
+        recordGuidedStep(commandBuffer, pc, 0);
+        recordComputeToComputeBarrier(commandBuffer);
+        if (!bruteForceReference) {
+            recordIntegralPass(commandBuffer, pc, 0, 8);
+        }
+
+        recordGuidedStep(commandBuffer, pc, 1);
+        recordComputeToComputeBarrier(commandBuffer);
+        if (!bruteForceReference) {
+            recordIntegralPass(commandBuffer, pc, 8, 6);
+        }
+
+        recordGuidedStep(commandBuffer, pc, 2);
+    }
+
+    void recordMipGeneration(VkCommandBuffer commandBuffer) {
+        // 필터 pass의 mip 0 쓰기 → mip generator 읽기
+        recordComputeToComputeBarrier(commandBuffer);
+
+        if (timestampsSupported) {
+            vkCmdResetQueryPool(commandBuffer, timestampQueryPool, currentFrame * QUERIES_PER_FRAME + 4, 2);
+            vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, timestampQueryPool, currentFrame * QUERIES_PER_FRAME + 4);
+        }
+
+        mipGenerator.generate(commandBuffer, filteredMipTarget, static_cast<vk::MipFilter>(mipFilter), mipSrgb);
+
+        if (timestampsSupported) {
+            vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, timestampQueryPool, currentFrame * QUERIES_PER_FRAME + 5);
+            computeFrameMipsGenerated[currentFrame] = true;
+        }
+    }
+
     void recordComputeCommandBuffer(VkCommandBuffer commandBuffer) {
         VkCommandBufferBeginInfo beginInfo{};
         beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
         vkBeginCommandBuffer(commandBuffer, &beginInfo);
 
-        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
-        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
-            0, 1, &computeDescriptorSets[currentFrame], 0, nullptr);
+        // 파라미터 변경 시에는 전체 이미지 재계산
+        if (needsRecompute || refilterEveryFrame) {
+            markAllTilesDirty();
+            needsRecompute = false;
+        }
 
-        // Dispatch compute work
-        uint32_t groupCountX = (IMAGE_WIDTH + 15) / 16;
-        uint32_t groupCountY = (IMAGE_HEIGHT + 15) / 16;
-        vkCmdDispatch(commandBuffer, groupCountX, groupCountY, 1);
+        // 편집된 source 영역만 업로드
+        recordSourceUpload(commandBuffer);
+
+        // Histogram + CDF (auto levels / equalize 필터의 입력) - source가 바뀐 경우에만
+        if (histogramDirty || rebuildHistogramEveryFrame) {
+            recordHistogramCommands(commandBuffer);
+            histogramDirty = false;
+        }
+
+        if (timestampsSupported) {
+            vkCmdResetQueryPool(commandBuffer, timestampQueryPool, currentFrame * QUERIES_PER_FRAME + 2, 2);
+            vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, timestampQueryPool, currentFrame * QUERIES_PER_FRAME + 2);
+        }
+
+        bool anyDirty = std::any_of(dirtyTiles.begin(), dirtyTiles.end(), [](uint8_t d) { return d != 0; });
+        // 벤치마크 평균은 이미지 전체를 다시 계산한 프레임만 사용
+        bool allDirty = std::all_of(dirtyTiles.begin(), dirtyTiles.end(), [](uint8_t d) { return d != 0; });
+        if (allDirty && (filterType == FILTER_BILATERAL || filterType == FILTER_GUIDED)) {
+            computeFrameEdgeFilter[currentFrame] = (filterType == FILTER_GUIDED ? 2 : 0) + (bruteForceReference ? 1 : 0);
+        }
+        // FFT cost 측정: 작은 커널의 direct는 고정 비용이 tap당 시간을 부풀리고,
+        // 커널 spectrum을 다시 만드는 프레임은 FFT 시간이 평소보다 길어서 제외
+        if (allDirty && filterType == FILTER_CUSTOM_KERNEL) {
+            int taps = (2 * loadedKernelRadius + 1) * (2 * loadedKernelRadius + 1);
+            if (activeConvolutionPath == CONVOLUTION_DIRECT && loadedKernelRadius >= 4) {
+                computeFrameConvolutionPath[currentFrame] = CONVOLUTION_DIRECT;
+                computeFrameConvolutionTaps[currentFrame] = taps;
+            } else if (activeConvolutionPath == CONVOLUTION_FFT && !kernelSpectrumDirty) {
+                computeFrameConvolutionPath[currentFrame] = CONVOLUTION_FFT;
+            }
+        }
+
+        if (filterType == FILTER_CUSTOM_KERNEL || filterType == FILTER_GUIDED) {
+            // 다중 pass 필터: custom kernel (direct / separable / FFT), guided filter (이미지 전체)
+            if (anyDirty) {
+                if (filterType == FILTER_CUSTOM_KERNEL) {
+                    recordConvolutionCommands(commandBuffer);
+                } else {
+                    recordGuidedFilterCommands(commandBuffer);
+                }
+                std::fill(dirtyTiles.begin(), dirtyTiles.end(), 0);
+                lastDispatchedTiles = TILE_COUNT_X * TILE_COUNT_Y;
+            } else {
+                lastDispatchedTiles = 0;
+            }
+            lastDispatchCount = anyDirty ? 1 : 0;
+        } else {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
+                0, 1, &computeDescriptorSets[currentFrame], 0, nullptr);
+
+            // Dirty tile만 dispatch (변경 없는 영역은 이전 결과 유지)
+            recordDirtyTileDispatches(commandBuffer);
+        }
+
+        if (timestampsSupported) {
+            vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, timestampQueryPool, currentFrame * QUERIES_PER_FRAME + 3);
+            computeFrameFiltered[currentFrame] = true;
+        }
+
+        // Mip 0이 바뀐 프레임에만 전체 mip chain 재생성 (dispatch 1번)
+        if (generateMipmaps && (anyDirty || mipsDirty)) {
+            recordMipGeneration(commandBuffer);
+            mipsDirty = false;
+        }
 
         // Transition filtered image for sampling
         VkImageMemoryBarrier barrier{};
@@ -1220,7 +2662,7 @@ private:
         barrier.image = filteredImage;
         barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         barrier.subresourceRange.baseMipLevel = 0;
-        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
         barrier.subresourceRange.baseArrayLayer = 0;
         barrier.subresourceRange.layerCount = 1;
         barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
@@ -1247,7 +2689,7 @@ private:
         preBarrier.image = filteredImage;
         preBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         preBarrier.subresourceRange.baseMipLevel = 0;
-        preBarrier.subresourceRange.levelCount = 1;
+        preBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
         preBarrier.subresourceRange.baseArrayLayer = 0;
         preBarrier.subresourceRange.layerCount = 1;
         preBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
@@ -1288,6 +2730,9 @@ private:
         vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipelineLayout,
             0, 1, &graphicsDescriptorSets[currentFrame], 0, nullptr);
 
+        vkCmdPushConstants(commandBuffer, graphicsPipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT,
+            0, sizeof(float), &displayLod);
+
         vkCmdDraw(commandBuffer, 3, 1, 0, 0);  // Fullscreen triangle
 
         // Render ImGui
@@ -1301,19 +2746,136 @@ private:
         ImGui::Separator();
 
         ImGui::Text("Filter Type");
-        for (int i = 0; i < 8; i++) {
+        for (int i = 0; i < IM_ARRAYSIZE(filterNames); i++) {
             if (ImGui::RadioButton(filterNames[i], filterType == i)) {
                 filterType = i;
+                needsRecompute = true;
             }
-            if (i % 4 != 3) ImGui::SameLine();
+            if (i % 4 != 3 && i != IM_ARRAYSIZE(filterNames) - 1) ImGui::SameLine();
         }
         ImGui::Separator();
 
-        ImGui::SliderFloat("Intensity", &intensity, 0.0f, 2.0f);
-        ImGui::Checkbox("Vignette", &applyVignette);
+        needsRecompute |= ImGui::SliderFloat("Intensity", &intensity, 0.0f, 2.0f);
+        needsRecompute |= ImGui::Checkbox("Vignette", &applyVignette);
+        if (filterType == 8) {
+            if (ImGui::SliderFloat("Clip", &clipFraction, 0.0f, 0.05f, "%.3f")) {
+                histogramDirty = true;
+                needsRecompute = true;
+            }
+        }
+
+        if (filterType == FILTER_CUSTOM_KERNEL) {
+            ImGui::Separator();
+            kernelDirty |= ImGui::Combo("Kernel", &kernelShape, kernelShapeNames, IM_ARRAYSIZE(kernelShapeNames));
+            if (kernelShape == 5) {
+                ImGui::InputText("PGM Path", kernelFilePath, sizeof(kernelFilePath));
+                kernelDirty |= ImGui::Button("Load");
+            } else {
+                kernelDirty |= ImGui::SliderInt("Kernel Radius", &kernelRadius, 1, MAX_KERNEL_RADIUS);
+            }
+            if (!kernelStatus.empty()) {
+                ImGui::Text("%s", kernelStatus.c_str());
+            }
+
+            ImGui::Combo("Path", &convolutionPathSetting, convolutionPathNames, IM_ARRAYSIZE(convolutionPathNames));
+            if (timestampsSupported) {
+                ImGui::Text("Measured: direct %.5f ms/tap, FFT %.3f ms", directMsPerTap, fftConvolutionMs);
+                if (directMsPerTap == 0.0f || fftConvolutionMs == 0.0f) {
+                    ImGui::TextDisabled("FFT cost: default (run Direct r>=4 and FFT once to measure)");
+                }
+            }
+            int size = 2 * loadedKernelRadius + 1;
+            ImGui::Text("Active: %s (%dx%d, %s)", convolutionPathNames[activeConvolutionPath], size, size,
+                kernelSeparable ? "separable" : "non-separable");
+            ImGui::Text("Cost: direct %d, separable %s, FFT %.0f", size * size,
+                kernelSeparable ? std::to_string(2 * size).c_str() : "-", fftCostEstimate);
+        }
+
+        if (filterType == FILTER_BILATERAL || filterType == FILTER_GUIDED) {
+            ImGui::Separator();
+            bool settingsChanged = false;
+            if (filterType == FILTER_BILATERAL) {
+                settingsChanged |= ImGui::SliderInt("Radius", &bilateralRadius, 1, MAX_BILATERAL_RADIUS);
+                settingsChanged |= ImGui::SliderFloat("Sigma Spatial", &bilateralSigmaSpatial, 0.5f, 8.0f);
+                settingsChanged |= ImGui::SliderFloat("Sigma Range", &bilateralSigmaRange, 0.01f, 0.5f);
+            } else {
+                settingsChanged |= ImGui::SliderInt("Radius", &guidedRadius, 1, MAX_GUIDED_RADIUS);
+                settingsChanged |= ImGui::SliderFloat("Epsilon", &guidedEpsilon, 0.0001f, 0.1f, "%.4f",
+                    ImGuiSliderFlags_Logarithmic);
+            }
+            if (settingsChanged) {
+                // 반경이 바뀌면 이전 측정값은 비교 의미가 없음
+                std::fill(std::begin(edgeFilterMs), std::end(edgeFilterMs), 0.0f);
+                needsRecompute = true;
+            }
+            needsRecompute |= ImGui::Checkbox("Brute Force Reference", &bruteForceReference);
+
+            if (timestampsSupported) {
+                int index = filterType == FILTER_GUIDED ? 2 : 0;
+                const char* fastName = filterType == FILTER_GUIDED ? "SAT" : "Tile cache";
+                float fastMs = edgeFilterMs[index];
+                float referenceMs = edgeFilterMs[index + 1];
+                ImGui::Text("%s: %.3f ms / Brute force: %.3f ms", fastName, fastMs, referenceMs);
+                if (fastMs > 0.0f && referenceMs > 0.0f) {
+                    ImGui::Text("Speedup: %.1fx", referenceMs / fastMs);
+                }
+            }
+        }
+
+        // Mipmaps
+        ImGui::Separator();
+        mipsDirty |= ImGui::Checkbox("Generate Mipmaps", &generateMipmaps);
+        if (generateMipmaps) {
+            mipsDirty |= ImGui::Combo("Mip Filter", &mipFilter, mipFilterNames, IM_ARRAYSIZE(mipFilterNames));
+            mipsDirty |= ImGui::Checkbox("sRGB Averaging", &mipSrgb);
+            if (timestampsSupported) {
+                ImGui::Text("Mip chain (%u levels): %.3f ms", filteredMipLevels, mipGenerationMs);
+            }
+        }
+        ImGui::SliderFloat("Display LOD", &displayLod, -1.0f, static_cast<float>(filteredMipLevels - 1), "%.1f");
+
+        // Incremental refiltering
+        ImGui::Separator();
+        ImGui::Checkbox("Brush (LMB)", &brushEnabled);
+        if (brushEnabled) {
+            ImGui::SliderFloat("Brush Radius", &brushRadius, 1.0f, 64.0f);
+            ImGui::ColorEdit3("Brush Color", brushColor);
+        }
+        if (ImGui::Button("Reset Image")) {
+            generateProceduralPixels();
+            markSourceDirty({0, 0, static_cast<int32_t>(IMAGE_WIDTH), static_cast<int32_t>(IMAGE_HEIGHT)});
+        }
+        ImGui::Text("Tiles: %u / %u (%u dispatches)", lastDispatchedTiles, TILE_COUNT_X * TILE_COUNT_Y, lastDispatchCount);
+        if (timestampsSupported) {
+            ImGui::Text("Filter pass: %.3f ms", filterPassMs);
+        }
+        ImGui::Checkbox("Refilter Every Frame (benchmark)", &refilterEveryFrame);
+
+        // Histogram
+        ImGui::Separator();
+        ImGui::Text("Histogram (subgroup size: %u)", subgroupSize);
+        ImGui::Combo("Build Mode", &histogramMode, histogramModeNames, IM_ARRAYSIZE(histogramModeNames));
+        ImGui::Checkbox("Rebuild Every Frame (benchmark)", &rebuildHistogramEveryFrame);
+        if (timestampsSupported) {
+            ImGui::Text("Naive:  %.3f ms", histogramBuildMs[0]);
+            ImGui::Text("Shared: %.3f ms", histogramBuildMs[1]);
+        } else {
+            ImGui::Text("GPU timestamps not supported on compute queue");
+        }
+        ImGui::Combo("Channel", &histogramChannel, histogramChannelNames, IM_ARRAYSIZE(histogramChannelNames));
+        ImGui::PlotHistogram("##histogram", histogramPlot[histogramChannel], HISTOGRAM_BINS, 0, nullptr,
+            0.0f, histogramPlotMax[histogramChannel], ImVec2(0, 100));
 
         ImGui::End();
 
+        // Brush: 화면 좌표 → 이미지 좌표 (fullscreen.frag에서 Y를 뒤집어 샘플링)
+        ImGuiIO& io = ImGui::GetIO();
+        if (brushEnabled && ImGui::IsMouseDown(ImGuiMouseButton_Left) && !io.WantCaptureMouse) {
+            float imageX = io.MousePos.x / io.DisplaySize.x * IMAGE_WIDTH;
+            float imageY = (1.0f - io.MousePos.y / io.DisplaySize.y) * IMAGE_HEIGHT;
+            paintBrush(imageX, imageY);
+        }
+
         ImGui::Render();
         ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
 
@@ -1354,24 +2916,57 @@ private:
         ImGui::DestroyContext();
         vkDestroyDescriptorPool(device, imguiPool, nullptr);
 
+        mipGenerator.destroyTarget(filteredMipTarget);
+        mipGenerator.destroy();
+
         vkDestroySampler(device, imageSampler, nullptr);
         vkDestroyImageView(device, sourceImageView, nullptr);
         vkDestroyImage(device, sourceImage, nullptr);
         vkFreeMemory(device, sourceImageMemory, nullptr);
         vkDestroyImageView(device, filteredImageView, nullptr);
+        vkDestroyImageView(device, filteredSampledView, nullptr);
         vkDestroyImage(device, filteredImage, nullptr);
         vkFreeMemory(device, filteredImageMemory, nullptr);
+        vkDestroyImageView(device, tempImageView, nullptr);
+        vkDestroyImage(device, tempImage, nullptr);
+        vkFreeMemory(device, tempImageMemory, nullptr);
 
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
             vkDestroyBuffer(device, filterParamsBuffers[i], nullptr);
             vkFreeMemory(device, filterParamsMemory[i], nullptr);
+            vkDestroyBuffer(device, uploadStagingBuffers[i], nullptr);
+            vkFreeMemory(device, uploadStagingMemory[i], nullptr);
+            vkDestroyBuffer(device, histogramReadbackBuffers[i], nullptr);
+            vkFreeMemory(device, histogramReadbackMemory[i], nullptr);
         }
+        vkDestroyBuffer(device, histogramBuffer, nullptr);
+        vkFreeMemory(device, histogramBufferMemory, nullptr);
+        vkDestroyBuffer(device, kernelWeightsBuffer, nullptr);
+        vkFreeMemory(device, kernelWeightsMemory, nullptr);
+        vkDestroyBuffer(device, spectrumBuffer, nullptr);
+        vkFreeMemory(device, spectrumBufferMemory, nullptr);
+        vkDestroyBuffer(device, guidedBuffer, nullptr);
+        vkFreeMemory(device, guidedBufferMemory, nullptr);
+        vkDestroyQueryPool(device, timestampQueryPool, nullptr);
 
         vkDestroyDescriptorPool(device, descriptorPool, nullptr);
         vkDestroyPipeline(device, graphicsPipeline, nullptr);
         vkDestroyPipelineLayout(device, graphicsPipelineLayout, nullptr);
         vkDestroyPipeline(device, computePipeline, nullptr);
         vkDestroyPipelineLayout(device, computePipelineLayout, nullptr);
+        vkDestroyPipeline(device, histogramPipeline, nullptr);
+        vkDestroyPipeline(device, histogramScanPipeline, nullptr);
+        vkDestroyPipelineLayout(device, histogramPipelineLayout, nullptr);
+        vkDestroyDescriptorSetLayout(device, histogramDescriptorSetLayout, nullptr);
+        vkDestroyPipeline(device, convolvePipeline, nullptr);
+        vkDestroyPipeline(device, fftPipeline, nullptr);
+        vkDestroyPipeline(device, fftConvolvePipeline, nullptr);
+        vkDestroyPipelineLayout(device, convolvePipelineLayout, nullptr);
+        vkDestroyDescriptorSetLayout(device, convolveDescriptorSetLayout, nullptr);
+        vkDestroyPipeline(device, guidedPipeline, nullptr);
+        vkDestroyPipeline(device, integralPipeline, nullptr);
+        vkDestroyPipelineLayout(device, guidedPipelineLayout, nullptr);
+        vkDestroyDescriptorSetLayout(device, guidedDescriptorSetLayout, nullptr);
         vkDestroyDescriptorSetLayout(device, graphicsDescriptorSetLayout, nullptr);
         vkDestroyDescriptorSetLayout(device, computeDescriptorSetLayout, nullptr);
         vkDestroyRenderPass(device, renderPass, nullptr);
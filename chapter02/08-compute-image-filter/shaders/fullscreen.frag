@@ -8,8 +8,13 @@ layout(location = 0) out vec4 outColor;
 
 layout(binding = 0) uniform sampler2D texSampler;
 
+// 표시할 mip level (음수 = 하드웨어 자동 선택)
+layout(push_constant) uniform PushConstants {
+    float lod;
+} pc;
+
 void main() {
     // Flip Y coordinate (Vulkan's coordinate system)
     vec2 uv = vec2(inUV.x, 1.0 - inUV.y);
-    outColor = texture(texSampler, uv);
+    outColor = pc.lod < 0.0 ? texture(texSampler, uv) : textureLod(texSampler, uv, pc.lod);
 }
@@ -0,0 +1,337 @@
+#include "heightmap_tiles.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace terrain {
+
+// ============================================================================
+// MappedFile
+// ============================================================================
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+
+    // 타일 단위 랜덤 접근이므로 커널 read-ahead 비활성화
+    madvise(view, static_cast<size_t>(st.st_size), MADV_RANDOM);
+
+    fd_ = fd;
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::close() {
+    if (!data_) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(mappingHandle_));
+    CloseHandle(static_cast<HANDLE>(fileHandle_));
+    mappingHandle_ = nullptr;
+    fileHandle_ = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(data_), size_);
+    ::close(fd_);
+    fd_ = -1;
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+// ============================================================================
+// HeightTileFile
+// ============================================================================
+bool HeightTileFile::open(const std::string& path) {
+    close();
+
+    if (!mapped_.open(path)) {
+        error_ = "cannot map " + path;
+        return false;
+    }
+
+    if (mapped_.size() < sizeof(HeightTileFileHeader)) {
+        error_ = "file too small";
+        close();
+        return false;
+    }
+
+    std::memcpy(&header_, mapped_.data(), sizeof(header_));
+
+    if (std::memcmp(header_.magic, HEIGHT_TILE_MAGIC, 4) != 0 || header_.version != HEIGHT_TILE_VERSION) {
+        error_ = "not a height tile file (bad magic/version)";
+        close();
+        return false;
+    }
+    if (header_.tileCells == 0 || header_.tilesX == 0 || header_.tilesY == 0 || header_.overviewSize < 2) {
+        error_ = "invalid tile layout";
+        close();
+        return false;
+    }
+
+    size_t indexEnd = sizeof(HeightTileFileHeader) + sizeof(HeightTileIndexEntry) * tileCount();
+    size_t overviewBytes = size_t(header_.overviewSize) * header_.overviewSize * sizeof(uint16_t);
+    if (indexEnd > mapped_.size() || header_.overviewOffset + overviewBytes > mapped_.size()) {
+        error_ = "truncated header/overview";
+        close();
+        return false;
+    }
+
+    index_ = reinterpret_cast<const HeightTileIndexEntry*>(mapped_.data() + sizeof(HeightTileFileHeader));
+    for (uint32_t i = 0; i < tileCount(); i++) {
+        if (index_[i].byteSize != tileByteSize() || index_[i].offset + index_[i].byteSize > mapped_.size()) {
+            error_ = "invalid tile index entry " + std::to_string(i);
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void HeightTileFile::close() {
+    mapped_.close();
+    index_ = nullptr;
+}
+
+const uint16_t* HeightTileFile::tileData(uint32_t tileIndex) const {
+    return reinterpret_cast<const uint16_t*>(mapped_.data() + index_[tileIndex].offset);
+}
+
+const uint16_t* HeightTileFile::overviewData() const {
+    return reinterpret_cast<const uint16_t*>(mapped_.data() + header_.overviewOffset);
+}
+
+bool writeHeightTileFile(const std::string& path, const std::vector<uint16_t>& samples,
+                         uint32_t width, uint32_t height, uint32_t tileCells,
+                         uint32_t overviewSize, std::string& error) {
+    if (tileCells == 0 || (width - 1) % tileCells != 0 || (height - 1) % tileCells != 0) {
+        error = "raster size must be tiles * " + std::to_string(tileCells) + " + 1";
+        return false;
+    }
+    if (samples.size() != size_t(width) * height) {
+        error = "sample count does not match raster size";
+        return false;
+    }
+    if (overviewSize < 2) {
+        error = "overview size must be at least 2";
+        return false;
+    }
+
+    HeightTileFileHeader header{};
+    std::memcpy(header.magic, HEIGHT_TILE_MAGIC, 4);
+    header.version = HEIGHT_TILE_VERSION;
+    header.tileCells = tileCells;
+    header.tilesX = (width - 1) / tileCells;
+    header.tilesY = (height - 1) / tileCells;
+    header.overviewSize = overviewSize;
+
+    uint32_t tileSamples = tileCells + 1;
+    uint64_t tileBytes = uint64_t(tileSamples) * tileSamples * sizeof(uint16_t);
+    uint64_t overviewBytes = uint64_t(overviewSize) * overviewSize * sizeof(uint16_t);
+    uint32_t tileCount = header.tilesX * header.tilesY;
+
+    header.overviewOffset = sizeof(HeightTileFileHeader) + sizeof(HeightTileIndexEntry) * tileCount;
+    uint64_t dataOffset = header.overviewOffset + overviewBytes;
+
+    std::vector<HeightTileIndexEntry> index(tileCount);
+    for (uint32_t i = 0; i < tileCount; i++) {
+        index[i] = {dataOffset + tileBytes * i, tileBytes};
+    }
+
+    // Overview: 전체 래스터를 nearest로 축소 (정점 중심 그리드끼리 대응)
+    std::vector<uint16_t> overview(size_t(overviewSize) * overviewSize);
+    for (uint32_t y = 0; y < overviewSize; y++) {
+        for (uint32_t x = 0; x < overviewSize; x++) {
+            uint32_t sx = static_cast<uint32_t>((uint64_t(x) * (width - 1) + (overviewSize - 1) / 2) / (overviewSize - 1));
+            uint32_t sy = static_cast<uint32_t>((uint64_t(y) * (height - 1) + (overviewSize - 1) / 2) / (overviewSize - 1));
+            overview[size_t(y) * overviewSize + x] = samples[size_t(sy) * width + sx];
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        error = "cannot open " + path + " for writing";
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(index.data()), sizeof(HeightTileIndexEntry) * index.size());
+    file.write(reinterpret_cast<const char*>(overview.data()), overviewBytes);
+
+    std::vector<uint16_t> tile(size_t(tileSamples) * tileSamples);
+    for (uint32_t ty = 0; ty < header.tilesY; ty++) {
+        for (uint32_t tx = 0; tx < header.tilesX; tx++) {
+            for (uint32_t y = 0; y < tileSamples; y++) {
+                const uint16_t* row = &samples[size_t(ty * tileCells + y) * width + tx * tileCells];
+                std::copy(row, row + tileSamples, &tile[size_t(y) * tileSamples]);
+            }
+            file.write(reinterpret_cast<const char*>(tile.data()), tileBytes);
+        }
+    }
+
+    if (!file.good()) {
+        error = "write failed";
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// TileStreamer
+// ============================================================================
+TileStreamer::~TileStreamer() {
+    stop();
+}
+
+void TileStreamer::start(const HeightTileFile* file) {
+    stop();
+    file_ = file;
+    running_ = true;
+    worker_ = std::thread(&TileStreamer::workerLoop, this);
+}
+
+void TileStreamer::stop() {
+    if (!running_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    condition_.notify_all();
+    worker_.join();
+
+    requests_.clear();
+    inFlight_.clear();
+    loaded_.clear();
+}
+
+void TileStreamer::requestTiles(const std::vector<uint32_t>& tiles) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.clear();
+        for (uint32_t tile : tiles) {
+            if (std::find(inFlight_.begin(), inFlight_.end(), tile) == inFlight_.end()) {
+                requests_.push_back(tile);
+            }
+        }
+    }
+    condition_.notify_one();
+}
+
+bool TileStreamer::popLoaded(LoadedTile& tile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (loaded_.empty()) {
+        return false;
+    }
+
+    tile = std::move(loaded_.front());
+    loaded_.pop_front();
+    inFlight_.erase(std::remove(inFlight_.begin(), inFlight_.end(), tile.tileIndex), inFlight_.end());
+    return true;
+}
+
+size_t TileStreamer::pendingCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_.size();
+}
+
+void TileStreamer::workerLoop() {
+    size_t sampleCount = size_t(file_->tileSamples()) * file_->tileSamples();
+
+    while (true) {
+        uint32_t tileIndex;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return !running_ || !requests_.empty(); });
+            if (!running_) {
+                return;
+            }
+            tileIndex = requests_.front();
+            requests_.pop_front();
+            inFlight_.push_back(tileIndex);
+        }
+
+        // 락 밖에서 매핑된 메모리를 복사 (page fault → 디스크 읽기는 여기서 발생)
+        LoadedTile tile;
+        tile.tileIndex = tileIndex;
+        const uint16_t* src = file_->tileData(tileIndex);
+        tile.samples.assign(src, src + sampleCount);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            loaded_.push_back(std::move(tile));
+        }
+        loadedTotal_++;
+    }
+}
+
+} // namespace terrain
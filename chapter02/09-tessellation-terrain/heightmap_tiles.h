@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * 16-bit 타일 heightmap 파일 + 백그라운드 스트리밍
+ *
+ * 파일 구조 (.htiles, little-endian):
+ *   HeightTileFileHeader
+ *   HeightTileIndexEntry[tilesX * tilesY]   (타일 (x, y)는 y * tilesX + x)
+ *   overview: uint16[overviewSize * overviewSize]  (항상 상주하는 저해상도 전체 지형)
+ *   tile data: uint16[(tileCells + 1)^2] x 타일 수
+ *
+ * 샘플은 정점 중심 그리드: 전체 샘플 수 = tilesX * tileCells + 1
+ * 타일은 가장자리 샘플 한 줄을 이웃과 공유하므로 타일 안에서 bilinear 보간이 끝남
+ *
+ * 타일 데이터는 메모리 매핑된 파일에서 워커 스레드만 읽음
+ * → page fault(실제 디스크 I/O)가 렌더 스레드에서 절대 일어나지 않음
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace terrain {
+
+constexpr char HEIGHT_TILE_MAGIC[4] = {'H', 'T', 'I', 'L'};
+constexpr uint32_t HEIGHT_TILE_VERSION = 1;
+
+struct HeightTileFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t tileCells;      // 타일 한 변의 cell 수 (샘플 수 = tileCells + 1)
+    uint32_t tilesX;
+    uint32_t tilesY;
+    uint32_t overviewSize;   // overview 한 변의 샘플 수
+    uint64_t overviewOffset;
+};
+
+struct HeightTileIndexEntry {
+    uint64_t offset;
+    uint64_t byteSize;
+};
+
+// 읽기 전용 메모리 매핑 (POSIX mmap / Win32 MapViewOfFile)
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+class HeightTileFile {
+public:
+    // 헤더와 인덱스를 검증 (실패 시 false, 이유는 error())
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return mapped_.data() != nullptr; }
+    const HeightTileFileHeader& header() const { return header_; }
+    const std::string& error() const { return error_; }
+
+    uint32_t tileCount() const { return header_.tilesX * header_.tilesY; }
+    uint32_t tileSamples() const { return header_.tileCells + 1; }
+    size_t tileByteSize() const { return size_t(tileSamples()) * tileSamples() * sizeof(uint16_t); }
+
+    // 매핑된 메모리를 직접 가리킴 - 처음 접근 시 디스크 I/O가 일어날 수 있으므로 워커 스레드에서만 사용
+    const uint16_t* tileData(uint32_t tileIndex) const;
+    const uint16_t* overviewData() const;
+
+private:
+    MappedFile mapped_;
+    HeightTileFileHeader header_{};
+    const HeightTileIndexEntry* index_ = nullptr;
+    std::string error_;
+};
+
+// 전체 래스터 (width = tilesX * tileCells + 1 샘플)를 타일 파일로 저장
+bool writeHeightTileFile(const std::string& path, const std::vector<uint16_t>& samples,
+                         uint32_t width, uint32_t height, uint32_t tileCells,
+                         uint32_t overviewSize, std::string& error);
+
+struct LoadedTile {
+    uint32_t tileIndex;
+    std::vector<uint16_t> samples;
+};
+
+// 요청 목록(우선순위 순)을 워커 스레드가 앞에서부터 읽어 완료 큐에 넣음
+// requestTiles()는 목록을 통째로 교체 → 카메라가 지나간 오래된 요청은 자동으로 버려짐
+class TileStreamer {
+public:
+    ~TileStreamer();
+
+    void start(const HeightTileFile* file);
+    void stop();
+
+    void requestTiles(const std::vector<uint32_t>& tiles);
+    bool popLoaded(LoadedTile& tile);
+
+    size_t pendingCount();
+    uint64_t loadedTotal() const { return loadedTotal_.load(); }
+
+private:
+    void workerLoop();
+
+    const HeightTileFile* file_ = nullptr;
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<uint32_t> requests_;
+    std::vector<uint32_t> inFlight_;  // 읽는 중이거나 완료 큐에 있는 타일 (중복 요청 방지)
+    std::deque<LoadedTile> loaded_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> loadedTotal_{0};
+};
+
+} // namespace terrain
@@ -9,6 +9,14 @@
  * - Tessellation State 설정
  * - Patch Primitive 사용
  * - 절차적 노이즈로 지형 생성
+ * - Screen-space error 기반 적응형 테셀레이션 + 패치 frustum culling
+ * - Pipeline statistics query로 실제 생성된 primitive 수 측정
+ * - Compute shader로 heightfield를 텍스처에 구워 TES의 노이즈 계산 제거
+ * - CPU quadtree chunked LOD + frustum culling, 인스턴스 버퍼 + indirect draw 1회
+ * - 16-bit DEM 타일 스트리밍 (mmap + 워커 스레드, GPU texture array LRU 캐시, page table)
+ * - 테셀레이션 대신 geometry clipmap (중첩 링 메시 + toroidal 레벨 텍스처 + VS height fetch)
+ * - 셰이더와 비트 단위로 같은 CPU 높이/노말 batch 쿼리 (AVX2, --verify-height-query로 GPU와 비교)
+ * - Hydraulic/thermal erosion compute 시뮬레이션 (ping-pong stencil, 프레임당 몇 반복 또는 --erode batch)
  *
  * 작성: Claude (Anthropic)
  */
@@ -23,6 +31,7 @@
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 
 #include <iostream>
 #include <fstream>
@@ -34,6 +43,14 @@
 #include <cstdint>
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include "heightmap_tiles.h"
+#include "terrain_noise.h"
+#include "terrain_query.h"
 
 // ============================================================================
 // Constants
@@ -42,6 +59,68 @@ const uint32_t WIDTH = 1024;
 const uint32_t HEIGHT = 768;
 const int MAX_FRAMES_IN_FLIGHT = 2;
 
+// 지형 quadtree (root = TERRAIN_SIZE, leaf = TERRAIN_SIZE / 2^MAX_DEPTH)
+// 160 unit / 2^7 = 1.25 unit leaf → leaf 좌표는 모두 1.25의 정수배라 float로 정확히 표현됨
+const float TERRAIN_SIZE = 160.0f;
+const uint32_t QUADTREE_MAX_DEPTH = 7;
+const uint32_t MAX_PATCH_INSTANCES = 1u << (2 * QUADTREE_MAX_DEPTH);  // 모든 leaf가 최대 깊이일 때
+
+// getHeight()의 상한 (terrain.tesc의 HEIGHT_BOUND와 같은 값)
+const float TERRAIN_HEIGHT_BOUND = 1.2f;
+
+// Heightfield 텍스처 해상도 (정점 중심 그리드: 텍셀 0과 N-1이 지형 양 끝)
+// 160 unit / 2047 ≈ 0.08 unit 간격 → 가장 높은 주파수 noise(pos * 2, 주기 0.5)에 6텍셀
+const uint32_t HEIGHTMAP_SIZE = 2048;
+const float HEIGHTMAP_TEXEL_SPACING = TERRAIN_SIZE / (HEIGHTMAP_SIZE - 1);  // bake 셰이더에 그대로 전달
+
+// Geometry clipmap: 레벨마다 CLIPMAP_CELLS x CLIPMAP_CELLS cell, 간격은 레벨마다 2배
+// 가장 고운 레벨 간격 = heightfield 텍셀 간격 (테셀레이션 경로가 읽는 것과 같은 해상도)
+// 128 cell * 0.078 * 2^5 = 320 unit → 지형 어디에 있어도 마지막 레벨이 전체를 덮음
+const uint32_t CLIPMAP_LEVELS = 6;
+const uint32_t CLIPMAP_CELLS = 128;                  // 4의 배수 (안쪽 레벨 = 바깥 레벨의 절반 + 1 cell 여유)
+const uint32_t CLIPMAP_TEXELS = CLIPMAP_CELLS + 1;   // 레벨 텍스처 한 변 (toroidal)
+const float CLIPMAP_SPACING = HEIGHTMAP_TEXEL_SPACING;
+
+// GPU 패치 culling (patch_cull.comp)
+// 높이 범위 pyramid: level 0 = 최대 깊이 leaf 격자 (128^2) ~ 1, 깊이 d 패치 = level MAX_DEPTH - d
+// Hi-Z: 이전 프레임 depth의 max pyramid, 창 크기와 무관한 고정 크기 (창은 크기 변경 불가)
+const uint32_t HEIGHT_BOUNDS_SIZE = 1u << QUADTREE_MAX_DEPTH;
+const uint32_t HEIGHT_BOUNDS_LEVELS = QUADTREE_MAX_DEPTH + 1;
+const uint32_t HIZ_SIZE = 256;
+const uint32_t HIZ_LEVELS = 9;
+const uint32_t PATCH_CULL_GROUP_SIZE = 64;
+
+// 렌더러 비교 벤치마크 (같은 카메라 경로를 모드마다 재생)
+const uint32_t BENCHMARK_WARMUP_FRAMES = 30;  // 모드 전환 직후 프레임 + query readback 지연 제외
+const uint32_t BENCHMARK_FRAMES = 300;
+
+// CPU 높이 쿼리 검증 (--verify-height-query)
+const float HEIGHT_QUERY_VERIFY_TIMES[] = {0.0f, 37.25f};  // 정적 레이어만 / 애니메이션 레이어 포함
+const float NORMAL_QUERY_TOLERANCE = 2e-3f;                // normalMap은 RGBA16F (+ GPU normalize 정밀도)
+const size_t HEIGHT_QUERY_BENCH_SAMPLES = 1 << 22;
+
+// Erosion (erosion.comp): heightMap과 같은 해상도, 반복마다 4 pass
+// 반복당 최소 메모리 트래픽 (텍셀당 byte, 이웃 읽기는 캐시 적중 가정) - GB/s 추정용
+// flux 48 (state 16 + flux 읽기/쓰기 32), water 56 (state 16 + flux 16 + state 16 + velocity 8),
+// transport 56 (state 16 + velocity 8 + state 16 + thermal 16), thermal 48 (state 16 + thermal 16 + state 16)
+const double EROSION_BYTES_PER_TEXEL = 208.0;
+const uint32_t EROSION_BATCH_CHUNK = 64;           // --erode 제출당 반복 수 (긴 제출의 TDR 방지)
+const int MAX_EROSION_ITERATIONS_PER_FRAME = 64;
+const uint32_t ERODED_DEM_TILE_CELLS = 256;        // --erode 출력: 8x8 타일 (2049^2, 2048 텍셀을 재표본)
+const uint32_t ERODED_DEM_SIZE = HEIGHTMAP_SIZE / ERODED_DEM_TILE_CELLS * ERODED_DEM_TILE_CELLS + 1;
+
+// Pipeline statistics 결과 순서는 비트 순서를 따름
+// [0] clipping invocations (= rasterizer로 들어간 primitive 수)
+// [1] clipping primitives (clipping 후 남은 primitive 수)
+// [2] TCS patches
+// [3] TES invocations
+const VkQueryPipelineStatisticFlags PIPELINE_STATISTICS_FLAGS =
+    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT;
+const uint32_t PIPELINE_STATISTICS_COUNT = 4;
+
 const std::vector<const char*> validationLayers = {
     "VK_LAYER_KHRONOS_validation"
 };
@@ -52,40 +131,120 @@ const bool enableValidationLayers = false;
 const bool enableValidationLayers = true;
 #endif
 
+// DEM 타일 스트리밍
+const char* DEFAULT_TILE_FILE = "terrain.htiles";
+const uint32_t TILE_CACHE_LAYERS = 128;         // GPU 캐시 타일 수 (texture array layer)
+const uint32_t MAX_TILE_UPLOADS_PER_FRAME = 4;  // 프레임당 staging → 캐시 복사 상한
+const int MAX_TILE_STREAM_RADIUS = 3;           // prefetch 링 포함 (2R + 3)^2 <= 캐시 크기
+
+enum HeightSource {
+    HEIGHT_SOURCE_PROCEDURAL = 0,
+    HEIGHT_SOURCE_STREAMED = 1
+};
+
+enum TerrainMode {
+    TERRAIN_MODE_TESSELLATION = 0,
+    TERRAIN_MODE_CLIPMAP = 1
+};
+
 // ============================================================================
 // Structures
 // ============================================================================
 
-// 패치 정점 구조체
-struct PatchVertex {
-    glm::vec3 position;
-    glm::vec2 texCoord;
+// 보이는 quadtree leaf 하나 (binding 0, 인스턴스마다 8 byte)
+// 코너 4개는 VS가 gl_VertexIndex로 만들므로 정점/index 버퍼 없음
+// 위치는 최대 깊이 leaf 크기 단위의 정수 격자 좌표 (0 ~ 2^QUADTREE_MAX_DEPTH) → 16-bit로 충분
+struct PatchInstance {
+    uint16_t gridX;         // leaf 격자 좌표 (지형 최소 코너 기준)
+    uint16_t gridZ;
+    uint16_t depth;         // 패치 크기 = TERRAIN_SIZE / 2^depth
+    uint16_t coarserEdges;  // 더 큰 이웃과 맞닿은 엣지 비트: 0 = -x, 1 = -z, 2 = +x, 3 = +z
 
     static VkVertexInputBindingDescription getBindingDescription() {
         VkVertexInputBindingDescription binding{};
         binding.binding = 0;
-        binding.stride = sizeof(PatchVertex);
-        binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        binding.stride = sizeof(PatchInstance);
+        binding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
         return binding;
     }
+};
+
+static std::array<VkVertexInputAttributeDescription, 1> getPatchAttributeDescriptions() {
+    std::array<VkVertexInputAttributeDescription, 1> attrs{};
+
+    // (gridX, gridZ, depth, coarserEdges) → uvec4
+    attrs[0].binding = 0;
+    attrs[0].location = 0;
+    attrs[0].format = VK_FORMAT_R16G16B16A16_UINT;
+    attrs[0].offset = offsetof(PatchInstance, gridX);
+
+    return attrs;
+}
 
-    static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescriptions() {
-        std::array<VkVertexInputAttributeDescription, 2> attrs{};
+// Clipmap 격자 정점 (binding 0, 모든 레벨이 공유): 레벨 안의 정수 격자 좌표
+struct ClipmapVertex {
+    glm::vec2 grid;
 
-        attrs[0].binding = 0;
-        attrs[0].location = 0;
-        attrs[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-        attrs[0].offset = offsetof(PatchVertex, position);
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription binding{};
+        binding.binding = 0;
+        binding.stride = sizeof(ClipmapVertex);
+        binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        return binding;
+    }
+};
 
-        attrs[1].binding = 0;
-        attrs[1].location = 1;
-        attrs[1].format = VK_FORMAT_R32G32_SFLOAT;
-        attrs[1].offset = offsetof(PatchVertex, texCoord);
+// Clipmap 레벨 하나 (binding 1, draw마다 firstInstance = 레벨)
+struct ClipmapLevel {
+    glm::ivec2 origin;        // 레벨 창의 시작 격자점 (월드 = origin * spacing)
+    glm::ivec2 coarseOrigin;  // 다음 레벨의 origin (경계 morph용)
+    float spacing;
+    uint32_t level;
 
-        return attrs;
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription binding{};
+        binding.binding = 1;
+        binding.stride = sizeof(ClipmapLevel);
+        binding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+        return binding;
     }
 };
 
+static std::array<VkVertexInputAttributeDescription, 4> getClipmapAttributeDescriptions() {
+    std::array<VkVertexInputAttributeDescription, 4> attrs{};
+
+    attrs[0].binding = 0;
+    attrs[0].location = 0;
+    attrs[0].format = VK_FORMAT_R32G32_SFLOAT;
+    attrs[0].offset = offsetof(ClipmapVertex, grid);
+
+    // origin.xy + coarseOrigin.xy
+    attrs[1].binding = 1;
+    attrs[1].location = 1;
+    attrs[1].format = VK_FORMAT_R32G32B32A32_SINT;
+    attrs[1].offset = offsetof(ClipmapLevel, origin);
+
+    attrs[2].binding = 1;
+    attrs[2].location = 2;
+    attrs[2].format = VK_FORMAT_R32_SFLOAT;
+    attrs[2].offset = offsetof(ClipmapLevel, spacing);
+
+    attrs[3].binding = 1;
+    attrs[3].location = 3;
+    attrs[3].format = VK_FORMAT_R32_UINT;
+    attrs[3].offset = offsetof(ClipmapLevel, level);
+
+    return attrs;
+}
+
+// Quadtree 노드 (매 프레임 카메라 기준으로 다시 만듦)
+struct QuadtreeNode {
+    glm::vec2 min;       // xz 최소 코너
+    float size;
+    uint32_t depth;
+    int32_t firstChild;  // 자식 4개의 시작 인덱스 (0: min, 1: +x, 2: +z, 3: +x+z), -1 = leaf
+};
+
 // Push Constants
 struct PushConstants {
     glm::mat4 mvp;
@@ -93,6 +252,111 @@ struct PushConstants {
     float tessLevelInner;
     float heightScale;
     float time;
+    glm::vec3 cameraPos;
+    float screenScale;       // proj[1][1] * viewport 높이 / 2
+    float targetEdgePixels;  // 적응형 모드의 목표 엣지 길이 (픽셀)
+    int32_t adaptive;        // 0 = 균일 레벨, 1 = screen-space error
+    int32_t frustumCull;     // 1 = frustum 밖 패치를 레벨 0으로 폐기
+    float terrainSize;       // quadtree root 크기
+    int32_t heightSource;    // HeightSource
+    int32_t wireframe;       // 1 = 삼각형 엣지 overlay (terrain.frag, 같은 pass)
+};
+
+// Heightfield bake compute push constants (terrain_bake.comp)
+struct BakePushConstants {
+    int32_t mode;        // 0 = 정적 레이어, 1 = height, 2 = normal
+    float time;
+    float heightScale;
+    float terrainSize;
+    float texelSpacing;  // HEIGHTMAP_TEXEL_SPACING (GPU 나눗셈은 정밀도가 보장되지 않음)
+};
+
+enum BakeMode {
+    BAKE_STATIC_LAYER = 0,
+    BAKE_HEIGHT = 1,
+    BAKE_NORMAL = 2
+};
+
+// Clipmap 레벨 갱신 compute push constants (clipmap_update.comp)
+struct ClipmapUpdatePushConstants {
+    glm::ivec2 origin;
+    glm::ivec2 previousOrigin;
+    int32_t level;
+    int32_t fullUpdate;  // 1 = 레벨 전체, 0 = 새로 들어온 행/열만
+    float spacing;
+    float terrainSize;
+};
+
+// GPU culling 파라미터 (patch_cull.comp uniform, std140)
+struct CullParams {
+    glm::mat4 hiZViewProj;          // Hi-Z를 만든 프레임의 viewProj
+    glm::vec4 frustumPlanes[6];     // 이번 프레임 (extractFrustumPlanes)
+    uint32_t candidateCount;        // CPU quadtree leaf 수
+    float heightScale;
+    float terrainSize;
+    float heightBound;              // 높이 범위 pyramid가 없을 때 (DEM)
+    int32_t frustumCull;
+    int32_t occlusionCull;          // 0 = Hi-Z 없음 (첫 프레임, 꺼짐)
+    int32_t useHeightBounds;
+    int32_t padding;
+};
+
+// 높이 범위 / Hi-Z pyramid 빌드 push constants (height_bounds.comp, hiz_build.comp)
+struct CullPushConstants {
+    int32_t mode;   // PyramidMode
+    int32_t level;
+};
+
+enum PyramidMode {
+    PYRAMID_BASE = 0,    // 원본 (heightMap / depth) → level 0
+    PYRAMID_REDUCE = 1   // level - 1의 2x2 → level
+};
+
+// level 0 한 변이 size인 pyramid의 전체 텍셀 수
+static constexpr uint32_t pyramidTexelCount(uint32_t size) {
+    uint32_t count = 0;
+    for (; size > 0; size >>= 1) {
+        count += size * size;
+    }
+    return count;
+}
+
+// Erosion compute push constants (erosion.comp)
+struct ErosionPushConstants {
+    int32_t mode;             // ErosionMode
+    float timeStep;
+    float texelSpacing;
+    float heightScale;
+    float rainRate;
+    float sedimentCapacity;
+    float dissolveRate;
+    float depositionRate;
+    float evaporationRate;
+    float talusTangent;
+    float thermalRate;
+};
+
+enum ErosionMode {
+    EROSION_INIT = 0,       // heightMap → state, 나머지 0
+    EROSION_FLUX = 1,
+    EROSION_WATER = 2,
+    EROSION_TRANSPORT = 3,
+    EROSION_THERMAL = 4,
+    EROSION_WRITE_BACK = 5  // state의 지형 → heightMap
+};
+
+// 벤치마크 결과 (모드마다 하나)
+struct BenchmarkResult {
+    bool valid = false;
+    double gpuMs = 0.0;       // 지형 GPU 시간 (clipmap은 레벨 갱신 포함)
+    double frameMs = 0.0;     // CPU에서 잰 프레임 간격
+    double primitives = 0.0;  // rasterizer로 들어간 primitive 수
+};
+
+// GPU 타일 캐시의 layer 하나
+struct TileCacheSlot {
+    int32_t tile = -1;           // 상주 중인 타일 인덱스 (-1 = 비어 있음)
+    uint64_t lastUsedFrame = 0;  // LRU 기준
 };
 
 // ============================================================================
@@ -100,6 +364,8 @@ struct PushConstants {
 // ============================================================================
 class TessellationTerrainApp {
 public:
+    explicit TessellationTerrainApp(std::string tilePath) : tileFilePath(std::move(tilePath)) {}
+
     void run() {
         initWindow();
         initVulkan();
@@ -107,6 +373,36 @@ public:
         cleanup();
     }
 
+    // GPU bake 결과와 CPU 쿼리를 비교하고 처리량을 측정한 뒤 종료 (메인 루프 없음)
+    bool runHeightQueryVerification() {
+        initWindow();
+        initVulkan();
+
+        bool ok = true;
+        for (float time : HEIGHT_QUERY_VERIFY_TIMES) {
+            ok = verifyHeightQuery(time) && ok;
+        }
+        measureHeightQueryThroughput();
+
+        vkDeviceWaitIdle(device);
+        cleanup();
+        return ok;
+    }
+
+    // 창 없이 time 0 지형에 erosion을 iterations번 돌리고 통계/처리량 출력 (메인 루프 없음)
+    // outputPath가 있으면 결과를 DEM 타일 파일로 저장 (--tiles로 다시 볼 수 있음)
+    bool runErosionBatch(uint32_t iterations, const std::string& outputPath) {
+        headless = true;
+        initWindow();
+        initVulkan();
+
+        bool ok = erodeHeightfield(iterations, outputPath);
+
+        vkDeviceWaitIdle(device);
+        cleanup();
+        return ok;
+    }
+
 private:
     // Window
     GLFWwindow* window = nullptr;
@@ -139,9 +435,10 @@ private:
     std::vector<VkFramebuffer> framebuffers;
 
     // Pipeline
+    VkDescriptorSetLayout terrainDescriptorSetLayout = VK_NULL_HANDLE;
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
     VkPipeline tessellationPipeline = VK_NULL_HANDLE;
-    VkPipeline wireframePipeline = VK_NULL_HANDLE;
+    VkPipeline clipmapPipeline = VK_NULL_HANDLE;
 
     // Command
     VkCommandPool commandPool = VK_NULL_HANDLE;
@@ -153,12 +450,206 @@ private:
     std::vector<VkFence> inFlightFences;
     uint32_t currentFrame = 0;
 
-    // Vertex Buffer
-    VkBuffer vertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory vertexBufferMemory = VK_NULL_HANDLE;
-    VkBuffer indexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory indexBufferMemory = VK_NULL_HANDLE;
-    uint32_t indexCount = 0;
+    // Quadtree (프레임마다 인스턴스 + indirect 버퍼)
+    // 인스턴스: host staging (persistent mapping)에 쓰고 보이는 만큼만 device-local로 복사
+    // → TCS/TES가 읽는 데이터가 PCIe 너머 host 메모리에 있지 않음
+    std::vector<QuadtreeNode> quadtreeNodes;
+    std::vector<int32_t> quadtreeStack;
+    std::vector<VkBuffer> instanceStagingBuffers;
+    std::vector<VkDeviceMemory> instanceStagingMemory;
+    std::vector<PatchInstance*> instanceBuffersMapped;
+    std::vector<VkBuffer> instanceBuffers;
+    std::vector<VkDeviceMemory> instanceBuffersMemory;
+    std::vector<VkBuffer> indirectBuffers;  // device-local, vkCmdUpdateBuffer 또는 patch_cull.comp가 씀
+    std::vector<VkDeviceMemory> indirectBuffersMemory;
+
+    uint32_t quadtreeLeafCount = 0;
+    uint32_t visiblePatchCount = 0;  // 인스턴스 버퍼에 쓴 패치 수 (GPU culling이면 culling 전 후보)
+    float quadtreeUpdateMs = 0.0f;
+
+    // GPU culling: instanceBuffers (후보) → culledInstanceBuffers + indirect instanceCount
+    std::vector<VkBuffer> culledInstanceBuffers;
+    std::vector<VkDeviceMemory> culledInstanceMemory;
+    std::vector<VkBuffer> cullParamBuffers;
+    std::vector<VkDeviceMemory> cullParamMemory;
+    std::vector<CullParams*> cullParamsMapped;
+    std::vector<VkBuffer> cullReadbackBuffers;  // 통계용 instanceCount 사본 (host)
+    std::vector<VkDeviceMemory> cullReadbackMemory;
+    std::vector<uint32_t*> cullReadbackMapped;
+    std::vector<bool> cullReadbackIssued;
+
+    VkBuffer heightBoundsBuffer = VK_NULL_HANDLE;  // vec2 (min, max) pyramid
+    VkDeviceMemory heightBoundsMemory = VK_NULL_HANDLE;
+    VkBuffer hiZBuffer = VK_NULL_HANDLE;           // float max depth pyramid
+    VkDeviceMemory hiZMemory = VK_NULL_HANDLE;
+
+    VkDescriptorSetLayout cullDescriptorSetLayout = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> cullDescriptorSets;
+    VkPipelineLayout cullPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline heightBoundsPipeline = VK_NULL_HANDLE;
+    VkPipeline hiZPipeline = VK_NULL_HANDLE;
+    VkPipeline patchCullPipeline = VK_NULL_HANDLE;
+
+    bool hiZSupported = false;        // D32_SFLOAT를 샘플링할 수 있어야 Hi-Z 생성 가능
+    bool hiZValid = false;            // 직전 프레임이 Hi-Z를 만들었는지
+    glm::mat4 hiZViewProj{1.0f};
+    bool heightBoundsValid = false;
+    uint32_t heightBoundsBakeCount = 0;  // 높이 범위를 만들 때 사용한 heightBakeCount
+    uint32_t gpuVisiblePatchCount = 0;   // MAX_FRAMES_IN_FLIGHT 프레임 전 결과
+
+    // Geometry clipmap: 정점 격자 1개 + index 범위 (레벨 0 전체 격자, 링 4종)
+    // 링의 구멍 위치는 안쪽 레벨 origin의 짝/홀에 따라 x, z 각각 +0 또는 +1 cell
+    VkBuffer clipmapVertexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory clipmapVertexMemory = VK_NULL_HANDLE;
+    VkBuffer clipmapIndexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory clipmapIndexMemory = VK_NULL_HANDLE;
+    uint32_t clipmapFullIndexCount = 0;
+    uint32_t clipmapRingIndexCount = 0;
+    std::array<uint32_t, 4> clipmapRingFirstIndex{};
+
+    std::vector<VkBuffer> clipmapLevelBuffers;
+    std::vector<VkDeviceMemory> clipmapLevelMemory;
+    std::vector<ClipmapLevel*> clipmapLevelsMapped;
+
+    VkImage clipmapHeightImage = VK_NULL_HANDLE;  // R32F 2D array, layer = 레벨
+    VkDeviceMemory clipmapHeightMemory = VK_NULL_HANDLE;
+    VkImageView clipmapHeightView = VK_NULL_HANDLE;
+    VkPipelineLayout clipmapUpdatePipelineLayout = VK_NULL_HANDLE;
+    VkPipeline clipmapUpdatePipeline = VK_NULL_HANDLE;
+
+    // Erosion (erosion.comp, 항상 GENERAL layout)
+    // state 2장을 ping-pong: descriptor set k는 stateA = state[k], stateB = state[1 - k]
+    std::array<VkImage, 2> erosionStateImages{};
+    std::array<VkDeviceMemory, 2> erosionStateMemory{};
+    std::array<VkImageView, 2> erosionStateViews{};
+    VkImage erosionFluxImage = VK_NULL_HANDLE;
+    VkDeviceMemory erosionFluxMemory = VK_NULL_HANDLE;
+    VkImageView erosionFluxView = VK_NULL_HANDLE;
+    VkImage erosionVelocityImage = VK_NULL_HANDLE;
+    VkDeviceMemory erosionVelocityMemory = VK_NULL_HANDLE;
+    VkImageView erosionVelocityView = VK_NULL_HANDLE;
+    VkImage erosionThermalImage = VK_NULL_HANDLE;
+    VkDeviceMemory erosionThermalMemory = VK_NULL_HANDLE;
+    VkImageView erosionThermalView = VK_NULL_HANDLE;
+
+    VkDescriptorSetLayout erosionDescriptorSetLayout = VK_NULL_HANDLE;
+    std::array<VkDescriptorSet, 2> erosionDescriptorSets{};
+    VkPipelineLayout erosionPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline erosionPipeline = VK_NULL_HANDLE;
+
+    bool erosionInitialized = false;  // state를 현재 heightMap으로 채웠는지
+    uint32_t erosionCurrent = 0;      // 최신 결과가 있는 state 이미지
+    uint32_t erosionIterations = 0;   // 초기화 이후 누적 반복
+
+    std::array<glm::ivec2, CLIPMAP_LEVELS> clipmapOrigins{};         // 이번 프레임 레벨 창
+    std::array<glm::ivec2, CLIPMAP_LEVELS> clipmapUpdatedOrigins{};  // 텍스처에 반영된 창
+    std::array<uint32_t, CLIPMAP_LEVELS> clipmapRingVariant{};
+    bool clipmapTexturesValid = false;
+    uint32_t clipmapSourceBakeCount = 0;  // 레벨을 채울 때 사용한 heightBakeCount
+    uint32_t clipmapLevelsUpdated = 0;
+    uint32_t clipmapFullUpdates = 0;
+
+    // Heightfield (terrain_bake.comp가 굽고 TES가 읽음, 항상 GENERAL layout)
+    VkImage staticHeightImage = VK_NULL_HANDLE;
+    VkDeviceMemory staticHeightMemory = VK_NULL_HANDLE;
+    VkImageView staticHeightView = VK_NULL_HANDLE;
+    VkImage heightImage = VK_NULL_HANDLE;
+    VkDeviceMemory heightMemory = VK_NULL_HANDLE;
+    VkImageView heightView = VK_NULL_HANDLE;
+    VkImage normalImage = VK_NULL_HANDLE;
+    VkDeviceMemory normalMemory = VK_NULL_HANDLE;
+    VkImageView normalView = VK_NULL_HANDLE;
+    VkSampler terrainSampler = VK_NULL_HANDLE;
+
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSetLayout bakeDescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorSet bakeDescriptorSet = VK_NULL_HANDLE;
+    VkDescriptorSet terrainDescriptorSet = VK_NULL_HANDLE;
+    VkPipelineLayout bakePipelineLayout = VK_NULL_HANDLE;
+    VkPipeline bakePipeline = VK_NULL_HANDLE;
+
+    VkSampler nearestSampler = VK_NULL_HANDLE;  // texelFetch 전용 (정수/R32F 포맷)
+
+    // DEM 타일 스트리밍 (파일이 없으면 1x1 더미 리소스로 바인딩만 유지)
+    std::string tileFilePath;
+    terrain::HeightTileFile tileFile;
+    terrain::TileStreamer tileStreamer;
+    bool tilesAvailable = false;
+    uint32_t tilesX = 1;
+    uint32_t tilesY = 1;
+    uint32_t tileSamples = 2;
+    uint32_t overviewSize = 2;
+
+    VkImage tileCacheImage = VK_NULL_HANDLE;
+    VkDeviceMemory tileCacheMemory = VK_NULL_HANDLE;
+    VkImageView tileCacheView = VK_NULL_HANDLE;
+    VkImage pageTableImage = VK_NULL_HANDLE;
+    VkDeviceMemory pageTableMemory = VK_NULL_HANDLE;
+    VkImageView pageTableView = VK_NULL_HANDLE;
+    VkImage overviewImage = VK_NULL_HANDLE;
+    VkDeviceMemory overviewMemory = VK_NULL_HANDLE;
+    VkImageView overviewView = VK_NULL_HANDLE;
+
+    // 프레임마다 staging: [page table][overview][타일 x MAX_TILE_UPLOADS_PER_FRAME]
+    std::vector<VkBuffer> tileStagingBuffers;
+    std::vector<VkDeviceMemory> tileStagingMemory;
+    std::vector<uint8_t*> tileStagingMapped;
+    VkDeviceSize stagingOverviewOffset = 0;
+    VkDeviceSize stagingTilesOffset = 0;
+    VkDeviceSize stagingTileStride = 0;
+
+    std::vector<TileCacheSlot> tileCacheSlots;
+    std::vector<int32_t> tileResidentSlot;  // 타일 → 캐시 slot (-1 = 비상주)
+    std::vector<uint16_t> pageTableData;    // 타일 → slot + 1 (GPU page table의 CPU 사본)
+    std::vector<uint32_t> tileRequestScratch;
+    bool tileResourcesInitialized = false;
+    bool pageTableDirty = true;
+    uint64_t streamFrameIndex = 0;
+    uint32_t tileUploadsLastFrame = 0;
+    uint32_t residentTileCount = 0;
+
+    // 마지막으로 구운 파라미터 (바뀌었을 때만 다시 구움)
+    bool heightfieldInitialized = false;
+    float bakedTime = -1.0f;
+    float bakedHeightScale = -1.0f;
+    uint32_t heightBakeCount = 0;
+    uint32_t normalBakeCount = 0;
+
+    // Pipeline Statistics
+    VkQueryPool statisticsQueryPool = VK_NULL_HANDLE;
+    bool pipelineStatisticsSupported = false;
+    std::vector<bool> statisticsQueryIssued;
+    uint64_t pipelineStatistics[PIPELINE_STATISTICS_COUNT] = {};
+
+    // GPU 타임스탬프 (프레임마다 4개: 지형 작업 시작/끝, erosion 반복 시작/끝)
+    VkQueryPool timestampQueryPool = VK_NULL_HANDLE;
+    bool timestampsSupported = false;
+    float timestampPeriod = 1.0f;  // ns / tick
+    std::vector<bool> timestampQueryIssued;
+    std::vector<uint32_t> erosionTimestampIterations;  // 0 = 이 프레임 슬롯에서 erosion을 재지 않음
+    double terrainGpuMs = 0.0;
+    double erosionGpuMs = 0.0;
+    uint32_t erosionTimedIterations = 0;  // erosionGpuMs에 포함된 반복 수
+
+    // 테셀레이션이 없는 장치(일부 tiler, 소프트웨어 rasterizer)는 clipmap만 사용
+    bool tessellationSupported = false;
+    // VK_KHR_fragment_shader_barycentric: wireframe overlay가 실제 생성된 삼각형 엣지를 그림
+    // (없으면 TES의 테셀레이션 격자 좌표로 대체, outer 레벨 전이 띠의 엣지는 보이지 않음)
+    bool barycentricSupported = false;
+    // heightfield/DEM 텍스처를 읽는 그래픽스 단계 (barrier용, 테셀레이션이 없으면 TES 단계를 쓸 수 없음)
+    VkPipelineStageFlags terrainReadStage = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+
+    // 벤치마크: 모드별로 BENCHMARK_FRAMES 프레임씩 같은 카메라 경로를 재생
+    int benchmarkMode = -1;  // 진행 중인 TerrainMode, -1 = 대기
+    uint32_t benchmarkFrame = 0;
+    BenchmarkResult benchmarkAccum;
+    std::array<BenchmarkResult, 2> benchmarkResults{};
+    int savedTerrainMode = TERRAIN_MODE_TESSELLATION;
+    bool savedAutoRotate = true;
+    float savedCameraYaw = 0.0f;
+    float lastFrameMs = 0.0f;
+
+    bool headless = false;  // --erode: 창을 띄우지 않음 (surface/swapchain은 그대로 생성)
 
     // ImGui
     VkDescriptorPool imguiDescriptorPool = VK_NULL_HANDLE;
@@ -172,12 +663,37 @@ private:
     float tessLevelOuter = 16.0f;
     float tessLevelInner = 16.0f;
     float heightScale = 3.0f;
+    bool adaptiveTessellation = true;
+    bool frustumCulling = true;
+    bool gpuCulling = true;         // 패치 frustum/occlusion culling을 compute로 (끄면 CPU frustum culling)
+    bool occlusionCulling = true;   // GPU culling의 Hi-Z 검사
+    float targetEdgePixels = 8.0f;
+    float lodSplitPixels = 256.0f;  // 노드의 화면 크기가 이보다 크면 4개로 분할
+    int heightSource = HEIGHT_SOURCE_PROCEDURAL;
+    int terrainMode = TERRAIN_MODE_TESSELLATION;
+    int tileStreamRadius = 2;       // 카메라 타일 주변 (2R + 1)^2 타일 상주, 한 링 더 prefetch
+    bool animateTerrain = true;
+    float bakeRate = 30.0f;  // 애니메이션 레이어 재굽기 최대 빈도 (Hz)
+    float animationTime = 0.0f;
     bool wireframe = false;
     bool autoRotate = true;
     float rotationSpeed = 0.1f;
 
+    // Erosion (절차적 지형만, 켜면 애니메이션 재굽기를 멈추고 시뮬레이션 결과를 그림)
+    bool erosionEnabled = false;
+    bool erosionRunning = true;
+    int erosionIterationsPerFrame = 4;
+    float erosionTimeStep = 0.02f;
+    float rainRate = 0.012f;
+    float sedimentCapacity = 0.05f;
+    float dissolveRate = 0.1f;
+    float depositionRate = 0.1f;
+    float evaporationRate = 0.5f;
+    float talusTangent = 1.0f;     // 45도
+    float thermalRate = 5.0f;
+
     // Timing
-    std::chrono::high_resolution_clock::time_point startTime;
+    std::chrono::high_resolution_clock::time_point lastFrameTime;
 
     // ========================================================================
     // Initialization
@@ -186,10 +702,13 @@ private:
         glfwInit();
         glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
         glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+        if (headless) {
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        }
         window = glfwCreateWindow(WIDTH, HEIGHT, "09: Tessellation Terrain", nullptr, nullptr);
         glfwSetWindowUserPointer(window, this);
         glfwSetKeyCallback(window, keyCallback);
-        startTime = std::chrono::high_resolution_clock::now();
+        lastFrameTime = std::chrono::high_resolution_clock::now();
     }
 
     static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
@@ -218,10 +737,21 @@ private:
         createDepthResources();
         createFramebuffers();
         createCommandPool();
-        createTerrainMesh();
+        createPatchInstanceBuffers();
+        createCullingResources();
+        createClipmapMesh();
+        createHeightfieldResources();
+        createErosionResources();
+        createTileStreamingResources();
+        createDescriptorSets();
+        createBakePipeline();
+        createErosionPipeline();
+        createClipmapUpdatePipeline();
+        createCullPipelines();
         createPipeline();
         createCommandBuffers();
         createSyncObjects();
+        createQueryPool();
         initImGui();
     }
 
@@ -320,25 +850,77 @@ private:
         std::vector<VkPhysicalDevice> devices(deviceCount);
         vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
 
+        // 테셀레이션 지원 장치 우선, 없으면 clipmap 전용으로 첫 번째 장치 사용
         for (const auto& dev : devices) {
             VkPhysicalDeviceFeatures features;
             vkGetPhysicalDeviceFeatures(dev, &features);
 
-            // 테셀레이션 지원 확인
             if (features.tessellationShader && isDeviceSuitable(dev)) {
                 physicalDevice = dev;
                 break;
             }
         }
+        if (physicalDevice == VK_NULL_HANDLE) {
+            for (const auto& dev : devices) {
+                if (isDeviceSuitable(dev)) {
+                    physicalDevice = dev;
+                    break;
+                }
+            }
+        }
 
         if (physicalDevice == VK_NULL_HANDLE) {
-            throw std::runtime_error("No suitable GPU with tessellation support!");
+            throw std::runtime_error("No suitable GPU found!");
+        }
+
+        // 생성된 primitive 수 측정용 (없으면 통계 표시만 생략)
+        // query 플래그에 TCS/TES 통계가 들어 있으므로 테셀레이션이 없으면 함께 끔
+        VkPhysicalDeviceFeatures supportedFeatures;
+        vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+        tessellationSupported = supportedFeatures.tessellationShader == VK_TRUE;
+        pipelineStatisticsSupported = supportedFeatures.pipelineStatisticsQuery == VK_TRUE && tessellationSupported;
+        if (tessellationSupported) {
+            terrainReadStage = VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT;
+        } else {
+            terrainMode = TERRAIN_MODE_CLIPMAP;
+        }
+
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+        std::vector<VkExtensionProperties> extensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensions.data());
+        bool barycentricExtension = std::any_of(extensions.begin(), extensions.end(), [](const VkExtensionProperties& e) {
+            return std::strcmp(e.extensionName, VK_KHR_FRAGMENT_SHADER_BARYCENTRIC_EXTENSION_NAME) == 0;
+        });
+        if (barycentricExtension) {
+            VkPhysicalDeviceFragmentShaderBarycentricFeaturesKHR barycentricFeatures{};
+            barycentricFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADER_BARYCENTRIC_FEATURES_KHR;
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &barycentricFeatures;
+            vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+            barycentricSupported = barycentricFeatures.fragmentShaderBarycentric == VK_TRUE;
         }
 
         VkPhysicalDeviceProperties props;
         vkGetPhysicalDeviceProperties(physicalDevice, &props);
         std::cout << "Selected GPU: " << props.deviceName << std::endl;
-        std::cout << "Max tessellation level: " << props.limits.maxTessellationGenerationLevel << std::endl;
+        std::cout << "Wireframe overlay: " << (barycentricSupported ? "triangle barycentrics" : "tessellation lattice (fallback)")
+                  << std::endl;
+        if (tessellationSupported) {
+            std::cout << "Max tessellation level: " << props.limits.maxTessellationGenerationLevel << std::endl;
+        } else {
+            std::cout << "Tessellation not supported - geometry clipmap only" << std::endl;
+        }
+
+        // 지형 GPU 시간 측정용 타임스탬프
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+        timestampsSupported = queueFamilies[graphicsFamily].timestampValidBits > 0 &&
+                              props.limits.timestampPeriod > 0.0f;
+        timestampPeriod = props.limits.timestampPeriod;
     }
 
     bool isDeviceSuitable(VkPhysicalDevice dev) {
@@ -381,8 +963,8 @@ private:
 
         // 테셀레이션과 와이어프레임 피처 활성화
         VkPhysicalDeviceFeatures deviceFeatures{};
-        deviceFeatures.tessellationShader = VK_TRUE;
-        deviceFeatures.fillModeNonSolid = VK_TRUE;  // 와이어프레임용
+        deviceFeatures.tessellationShader = tessellationSupported ? VK_TRUE : VK_FALSE;
+        deviceFeatures.pipelineStatisticsQuery = pipelineStatisticsSupported ? VK_TRUE : VK_FALSE;
 
         std::vector<const char*> deviceExtensions = {
             VK_KHR_SWAPCHAIN_EXTENSION_NAME
@@ -392,8 +974,16 @@ private:
         deviceExtensions.push_back("VK_KHR_portability_subset");
 #endif
 
+        VkPhysicalDeviceFragmentShaderBarycentricFeaturesKHR barycentricFeatures{};
+        barycentricFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADER_BARYCENTRIC_FEATURES_KHR;
+        barycentricFeatures.fragmentShaderBarycentric = VK_TRUE;
+
         VkDeviceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        if (barycentricSupported) {
+            deviceExtensions.push_back(VK_KHR_FRAGMENT_SHADER_BARYCENTRIC_EXTENSION_NAME);
+            createInfo.pNext = &barycentricFeatures;
+        }
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
         createInfo.pEnabledFeatures = &deviceFeatures;
@@ -507,6 +1097,11 @@ private:
     void createDepthResources() {
         VkFormat depthFormat = VK_FORMAT_D32_SFLOAT;
 
+        // Hi-Z 생성 (hiz_build.comp)이 depth를 샘플링 → 지원하지 않으면 occlusion culling 없음
+        VkFormatProperties formatProps;
+        vkGetPhysicalDeviceFormatProperties(physicalDevice, depthFormat, &formatProps);
+        hiZSupported = (formatProps.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0;
+
         VkImageCreateInfo imageInfo{};
         imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         imageInfo.imageType = VK_IMAGE_TYPE_2D;
@@ -517,6 +1112,9 @@ private:
         imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
         imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
         imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        if (hiZSupported) {
+            imageInfo.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+        }
         imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
 
         vkCreateImage(device, &imageInfo, nullptr, &depthImage);
@@ -554,7 +1152,7 @@ private:
         depthAttachment.format = VK_FORMAT_D32_SFLOAT;
         depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
         depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;  // render pass 뒤 Hi-Z 생성에 사용
         depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -577,8 +1175,10 @@ private:
         VkSubpassDependency dependency{};
         dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
         dependency.dstSubpass = 0;
+        // compute: 이전 프레임 Hi-Z 생성의 depth 읽기가 끝난 뒤 clear (WAR)
         dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
-                                  VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+                                  VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                  VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
         dependency.srcAccessMask = 0;
         dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
                                   VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
@@ -627,244 +1227,1863 @@ private:
     // ========================================================================
     // Terrain Mesh (Quad Patches)
     // ========================================================================
-    void createTerrainMesh() {
-        // 그리드 생성 (N x N 패치)
-        const int gridSize = 8;
-        const float terrainSize = 20.0f;
-        const float patchSize = terrainSize / gridSize;
-
-        std::vector<PatchVertex> vertices;
-        std::vector<uint32_t> indices;
-
-        // 각 패치는 4개의 제어점을 가짐 (quads)
-        for (int z = 0; z < gridSize; z++) {
-            for (int x = 0; x < gridSize; x++) {
-                float x0 = (x - gridSize / 2.0f) * patchSize;
-                float z0 = (z - gridSize / 2.0f) * patchSize;
-                float x1 = x0 + patchSize;
-                float z1 = z0 + patchSize;
-
-                float u0 = static_cast<float>(x) / gridSize;
-                float v0 = static_cast<float>(z) / gridSize;
-                float u1 = static_cast<float>(x + 1) / gridSize;
-                float v1 = static_cast<float>(z + 1) / gridSize;
-
-                uint32_t baseIndex = static_cast<uint32_t>(vertices.size());
-
-                // 4 control points per patch (counter-clockwise)
-                vertices.push_back({{x0, 0.0f, z0}, {u0, v0}});  // 0: bottom-left
-                vertices.push_back({{x1, 0.0f, z0}, {u1, v0}});  // 1: bottom-right
-                vertices.push_back({{x1, 0.0f, z1}, {u1, v1}});  // 2: top-right
-                vertices.push_back({{x0, 0.0f, z1}, {u0, v1}});  // 3: top-left
-
-                // Patch indices
-                indices.push_back(baseIndex + 0);
-                indices.push_back(baseIndex + 1);
-                indices.push_back(baseIndex + 2);
-                indices.push_back(baseIndex + 3);
-            }
-        }
-
-        indexCount = static_cast<uint32_t>(indices.size());
+    void createPatchInstanceBuffers() {
+        instanceStagingBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        instanceStagingMemory.resize(MAX_FRAMES_IN_FLIGHT);
+        instanceBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
+        instanceBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        instanceBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
+        indirectBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        indirectBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
 
-        // Create vertex buffer
-        VkDeviceSize vbSize = sizeof(PatchVertex) * vertices.size();
-        createBuffer(vbSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                     vertexBuffer, vertexBufferMemory);
-
-        void* data;
-        vkMapMemory(device, vertexBufferMemory, 0, vbSize, 0, &data);
-        memcpy(data, vertices.data(), vbSize);
-        vkUnmapMemory(device, vertexBufferMemory);
+        VkDeviceSize instanceSize = sizeof(PatchInstance) * MAX_PATCH_INSTANCES;
 
-        // Create index buffer
-        VkDeviceSize ibSize = sizeof(uint32_t) * indices.size();
-        createBuffer(ibSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                     indexBuffer, indexBufferMemory);
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            createBuffer(instanceSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         instanceStagingBuffers[i], instanceStagingMemory[i]);
+            vkMapMemory(device, instanceStagingMemory[i], 0, instanceSize, 0,
+                        reinterpret_cast<void**>(&instanceBuffersMapped[i]));
+
+            // CPU culling이면 그대로 draw, GPU culling이면 patch_cull.comp의 후보 입력
+            createBuffer(instanceSize,
+                         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                         VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, instanceBuffers[i], instanceBuffersMemory[i]);
+
+            // instanceCount를 patch_cull.comp가 atomic으로 누적하므로 device-local
+            // (CPU culling이면 vkCmdUpdateBuffer로 명령 전체를 씀)
+            createBuffer(sizeof(VkDrawIndirectCommand),
+                         VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                         VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indirectBuffers[i], indirectBuffersMemory[i]);
+        }
 
-        vkMapMemory(device, indexBufferMemory, 0, ibSize, 0, &data);
-        memcpy(data, indices.data(), ibSize);
-        vkUnmapMemory(device, indexBufferMemory);
+        std::cout << "Created terrain quadtree: " << TERRAIN_SIZE << " units, max depth "
+                  << QUADTREE_MAX_DEPTH << " (leaf " << TERRAIN_SIZE / (1u << QUADTREE_MAX_DEPTH)
+                  << " units), " << sizeof(PatchInstance) << " bytes per patch" << std::endl;
 
-        std::cout << "Created terrain mesh: " << gridSize * gridSize << " patches, "
-                  << vertices.size() << " vertices" << std::endl;
+        quadtreeNodes.reserve(MAX_PATCH_INSTANCES * 2);
+        quadtreeStack.reserve(4 * QUADTREE_MAX_DEPTH + 4);
     }
 
-    // ========================================================================
-    // Pipeline
-    // ========================================================================
-    void createPipeline() {
-        // Load shaders
-        auto vertCode = readFile("shaders/terrain_vert.spv");
-        auto tescCode = readFile("shaders/terrain_tesc.spv");
-        auto teseCode = readFile("shaders/terrain_tese.spv");
-        auto fragCode = readFile("shaders/terrain_frag.spv");
-
-        VkShaderModule vertModule = createShaderModule(vertCode);
-        VkShaderModule tescModule = createShaderModule(tescCode);
-        VkShaderModule teseModule = createShaderModule(teseCode);
-        VkShaderModule fragModule = createShaderModule(fragCode);
+    // GPU culling 버퍼: 프레임마다 압축 결과 / 파라미터 / 통계 readback, 공유 pyramid 2개
+    void createCullingResources() {
+        culledInstanceBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        culledInstanceMemory.resize(MAX_FRAMES_IN_FLIGHT);
+        cullParamBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        cullParamMemory.resize(MAX_FRAMES_IN_FLIGHT);
+        cullParamsMapped.resize(MAX_FRAMES_IN_FLIGHT);
+        cullReadbackBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        cullReadbackMemory.resize(MAX_FRAMES_IN_FLIGHT);
+        cullReadbackMapped.resize(MAX_FRAMES_IN_FLIGHT);
+        cullReadbackIssued.assign(MAX_FRAMES_IN_FLIGHT, false);
 
-        // Shader stages
-        VkPipelineShaderStageCreateInfo vertStage{};
-        vertStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        vertStage.stage = VK_SHADER_STAGE_VERTEX_BIT;
-        vertStage.module = vertModule;
-        vertStage.pName = "main";
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            createBuffer(sizeof(PatchInstance) * MAX_PATCH_INSTANCES,
+                         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, culledInstanceBuffers[i], culledInstanceMemory[i]);
+
+            createBuffer(sizeof(CullParams), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         cullParamBuffers[i], cullParamMemory[i]);
+            vkMapMemory(device, cullParamMemory[i], 0, sizeof(CullParams), 0,
+                        reinterpret_cast<void**>(&cullParamsMapped[i]));
+
+            createBuffer(sizeof(uint32_t), VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         cullReadbackBuffers[i], cullReadbackMemory[i]);
+            vkMapMemory(device, cullReadbackMemory[i], 0, sizeof(uint32_t), 0,
+                        reinterpret_cast<void**>(&cullReadbackMapped[i]));
+        }
 
-        VkPipelineShaderStageCreateInfo tescStage{};
-        tescStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        tescStage.stage = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
-        tescStage.module = tescModule;
-        tescStage.pName = "main";
+        createBuffer(sizeof(glm::vec2) * pyramidTexelCount(HEIGHT_BOUNDS_SIZE), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, heightBoundsBuffer, heightBoundsMemory);
+        createBuffer(sizeof(float) * pyramidTexelCount(HIZ_SIZE), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, hiZBuffer, hiZMemory);
 
-        VkPipelineShaderStageCreateInfo teseStage{};
-        teseStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        teseStage.stage = VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
-        teseStage.module = teseModule;
-        teseStage.pName = "main";
+        if (!hiZSupported) {
+            std::cout << "D32_SFLOAT sampling not supported - occlusion culling disabled" << std::endl;
+        }
+    }
 
-        VkPipelineShaderStageCreateInfo fragStage{};
-        fragStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        fragStage.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-        fragStage.module = fragModule;
-        fragStage.pName = "main";
+    // (CELLS + 1)^2 정점 격자 1개를 모든 레벨이 공유
+    // index: [레벨 0 전체 격자][링 (hole x +0, z +0)][(+1, +0)][(+0, +1)][(+1, +1)]
+    // 링의 구멍 = 안쪽 레벨 자리, 크기 CELLS/2, 시작 cell CELLS/4 (+0 또는 +1)
+    void createClipmapMesh() {
+        const uint32_t n = CLIPMAP_TEXELS;
+        std::vector<ClipmapVertex> vertices;
+        vertices.reserve(n * n);
+        for (uint32_t z = 0; z < n; z++) {
+            for (uint32_t x = 0; x < n; x++) {
+                vertices.push_back({glm::vec2(x, z)});
+            }
+        }
 
-        std::array<VkPipelineShaderStageCreateInfo, 4> shaderStages = {
-            vertStage, tescStage, teseStage, fragStage
+        // 테셀레이션 경로와 같은 감김 순서 ((x, z) 평면에서 반시계)
+        std::vector<uint16_t> indices;
+        auto appendCells = [&](int holeX, int holeZ) {
+            for (uint32_t z = 0; z < CLIPMAP_CELLS; z++) {
+                for (uint32_t x = 0; x < CLIPMAP_CELLS; x++) {
+                    bool inHole = holeX >= 0 &&
+                        int(x) >= holeX && int(x) < holeX + int(CLIPMAP_CELLS / 2) &&
+                        int(z) >= holeZ && int(z) < holeZ + int(CLIPMAP_CELLS / 2);
+                    if (inHole) {
+                        continue;
+                    }
+
+                    uint16_t i00 = static_cast<uint16_t>(z * n + x);
+                    uint16_t i10 = static_cast<uint16_t>(i00 + 1);
+                    uint16_t i01 = static_cast<uint16_t>(i00 + n);
+                    uint16_t i11 = static_cast<uint16_t>(i01 + 1);
+                    indices.insert(indices.end(), {i00, i10, i11, i00, i11, i01});
+                }
+            }
         };
 
-        // Vertex input
-        auto bindingDesc = PatchVertex::getBindingDescription();
-        auto attrDescs = PatchVertex::getAttributeDescriptions();
-
-        VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
-        vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-        vertexInputInfo.vertexBindingDescriptionCount = 1;
-        vertexInputInfo.pVertexBindingDescriptions = &bindingDesc;
-        vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attrDescs.size());
-        vertexInputInfo.pVertexAttributeDescriptions = attrDescs.data();
+        appendCells(-1, -1);
+        clipmapFullIndexCount = static_cast<uint32_t>(indices.size());
+        for (uint32_t variant = 0; variant < 4; variant++) {
+            clipmapRingFirstIndex[variant] = static_cast<uint32_t>(indices.size());
+            appendCells(CLIPMAP_CELLS / 4 + (variant & 1), CLIPMAP_CELLS / 4 + (variant >> 1));
+        }
+        clipmapRingIndexCount = clipmapRingFirstIndex[1] - clipmapRingFirstIndex[0];
+
+        createDeviceLocalBuffer(vertices.data(), sizeof(ClipmapVertex) * vertices.size(),
+                                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, clipmapVertexBuffer, clipmapVertexMemory);
+        createDeviceLocalBuffer(indices.data(), sizeof(uint16_t) * indices.size(),
+                                VK_BUFFER_USAGE_INDEX_BUFFER_BIT, clipmapIndexBuffer, clipmapIndexMemory);
+
+        // 레벨 데이터 (프레임마다, persistent mapping, 레벨당 28 byte라 host 메모리에 둠)
+        clipmapLevelBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        clipmapLevelMemory.resize(MAX_FRAMES_IN_FLIGHT);
+        clipmapLevelsMapped.resize(MAX_FRAMES_IN_FLIGHT);
+        VkDeviceSize levelSize = sizeof(ClipmapLevel) * CLIPMAP_LEVELS;
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            createBuffer(levelSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         clipmapLevelBuffers[i], clipmapLevelMemory[i]);
+            vkMapMemory(device, clipmapLevelMemory[i], 0, levelSize, 0,
+                        reinterpret_cast<void**>(&clipmapLevelsMapped[i]));
+        }
 
-        // Input assembly - PATCH_LIST for tessellation
-        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
-        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_PATCH_LIST;  // 중요!
-        inputAssembly.primitiveRestartEnable = VK_FALSE;
+        std::cout << "Created geometry clipmap: " << CLIPMAP_LEVELS << " levels x " << n * n
+                  << " vertices, finest spacing " << CLIPMAP_SPACING << std::endl;
+    }
 
-        // Tessellation state
-        VkPipelineTessellationStateCreateInfo tessellationState{};
-        tessellationState.sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO;
-        tessellationState.patchControlPoints = 4;  // Quad patches
+    // ========================================================================
+    // Geometry Clipmap
+    // ========================================================================
+    // 레벨 l의 창: 카메라가 있는 격자점을 짝수로 내린 뒤 CELLS/2만큼 뺀 위치
+    // → 레벨 l의 창은 레벨 l+1 격자에 정렬되고, l+1 창 안에서 CELLS/4 (+0 또는 +1) cell에 놓임
+    // 정수 연산만 쓰므로 CPU의 링 종류 선택과 VS/compute의 좌표가 항상 일치
+    void updateClipmapLevels() {
+        // 격자 원점은 지형 코너 (-TERRAIN_SIZE/2): 레벨 0 격자점 = heightfield 텍셀
+        int32_t cellX = static_cast<int32_t>(std::floor((cameraPos.x + TERRAIN_SIZE * 0.5f) / CLIPMAP_SPACING));
+        int32_t cellZ = static_cast<int32_t>(std::floor((cameraPos.z + TERRAIN_SIZE * 0.5f) / CLIPMAP_SPACING));
+        const int32_t halfCells = static_cast<int32_t>(CLIPMAP_CELLS / 2);
+
+        for (uint32_t l = 0; l < CLIPMAP_LEVELS; l++) {
+            // 음수에서도 floor가 되도록 산술 shift / 비트 마스크
+            int32_t x = (cellX >> l) & ~1;
+            int32_t z = (cellZ >> l) & ~1;
+            clipmapOrigins[l] = glm::ivec2(x - halfCells, z - halfCells);
+        }
 
-        // Viewport
-        VkViewport viewport{};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = static_cast<float>(swapchainExtent.width);
-        viewport.height = static_cast<float>(swapchainExtent.height);
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
+        ClipmapLevel* levels = clipmapLevelsMapped[currentFrame];
+        for (uint32_t l = 0; l < CLIPMAP_LEVELS; l++) {
+            levels[l].origin = clipmapOrigins[l];
+            levels[l].coarseOrigin = clipmapOrigins[std::min(l + 1, CLIPMAP_LEVELS - 1)];
+            levels[l].spacing = CLIPMAP_SPACING * static_cast<float>(1u << l);
+            levels[l].level = l;
 
-        VkRect2D scissor{};
-        scissor.offset = {0, 0};
-        scissor.extent = swapchainExtent;
+            if (l > 0) {
+                glm::ivec2 hole = clipmapOrigins[l - 1] / 2 - clipmapOrigins[l] - int32_t(CLIPMAP_CELLS / 4);
+                clipmapRingVariant[l] = static_cast<uint32_t>(hole.x + 2 * hole.y);
+            }
+        }
+    }
 
-        VkPipelineViewportStateCreateInfo viewportState{};
-        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-        viewportState.viewportCount = 1;
-        viewportState.pViewports = &viewport;
-        viewportState.scissorCount = 1;
-        viewportState.pScissors = &scissor;
+    // 창이 움직인 레벨만 새 행/열을 채움, heightfield가 다시 구워졌으면 전체
+    void recordClipmapUpdate(VkCommandBuffer cmd) {
+        bool fullUpdate = !clipmapTexturesValid || clipmapSourceBakeCount != heightBakeCount;
+        clipmapLevelsUpdated = 0;
 
-        // Rasterizer (solid fill)
-        VkPipelineRasterizationStateCreateInfo rasterizer{};
-        rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-        rasterizer.depthClampEnable = VK_FALSE;
-        rasterizer.rasterizerDiscardEnable = VK_FALSE;
-        rasterizer.polygonMode = VK_POLYGON_MODE_FILL;  // Solid
-        rasterizer.lineWidth = 1.0f;
-        rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-        rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-        rasterizer.depthBiasEnable = VK_FALSE;
+        std::vector<uint32_t> dirtyLevels;
+        for (uint32_t l = 0; l < CLIPMAP_LEVELS; l++) {
+            if (fullUpdate || clipmapOrigins[l] != clipmapUpdatedOrigins[l]) {
+                dirtyLevels.push_back(l);
+            }
+        }
+        if (dirtyLevels.empty()) {
+            return;
+        }
 
-        // Multisample
-        VkPipelineMultisampleStateCreateInfo multisampling{};
-        multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-        multisampling.sampleShadingEnable = VK_FALSE;
-        multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+        // heightMap bake 쓰기 → 읽기 (구운 내용을 유지해야 하므로 항상 GENERAL → GENERAL)
+        recordImageBarrier(cmd, {heightImage}, VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+        // clipmap: 이전 프레임 VS 읽기 → 덮어쓰기 (WAR), 첫 갱신에서만 UNDEFINED에서 전환
+        recordImageBarrier(cmd, {clipmapHeightImage},
+            clipmapTexturesValid ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, clipmapUpdatePipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, clipmapUpdatePipelineLayout,
+            0, 1, &bakeDescriptorSet, 0, nullptr);
+
+        uint32_t groups = (CLIPMAP_TEXELS + 15) / 16;
+        for (uint32_t l : dirtyLevels) {
+            ClipmapUpdatePushConstants pc{};
+            pc.origin = clipmapOrigins[l];
+            pc.previousOrigin = clipmapUpdatedOrigins[l];
+            pc.level = static_cast<int32_t>(l);
+            pc.fullUpdate = fullUpdate ? 1 : 0;
+            pc.spacing = CLIPMAP_SPACING * static_cast<float>(1u << l);
+            pc.terrainSize = TERRAIN_SIZE;
+
+            vkCmdPushConstants(cmd, clipmapUpdatePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pc), &pc);
+            vkCmdDispatch(cmd, groups, groups, 1);
+
+            clipmapUpdatedOrigins[l] = clipmapOrigins[l];
+        }
 
-        // Depth stencil
-        VkPipelineDepthStencilStateCreateInfo depthStencil{};
-        depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-        depthStencil.depthTestEnable = VK_TRUE;
-        depthStencil.depthWriteEnable = VK_TRUE;
-        depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
-        depthStencil.depthBoundsTestEnable = VK_FALSE;
-        depthStencil.stencilTestEnable = VK_FALSE;
+        recordImageBarrier(cmd, {clipmapHeightImage}, VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
 
-        // Color blending
-        VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
-                                              VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-        colorBlendAttachment.blendEnable = VK_FALSE;
+        clipmapLevelsUpdated = static_cast<uint32_t>(dirtyLevels.size());
+        if (fullUpdate) {
+            clipmapFullUpdates++;
+        }
+        clipmapTexturesValid = true;
+        clipmapSourceBakeCount = heightBakeCount;
+    }
 
-        VkPipelineColorBlendStateCreateInfo colorBlending{};
-        colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-        colorBlending.logicOpEnable = VK_FALSE;
-        colorBlending.attachmentCount = 1;
-        colorBlending.pAttachments = &colorBlendAttachment;
+    void createClipmapUpdatePipeline() {
+        auto compCode = readFile("shaders/clipmap_update_comp.spv");
+        VkShaderModule compModule = createShaderModule(compCode);
 
-        // Push constants
         VkPushConstantRange pushConstantRange{};
-        pushConstantRange.stageFlags = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT |
-                                       VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT |
-                                       VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
         pushConstantRange.offset = 0;
-        pushConstantRange.size = sizeof(PushConstants);
+        pushConstantRange.size = sizeof(ClipmapUpdatePushConstants);
 
-        // Pipeline layout
+        // bake와 같은 descriptor set (binding 1 = heightMap, 3 = clipmap 레벨)
         VkPipelineLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &bakeDescriptorSetLayout;
         layoutInfo.pushConstantRangeCount = 1;
         layoutInfo.pPushConstantRanges = &pushConstantRange;
 
-        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create pipeline layout!");
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &clipmapUpdatePipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create clipmap update pipeline layout!");
         }
 
-        // Create solid pipeline
-        VkGraphicsPipelineCreateInfo pipelineInfo{};
-        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-        pipelineInfo.stageCount = static_cast<uint32_t>(shaderStages.size());
-        pipelineInfo.pStages = shaderStages.data();
-        pipelineInfo.pVertexInputState = &vertexInputInfo;
-        pipelineInfo.pInputAssemblyState = &inputAssembly;
-        pipelineInfo.pTessellationState = &tessellationState;  // 중요!
-        pipelineInfo.pViewportState = &viewportState;
-        pipelineInfo.pRasterizationState = &rasterizer;
-        pipelineInfo.pMultisampleState = &multisampling;
-        pipelineInfo.pDepthStencilState = &depthStencil;
-        pipelineInfo.pColorBlendState = &colorBlending;
-        pipelineInfo.layout = pipelineLayout;
-        pipelineInfo.renderPass = renderPass;
-        pipelineInfo.subpass = 0;
-
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
-                                      &tessellationPipeline) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create tessellation pipeline!");
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = compModule;
+        pipelineInfo.stage.pName = "main";
+        pipelineInfo.layout = clipmapUpdatePipelineLayout;
+
+        if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
+                                     &clipmapUpdatePipeline) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create clipmap update pipeline!");
         }
 
-        // Create wireframe pipeline
-        rasterizer.polygonMode = VK_POLYGON_MODE_LINE;  // Wireframe
-        rasterizer.cullMode = VK_CULL_MODE_NONE;
+        vkDestroyShaderModule(device, compModule, nullptr);
+    }
 
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
-                                      &wireframePipeline) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create wireframe pipeline!");
+    // ========================================================================
+    // Quadtree LOD
+    // ========================================================================
+    // 노드 AABB까지의 거리로 화면 크기를 추정 (y 범위 = [0, 높이 상한])
+    bool shouldSplit(const QuadtreeNode& node, float screenScale) const {
+        glm::vec3 boxMin(node.min.x, 0.0f, node.min.y);
+        glm::vec3 boxMax(node.min.x + node.size, heightScale * TERRAIN_HEIGHT_BOUND, node.min.y + node.size);
+        glm::vec3 closest = glm::clamp(cameraPos, boxMin, boxMax);
+        float dist = std::max(glm::length(cameraPos - closest), 0.001f);
+
+        return node.size * screenScale / dist > lodSplitPixels;
+    }
+
+    void splitNode(size_t index) {
+        QuadtreeNode node = quadtreeNodes[index];  // push_back이 참조를 무효화하므로 복사
+        float half = node.size * 0.5f;
+
+        quadtreeNodes[index].firstChild = static_cast<int32_t>(quadtreeNodes.size());
+        for (int child = 0; child < 4; child++) {
+            glm::vec2 offset((child & 1) ? half : 0.0f, (child & 2) ? half : 0.0f);
+            quadtreeNodes.push_back({node.min + offset, half, node.depth + 1, -1});
+        }
+    }
+
+    // 점 p를 포함하는 leaf (지형 밖이면 -1), 비용 O(depth)
+    int32_t findLeaf(glm::vec2 p) const {
+        const QuadtreeNode& root = quadtreeNodes[0];
+        if (p.x < root.min.x || p.y < root.min.y ||
+            p.x >= root.min.x + root.size || p.y >= root.min.y + root.size) {
+            return -1;
+        }
+
+        int32_t index = 0;
+        while (quadtreeNodes[index].firstChild >= 0) {
+            const QuadtreeNode& node = quadtreeNodes[index];
+            float half = node.size * 0.5f;
+            int child = (p.x >= node.min.x + half ? 1 : 0) + (p.y >= node.min.y + half ? 2 : 0);
+            index = node.firstChild + child;
+        }
+        return index;
+    }
+
+    // leaf의 네 엣지 바깥쪽 점 (-x, -z, +x, +z 순서, 엣지에서 leaf 크기의 1/4 떨어진 곳)
+    // 더 큰 이웃은 이 점을 반드시 포함하므로 findLeaf 한 번으로 찾을 수 있음
+    static std::array<glm::vec2, 4> edgeProbes(const QuadtreeNode& leaf) {
+        glm::vec2 center = leaf.min + glm::vec2(leaf.size * 0.5f);
+        float d = leaf.size * 0.75f;
+        return {{
+            center + glm::vec2(-d, 0.0f),
+            center + glm::vec2(0.0f, -d),
+            center + glm::vec2(d, 0.0f),
+            center + glm::vec2(0.0f, d)
+        }};
+    }
+
+    // 2:1 균형: 이웃 leaf끼리 깊이 차이가 1 이하가 되도록 큰 쪽을 분할
+    // (TCS가 더 큰 이웃과의 엣지를 레벨 절반으로 맞추는 crack 방지의 전제 조건)
+    void balanceQuadtree() {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            size_t count = quadtreeNodes.size();
+            for (size_t i = 0; i < count; i++) {
+                if (quadtreeNodes[i].firstChild >= 0) {
+                    continue;
+                }
+                QuadtreeNode leaf = quadtreeNodes[i];
+                for (const glm::vec2& probe : edgeProbes(leaf)) {
+                    int32_t neighbor = findLeaf(probe);
+                    if (neighbor >= 0 && quadtreeNodes[neighbor].depth + 1 < leaf.depth) {
+                        splitNode(static_cast<size_t>(neighbor));
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // viewProj의 행 조합으로 frustum plane 6개 추출 (Vulkan depth 0~1)
+    static std::array<glm::vec4, 6> extractFrustumPlanes(const glm::mat4& m) {
+        glm::vec4 r0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 r1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 r2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 r3(m[0][3], m[1][3], m[2][3], m[3][3]);
+        return {{r3 + r0, r3 - r0, r3 + r1, r3 - r1, r2, r3 - r2}};
+    }
+
+    // AABB가 어떤 plane의 완전히 바깥이면 false (positive vertex 검사)
+    static bool intersectsFrustum(const std::array<glm::vec4, 6>& planes,
+                                  const glm::vec3& boxMin, const glm::vec3& boxMax) {
+        for (const glm::vec4& plane : planes) {
+            glm::vec3 p(plane.x >= 0.0f ? boxMax.x : boxMin.x,
+                        plane.y >= 0.0f ? boxMax.y : boxMin.y,
+                        plane.z >= 0.0f ? boxMax.z : boxMin.z);
+            if (glm::dot(glm::vec3(plane), p) + plane.w < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 1. 카메라 기준 LOD 분할 (먼 곳은 큰 노드 → 노드 수는 지형 면적이 아니라 log에 비례)
+    // 2. 2:1 균형
+    // 3. 계층적 frustum culling 하며 보이는 leaf를 이번 프레임 인스턴스 버퍼에 기록
+    //    (GPU culling이면 모든 leaf를 후보로 기록, culling은 patch_cull.comp)
+    void updateQuadtree(const glm::mat4& viewProj, float screenScale) {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        quadtreeNodes.clear();
+        quadtreeNodes.push_back({glm::vec2(-TERRAIN_SIZE * 0.5f), TERRAIN_SIZE, 0, -1});
+
+        // push_back으로 늘어나는 배열을 그대로 순회 (BFS)
+        for (size_t i = 0; i < quadtreeNodes.size(); i++) {
+            if (quadtreeNodes[i].depth < QUADTREE_MAX_DEPTH && shouldSplit(quadtreeNodes[i], screenScale)) {
+                splitNode(i);
+            }
+        }
+
+        balanceQuadtree();
+
+        auto planes = extractFrustumPlanes(viewProj);
+        float maxY = heightScale * TERRAIN_HEIGHT_BOUND;
+        float leafSize = TERRAIN_SIZE / (1u << QUADTREE_MAX_DEPTH);
+        PatchInstance* instances = instanceBuffersMapped[currentFrame];
+
+        quadtreeLeafCount = 0;
+        visiblePatchCount = 0;
+        quadtreeStack.clear();
+        quadtreeStack.push_back(0);
+
+        while (!quadtreeStack.empty()) {
+            int32_t index = quadtreeStack.back();
+            quadtreeStack.pop_back();
+            const QuadtreeNode& node = quadtreeNodes[index];
+
+            if (frustumCulling && !gpuCulling) {
+                glm::vec3 boxMin(node.min.x, 0.0f, node.min.y);
+                glm::vec3 boxMax(node.min.x + node.size, maxY, node.min.y + node.size);
+                if (!intersectsFrustum(planes, boxMin, boxMax)) {
+                    continue;
+                }
+            }
+
+            if (node.firstChild >= 0) {
+                for (int child = 0; child < 4; child++) {
+                    quadtreeStack.push_back(node.firstChild + child);
+                }
+                continue;
+            }
+
+            quadtreeLeafCount++;
+            if (visiblePatchCount >= MAX_PATCH_INSTANCES) {
+                continue;
+            }
+
+            uint32_t coarserEdges = 0;
+            auto probes = edgeProbes(node);
+            for (uint32_t edge = 0; edge < 4; edge++) {
+                int32_t neighbor = findLeaf(probes[edge]);
+                if (neighbor >= 0 && quadtreeNodes[neighbor].depth < node.depth) {
+                    coarserEdges |= 1u << edge;
+                }
+            }
+
+            // node.min은 leaf 크기의 정수배 (TERRAIN_SIZE를 반복해서 반으로 나눈 값)라 정확히 변환됨
+            glm::vec2 grid = (node.min + TERRAIN_SIZE * 0.5f) / leafSize;
+            instances[visiblePatchCount++] = {
+                static_cast<uint16_t>(grid.x), static_cast<uint16_t>(grid.y),
+                static_cast<uint16_t>(node.depth), static_cast<uint16_t>(coarserEdges)
+            };
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        quadtreeUpdateMs = std::chrono::duration<float, std::milli>(end - start).count();
+    }
+
+    // 보이는 패치만 staging → device-local 복사 + indirect 명령 (render pass 밖)
+    // GPU culling이면 instanceCount = 0으로 두고 patch_cull.comp가 누적
+    // 같은 프레임 슬롯의 이전 draw는 fence 대기로 이미 끝났으므로 WAR barrier 불필요
+    void recordPatchInstanceUpload(VkCommandBuffer cmd) {
+        std::vector<VkBufferMemoryBarrier> barriers;
+
+        if (visiblePatchCount > 0) {
+            VkBufferCopy region{};
+            region.size = sizeof(PatchInstance) * visiblePatchCount;
+            vkCmdCopyBuffer(cmd, instanceStagingBuffers[currentFrame], instanceBuffers[currentFrame], 1, &region);
+
+            VkBufferMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = gpuCulling ? VK_ACCESS_SHADER_READ_BIT : VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.buffer = instanceBuffers[currentFrame];
+            barrier.offset = 0;
+            barrier.size = region.size;
+            barriers.push_back(barrier);
+        }
+
+        VkDrawIndirectCommand command{};
+        command.vertexCount = 4;  // 패치 control point (VS가 gl_VertexIndex로 코너 생성)
+        command.instanceCount = gpuCulling ? 0 : visiblePatchCount;
+        vkCmdUpdateBuffer(cmd, indirectBuffers[currentFrame], 0, sizeof(command), &command);
+
+        VkBufferMemoryBarrier commandBarrier{};
+        commandBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        commandBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        commandBarrier.dstAccessMask = gpuCulling
+            ? VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+            : VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        commandBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        commandBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        commandBarrier.buffer = indirectBuffers[currentFrame];
+        commandBarrier.offset = 0;
+        commandBarrier.size = sizeof(command);
+        barriers.push_back(commandBarrier);
+
+        VkPipelineStageFlags dstStages = gpuCulling
+            ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+            : VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStages, 0,
+            0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data(), 0, nullptr);
+    }
+
+    // ========================================================================
+    // GPU Patch Culling
+    // ========================================================================
+    void createCullPipelines() {
+        // 세 셰이더가 cullDescriptorSetLayout 하나를 공유 (각자 필요한 binding만 선언)
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(CullPushConstants);
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &cullDescriptorSetLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &cullPipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create cull pipeline layout!");
+        }
+
+        heightBoundsPipeline = createCullComputePipeline("shaders/height_bounds_comp.spv");
+        hiZPipeline = createCullComputePipeline("shaders/hiz_build_comp.spv");
+        patchCullPipeline = createCullComputePipeline("shaders/patch_cull_comp.spv");
+    }
+
+    VkPipeline createCullComputePipeline(const std::string& path) {
+        auto compCode = readFile(path);
+        VkShaderModule compModule = createShaderModule(compCode);
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = compModule;
+        pipelineInfo.stage.pName = "main";
+        pipelineInfo.layout = cullPipelineLayout;
+
+        VkPipeline pipeline;
+        if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create compute pipeline: " + path);
+        }
+
+        vkDestroyShaderModule(device, compModule, nullptr);
+        return pipeline;
+    }
+
+    // compute 쓰기 → 다음 compute 읽기/쓰기 (pyramid level 사이, 버퍼 전체)
+    void recordComputeBarrier(VkCommandBuffer cmd) {
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+            1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    // level 0을 원본에서 만들고 나머지는 2x2씩 축소
+    void recordPyramidBuild(VkCommandBuffer cmd, VkPipeline pipeline, uint32_t size, uint32_t levels) {
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout,
+            0, 1, &cullDescriptorSets[currentFrame], 0, nullptr);
+
+        for (uint32_t level = 0; level < levels; level++) {
+            if (level > 0) {
+                recordComputeBarrier(cmd);
+            }
+
+            CullPushConstants pc{};
+            pc.mode = level == 0 ? PYRAMID_BASE : PYRAMID_REDUCE;
+            pc.level = static_cast<int32_t>(level);
+            vkCmdPushConstants(cmd, cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pc), &pc);
+
+            uint32_t groups = ((size >> level) + 7) / 8;
+            vkCmdDispatch(cmd, groups, groups, 1);
+        }
+
+        recordComputeBarrier(cmd);
+    }
+
+    // heightMap이 새로 구워졌을 때만 패치 높이 범위를 다시 만듦 (bake 직후, 같은 compute 큐)
+    // 이전 프레임 culling의 읽기는 barrier의 COMPUTE src 단계에 포함됨 (WAR)
+    void recordHeightBoundsBuild(VkCommandBuffer cmd) {
+        if (heightBoundsValid && heightBoundsBakeCount == heightBakeCount) {
+            return;
+        }
+
+        recordImageBarrier(cmd, {heightImage}, VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+        recordPyramidBuild(cmd, heightBoundsPipeline, HEIGHT_BOUNDS_SIZE, HEIGHT_BOUNDS_LEVELS);
+
+        heightBoundsBakeCount = heightBakeCount;
+        heightBoundsValid = true;
+    }
+
+    // 후보 패치 → 보이는 패치 압축 + indirect instanceCount (render pass 밖)
+    void recordPatchCull(VkCommandBuffer cmd, const glm::mat4& viewProj, int32_t activeHeightSource) {
+        auto planes = extractFrustumPlanes(viewProj);
+
+        CullParams* params = cullParamsMapped[currentFrame];
+        params->hiZViewProj = hiZViewProj;
+        std::copy(planes.begin(), planes.end(), params->frustumPlanes);
+        params->candidateCount = visiblePatchCount;
+        params->heightScale = heightScale;
+        params->terrainSize = TERRAIN_SIZE;
+        params->heightBound = TERRAIN_HEIGHT_BOUND;
+        params->frustumCull = frustumCulling ? 1 : 0;
+        params->occlusionCull = (occlusionCulling && hiZValid) ? 1 : 0;
+        // DEM은 높이 범위가 heightMap과 다르므로 [0, 상한]
+        params->useHeightBounds = (heightBoundsValid && activeHeightSource == HEIGHT_SOURCE_PROCEDURAL) ? 1 : 0;
+
+        if (visiblePatchCount > 0) {
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, patchCullPipeline);
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout,
+                0, 1, &cullDescriptorSets[currentFrame], 0, nullptr);
+            vkCmdDispatch(cmd, (visiblePatchCount + PATCH_CULL_GROUP_SIZE - 1) / PATCH_CULL_GROUP_SIZE, 1, 1);
+        }
+
+        // 압축 결과 → vertex input, instanceCount → indirect 읽기 + 통계 복사
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
+                                VK_ACCESS_TRANSFER_READ_BIT;
+
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        VkBufferCopy region{};
+        region.srcOffset = offsetof(VkDrawIndirectCommand, instanceCount);
+        region.size = sizeof(uint32_t);
+        vkCmdCopyBuffer(cmd, indirectBuffers[currentFrame], cullReadbackBuffers[currentFrame], 1, &region);
+        cullReadbackIssued[currentFrame] = true;
+    }
+
+    // 이번 프레임 depth → Hi-Z (render pass 뒤), 다음 프레임 culling이 이 프레임 viewProj로 읽음
+    // Hi-Z 버퍼는 하나: 큐 제출 순서 + barrier로 이전 프레임 culling 읽기 뒤에 덮어씀
+    void recordHiZBuild(VkCommandBuffer cmd, const glm::mat4& viewProj) {
+        if (!gpuCulling || !occlusionCulling || !hiZSupported || terrainMode != TERRAIN_MODE_TESSELLATION) {
+            hiZValid = false;
+            return;
+        }
+
+        // depth 쓰기 → compute 샘플링, 이번 프레임 patch_cull.comp의 Hi-Z 읽기 → 덮어쓰기 (WAR)
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = depthImage;
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1};
+        barrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(cmd,
+            VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        recordPyramidBuild(cmd, hiZPipeline, HIZ_SIZE, HIZ_LEVELS);
+
+        hiZViewProj = viewProj;
+        hiZValid = true;
+    }
+
+    // fence 대기 후 호출 → 같은 슬롯의 이전 제출이 복사한 instanceCount
+    void readCullStatistics() {
+        if (cullReadbackIssued[currentFrame]) {
+            gpuVisiblePatchCount = *cullReadbackMapped[currentFrame];
+        }
+    }
+
+    // ========================================================================
+    // Heightfield (Compute Bake)
+    // ========================================================================
+    void createHeightfieldResources() {
+        createStorageImage(VK_FORMAT_R32_SFLOAT, HEIGHTMAP_SIZE, 1, staticHeightImage, staticHeightMemory);
+        createStorageImage(VK_FORMAT_R32_SFLOAT, HEIGHTMAP_SIZE, 1, heightImage, heightMemory);
+        createStorageImage(VK_FORMAT_R16G16B16A16_SFLOAT, HEIGHTMAP_SIZE, 1, normalImage, normalMemory);
+
+        staticHeightView = createImageView(staticHeightImage, VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT);
+        heightView = createImageView(heightImage, VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT);
+        normalView = createImageView(normalImage, VK_FORMAT_R16G16B16A16_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT);
+
+        // Clipmap 레벨 텍스처 (layer = 레벨)
+        createStorageImage(VK_FORMAT_R32_SFLOAT, CLIPMAP_TEXELS, CLIPMAP_LEVELS, clipmapHeightImage, clipmapHeightMemory);
+        clipmapHeightView = createLayeredImageView(clipmapHeightImage, VK_FORMAT_R32_SFLOAT,
+            VK_IMAGE_VIEW_TYPE_2D_ARRAY, CLIPMAP_LEVELS);
+
+        // height는 texelFetch로 직접 보간, normal만 linear filtering 사용
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.maxLod = 0.0f;
+
+        if (vkCreateSampler(device, &samplerInfo, nullptr, &terrainSampler) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create terrain sampler!");
+        }
+
+        // R32F height와 정수 포맷 DEM 텍스처는 linear filtering이 보장되지 않으므로 nearest
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        if (vkCreateSampler(device, &samplerInfo, nullptr, &nearestSampler) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create nearest sampler!");
+        }
+
+        std::cout << "Created heightfield: " << HEIGHTMAP_SIZE << "x" << HEIGHTMAP_SIZE << std::endl;
+    }
+
+    void createDescriptorSets() {
+        // Bake: storage image 4개 (static, height, normal, clipmap 레벨)
+        std::array<VkDescriptorSetLayoutBinding, 4> bakeBindings{};
+        for (uint32_t i = 0; i < bakeBindings.size(); i++) {
+            bakeBindings[i].binding = i;
+            bakeBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            bakeBindings[i].descriptorCount = 1;
+            bakeBindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo bakeLayoutInfo{};
+        bakeLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        bakeLayoutInfo.bindingCount = static_cast<uint32_t>(bakeBindings.size());
+        bakeLayoutInfo.pBindings = bakeBindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &bakeLayoutInfo, nullptr, &bakeDescriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create bake descriptor set layout!");
+        }
+
+        // Terrain: TES에서 height, normal, DEM page table, 타일 캐시, overview 샘플링
+        //          clipmap VS에서 레벨 텍스처 샘플링 (binding 5)
+        std::array<VkDescriptorSetLayoutBinding, 6> terrainBindings{};
+        for (uint32_t i = 0; i < terrainBindings.size(); i++) {
+            terrainBindings[i].binding = i;
+            terrainBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            terrainBindings[i].descriptorCount = 1;
+            terrainBindings[i].stageFlags = VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+        }
+        terrainBindings[5].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+        VkDescriptorSetLayoutCreateInfo terrainLayoutInfo{};
+        terrainLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        terrainLayoutInfo.bindingCount = static_cast<uint32_t>(terrainBindings.size());
+        terrainLayoutInfo.pBindings = terrainBindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &terrainLayoutInfo, nullptr, &terrainDescriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create terrain descriptor set layout!");
+        }
+
+        // GPU culling (프레임마다 1개): 0 CullParams, 1 후보, 2 압축 결과, 3 indirect 명령,
+        // 4 높이 범위, 5 Hi-Z, 6 heightMap (storage), 7 depth (sampler)
+        std::array<VkDescriptorSetLayoutBinding, 8> cullBindings{};
+        std::array<VkDescriptorType, 8> cullTypes = {
+            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+        };
+        for (uint32_t i = 0; i < cullBindings.size(); i++) {
+            cullBindings[i].binding = i;
+            cullBindings[i].descriptorType = cullTypes[i];
+            cullBindings[i].descriptorCount = 1;
+            cullBindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo cullLayoutInfo{};
+        cullLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        cullLayoutInfo.bindingCount = static_cast<uint32_t>(cullBindings.size());
+        cullLayoutInfo.pBindings = cullBindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &cullLayoutInfo, nullptr, &cullDescriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create cull descriptor set layout!");
+        }
+
+        // Erosion: storage image 6개 (state A/B, flux, velocity, thermal, heightMap)
+        std::array<VkDescriptorSetLayoutBinding, 6> erosionBindings{};
+        for (uint32_t i = 0; i < erosionBindings.size(); i++) {
+            erosionBindings[i].binding = i;
+            erosionBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            erosionBindings[i].descriptorCount = 1;
+            erosionBindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo erosionLayoutInfo{};
+        erosionLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        erosionLayoutInfo.bindingCount = static_cast<uint32_t>(erosionBindings.size());
+        erosionLayoutInfo.pBindings = erosionBindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &erosionLayoutInfo, nullptr, &erosionDescriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create erosion descriptor set layout!");
+        }
+
+        std::array<VkDescriptorPoolSize, 4> poolSizes = {{
+            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 4 + MAX_FRAMES_IN_FLIGHT + 2 * 6},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 6 + MAX_FRAMES_IN_FLIGHT},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_FRAMES_IN_FLIGHT},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5 * MAX_FRAMES_IN_FLIGHT}
+        }};
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = 2 + MAX_FRAMES_IN_FLIGHT + 2;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+
+        if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create descriptor pool!");
+        }
+
+        std::array<VkDescriptorSetLayout, 2> layouts = {bakeDescriptorSetLayout, terrainDescriptorSetLayout};
+        std::array<VkDescriptorSet, 2> sets{};
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+        allocInfo.pSetLayouts = layouts.data();
+
+        if (vkAllocateDescriptorSets(device, &allocInfo, sets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate descriptor sets!");
+        }
+        bakeDescriptorSet = sets[0];
+        terrainDescriptorSet = sets[1];
+
+        std::array<VkDescriptorImageInfo, 4> storageInfos{};
+        storageInfos[0] = {VK_NULL_HANDLE, staticHeightView, VK_IMAGE_LAYOUT_GENERAL};
+        storageInfos[1] = {VK_NULL_HANDLE, heightView, VK_IMAGE_LAYOUT_GENERAL};
+        storageInfos[2] = {VK_NULL_HANDLE, normalView, VK_IMAGE_LAYOUT_GENERAL};
+        storageInfos[3] = {VK_NULL_HANDLE, clipmapHeightView, VK_IMAGE_LAYOUT_GENERAL};
+
+        std::array<VkDescriptorImageInfo, 6> sampledInfos{};
+        sampledInfos[0] = {nearestSampler, heightView, VK_IMAGE_LAYOUT_GENERAL};
+        sampledInfos[1] = {terrainSampler, normalView, VK_IMAGE_LAYOUT_GENERAL};
+        sampledInfos[2] = {nearestSampler, pageTableView, VK_IMAGE_LAYOUT_GENERAL};
+        sampledInfos[3] = {nearestSampler, tileCacheView, VK_IMAGE_LAYOUT_GENERAL};
+        sampledInfos[4] = {nearestSampler, overviewView, VK_IMAGE_LAYOUT_GENERAL};
+        sampledInfos[5] = {nearestSampler, clipmapHeightView, VK_IMAGE_LAYOUT_GENERAL};
+
+        std::array<VkWriteDescriptorSet, 2> writes{};
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = bakeDescriptorSet;
+        writes[0].dstBinding = 0;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[0].descriptorCount = static_cast<uint32_t>(storageInfos.size());
+        writes[0].pImageInfo = storageInfos.data();
+
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = terrainDescriptorSet;
+        writes[1].dstBinding = 0;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[1].descriptorCount = static_cast<uint32_t>(sampledInfos.size());
+        writes[1].pImageInfo = sampledInfos.data();
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+        std::vector<VkDescriptorSetLayout> cullLayouts(MAX_FRAMES_IN_FLIGHT, cullDescriptorSetLayout);
+        cullDescriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
+
+        VkDescriptorSetAllocateInfo cullAllocInfo{};
+        cullAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        cullAllocInfo.descriptorPool = descriptorPool;
+        cullAllocInfo.descriptorSetCount = MAX_FRAMES_IN_FLIGHT;
+        cullAllocInfo.pSetLayouts = cullLayouts.data();
+
+        if (vkAllocateDescriptorSets(device, &cullAllocInfo, cullDescriptorSets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate cull descriptor sets!");
+        }
+
+        // depth를 샘플링할 수 없으면 binding 7은 자리만 채움 (Hi-Z 생성을 건너뜀)
+        VkDescriptorImageInfo heightStorageInfo{VK_NULL_HANDLE, heightView, VK_IMAGE_LAYOUT_GENERAL};
+        VkDescriptorImageInfo depthInfo = hiZSupported
+            ? VkDescriptorImageInfo{nearestSampler, depthImageView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL}
+            : VkDescriptorImageInfo{nearestSampler, heightView, VK_IMAGE_LAYOUT_GENERAL};
+
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            std::array<VkDescriptorBufferInfo, 6> bufferInfos = {{
+                {cullParamBuffers[i], 0, sizeof(CullParams)},
+                {instanceBuffers[i], 0, VK_WHOLE_SIZE},
+                {culledInstanceBuffers[i], 0, VK_WHOLE_SIZE},
+                {indirectBuffers[i], 0, VK_WHOLE_SIZE},
+                {heightBoundsBuffer, 0, VK_WHOLE_SIZE},
+                {hiZBuffer, 0, VK_WHOLE_SIZE}
+            }};
+
+            std::array<VkWriteDescriptorSet, 4> cullWrites{};
+            cullWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            cullWrites[0].dstSet = cullDescriptorSets[i];
+            cullWrites[0].dstBinding = 0;
+            cullWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            cullWrites[0].descriptorCount = 1;
+            cullWrites[0].pBufferInfo = &bufferInfos[0];
+
+            cullWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            cullWrites[1].dstSet = cullDescriptorSets[i];
+            cullWrites[1].dstBinding = 1;
+            cullWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            cullWrites[1].descriptorCount = 5;
+            cullWrites[1].pBufferInfo = &bufferInfos[1];
+
+            cullWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            cullWrites[2].dstSet = cullDescriptorSets[i];
+            cullWrites[2].dstBinding = 6;
+            cullWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            cullWrites[2].descriptorCount = 1;
+            cullWrites[2].pImageInfo = &heightStorageInfo;
+
+            cullWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            cullWrites[3].dstSet = cullDescriptorSets[i];
+            cullWrites[3].dstBinding = 7;
+            cullWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            cullWrites[3].descriptorCount = 1;
+            cullWrites[3].pImageInfo = &depthInfo;
+
+            vkUpdateDescriptorSets(device, static_cast<uint32_t>(cullWrites.size()), cullWrites.data(), 0, nullptr);
+        }
+
+        std::array<VkDescriptorSetLayout, 2> erosionLayouts = {erosionDescriptorSetLayout, erosionDescriptorSetLayout};
+
+        VkDescriptorSetAllocateInfo erosionAllocInfo{};
+        erosionAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        erosionAllocInfo.descriptorPool = descriptorPool;
+        erosionAllocInfo.descriptorSetCount = static_cast<uint32_t>(erosionLayouts.size());
+        erosionAllocInfo.pSetLayouts = erosionLayouts.data();
+
+        if (vkAllocateDescriptorSets(device, &erosionAllocInfo, erosionDescriptorSets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate erosion descriptor sets!");
+        }
+
+        for (uint32_t k = 0; k < 2; k++) {
+            std::array<VkDescriptorImageInfo, 6> erosionInfos{};
+            erosionInfos[0] = {VK_NULL_HANDLE, erosionStateViews[k], VK_IMAGE_LAYOUT_GENERAL};
+            erosionInfos[1] = {VK_NULL_HANDLE, erosionStateViews[1 - k], VK_IMAGE_LAYOUT_GENERAL};
+            erosionInfos[2] = {VK_NULL_HANDLE, erosionFluxView, VK_IMAGE_LAYOUT_GENERAL};
+            erosionInfos[3] = {VK_NULL_HANDLE, erosionVelocityView, VK_IMAGE_LAYOUT_GENERAL};
+            erosionInfos[4] = {VK_NULL_HANDLE, erosionThermalView, VK_IMAGE_LAYOUT_GENERAL};
+            erosionInfos[5] = {VK_NULL_HANDLE, heightView, VK_IMAGE_LAYOUT_GENERAL};
+
+            VkWriteDescriptorSet erosionWrite{};
+            erosionWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            erosionWrite.dstSet = erosionDescriptorSets[k];
+            erosionWrite.dstBinding = 0;
+            erosionWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            erosionWrite.descriptorCount = static_cast<uint32_t>(erosionInfos.size());
+            erosionWrite.pImageInfo = erosionInfos.data();
+
+            vkUpdateDescriptorSets(device, 1, &erosionWrite, 0, nullptr);
+        }
+    }
+
+    void createBakePipeline() {
+        auto compCode = readFile("shaders/terrain_bake_comp.spv");
+        VkShaderModule compModule = createShaderModule(compCode);
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(BakePushConstants);
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &bakeDescriptorSetLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &bakePipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create bake pipeline layout!");
+        }
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = compModule;
+        pipelineInfo.stage.pName = "main";
+        pipelineInfo.layout = bakePipelineLayout;
+
+        if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &bakePipeline) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create bake pipeline!");
+        }
+
+        vkDestroyShaderModule(device, compModule, nullptr);
+    }
+
+    void recordBakePass(VkCommandBuffer cmd, BakeMode mode, float time) {
+        BakePushConstants pc{};
+        pc.mode = mode;
+        pc.time = time;
+        pc.heightScale = heightScale;
+        pc.terrainSize = TERRAIN_SIZE;
+        pc.texelSpacing = HEIGHTMAP_TEXEL_SPACING;
+
+        vkCmdPushConstants(cmd, bakePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pc), &pc);
+
+        uint32_t groups = (HEIGHTMAP_SIZE + 15) / 16;
+        vkCmdDispatch(cmd, groups, groups, 1);
+    }
+
+    void recordImageBarrier(VkCommandBuffer cmd, const std::vector<VkImage>& images,
+                            VkImageLayout oldLayout,
+                            VkPipelineStageFlags srcStage, VkAccessFlags srcAccess,
+                            VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+        std::vector<VkImageMemoryBarrier> barriers;
+        for (VkImage image : images) {
+            VkImageMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout = oldLayout;
+            barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = image;
+            barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, VK_REMAINING_ARRAY_LAYERS};
+            barrier.srcAccessMask = srcAccess;
+            barrier.dstAccessMask = dstAccess;
+            barriers.push_back(barrier);
+        }
+
+        vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0, 0, nullptr, 0, nullptr,
+            static_cast<uint32_t>(barriers.size()), barriers.data());
+    }
+
+    // 파라미터가 바뀐 레이어만 다시 구움
+    // - 정적 레이어: 최초 1회
+    // - height: 애니메이션 time이 바뀌었고 마지막 bake 이후 1/bakeRate 초가 지났을 때
+    // - normal: height가 갱신됐거나 heightScale이 바뀌었을 때
+    void recordHeightfieldBake(VkCommandBuffer cmd, float time) {
+        bool bakeHeight = !heightfieldInitialized ||
+            (time != bakedTime && time - bakedTime >= 1.0f / bakeRate);
+        bool bakeNormal = bakeHeight || heightScale != bakedHeightScale;
+        if (!bakeNormal) {
+            return;
+        }
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, bakePipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, bakePipelineLayout,
+            0, 1, &bakeDescriptorSet, 0, nullptr);
+
+        if (!heightfieldInitialized) {
+            recordImageBarrier(cmd, {staticHeightImage, heightImage, normalImage}, VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+            recordBakePass(cmd, BAKE_STATIC_LAYER, time);
+
+            recordImageBarrier(cmd, {staticHeightImage}, VK_IMAGE_LAYOUT_GENERAL,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+            heightfieldInitialized = true;
+        } else {
+            // 이전 프레임(다른 in-flight 프레임 포함)의 TES / 높이 범위 빌드 읽기가 끝난 뒤에 덮어씀 (WAR)
+            recordImageBarrier(cmd, {heightImage, normalImage}, VK_IMAGE_LAYOUT_GENERAL,
+                terrainReadStage | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+        }
+
+        if (bakeHeight) {
+            recordBakePass(cmd, BAKE_HEIGHT, time);
+            recordImageBarrier(cmd, {heightImage}, VK_IMAGE_LAYOUT_GENERAL,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+            bakedTime = time;
+            heightBakeCount++;
+        }
+
+        recordBakePass(cmd, BAKE_NORMAL, time);
+        bakedHeightScale = heightScale;
+        normalBakeCount++;
+
+        recordImageBarrier(cmd, {heightImage, normalImage}, VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            terrainReadStage, VK_ACCESS_SHADER_READ_BIT);
+    }
+
+    // ========================================================================
+    // Erosion Simulation
+    // ========================================================================
+    void createErosionResources() {
+        for (uint32_t k = 0; k < 2; k++) {
+            createStorageImage(VK_FORMAT_R32G32B32A32_SFLOAT, HEIGHTMAP_SIZE, 1,
+                erosionStateImages[k], erosionStateMemory[k]);
+            erosionStateViews[k] = createImageView(erosionStateImages[k], VK_FORMAT_R32G32B32A32_SFLOAT,
+                VK_IMAGE_ASPECT_COLOR_BIT);
+        }
+        createStorageImage(VK_FORMAT_R32G32B32A32_SFLOAT, HEIGHTMAP_SIZE, 1, erosionFluxImage, erosionFluxMemory);
+        createStorageImage(VK_FORMAT_R32G32_SFLOAT, HEIGHTMAP_SIZE, 1, erosionVelocityImage, erosionVelocityMemory);
+        createStorageImage(VK_FORMAT_R32G32B32A32_SFLOAT, HEIGHTMAP_SIZE, 1, erosionThermalImage, erosionThermalMemory);
+
+        erosionFluxView = createImageView(erosionFluxImage, VK_FORMAT_R32G32B32A32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT);
+        erosionVelocityView = createImageView(erosionVelocityImage, VK_FORMAT_R32G32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT);
+        erosionThermalView = createImageView(erosionThermalImage, VK_FORMAT_R32G32B32A32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT);
+    }
+
+    void createErosionPipeline() {
+        auto compCode = readFile("shaders/erosion_comp.spv");
+        VkShaderModule compModule = createShaderModule(compCode);
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(ErosionPushConstants);
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &erosionDescriptorSetLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &erosionPipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create erosion pipeline layout!");
+        }
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = compModule;
+        pipelineInfo.stage.pName = "main";
+        pipelineInfo.layout = erosionPipelineLayout;
+
+        if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &erosionPipeline) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create erosion pipeline!");
+        }
+
+        vkDestroyShaderModule(device, compModule, nullptr);
+    }
+
+    // erosionPipeline과 descriptor set은 호출하는 쪽에서 바인딩
+    void recordErosionPass(VkCommandBuffer cmd, ErosionMode mode) {
+        ErosionPushConstants pc{};
+        pc.mode = mode;
+        pc.timeStep = erosionTimeStep;
+        pc.texelSpacing = HEIGHTMAP_TEXEL_SPACING;
+        pc.heightScale = heightScale;
+        pc.rainRate = rainRate;
+        pc.sedimentCapacity = sedimentCapacity;
+        pc.dissolveRate = dissolveRate;
+        pc.depositionRate = depositionRate;
+        pc.evaporationRate = evaporationRate;
+        pc.talusTangent = talusTangent;
+        pc.thermalRate = thermalRate;
+
+        vkCmdPushConstants(cmd, erosionPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pc), &pc);
+
+        uint32_t groups = (HEIGHTMAP_SIZE + 15) / 16;
+        vkCmdDispatch(cmd, groups, groups, 1);
+    }
+
+    void bindErosionState(VkCommandBuffer cmd) {
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, erosionPipelineLayout,
+            0, 1, &erosionDescriptorSets[erosionCurrent], 0, nullptr);
+    }
+
+    // 현재 heightMap (구운 직후)에서 물/퇴적물이 없는 상태로 시작
+    void recordErosionInit(VkCommandBuffer cmd) {
+        // 이전 내용은 버림 (다른 in-flight 프레임의 erosion pass가 끝난 뒤, WAR)
+        recordImageBarrier(cmd,
+            {erosionStateImages[0], erosionStateImages[1], erosionFluxImage, erosionVelocityImage, erosionThermalImage},
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+        recordImageBarrier(cmd, {heightImage}, VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+        erosionCurrent = 0;
+        erosionIterations = 0;
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, erosionPipeline);
+        bindErosionState(cmd);
+        recordErosionPass(cmd, EROSION_INIT);
+        recordComputeBarrier(cmd);
+        erosionInitialized = true;
+    }
+
+    // 반복마다 4 pass, 각 pass는 이전 pass의 결과 전체(이웃 포함)를 읽으므로 사이마다 barrier
+    // 반복이 끝나면 결과가 stateB에 있으므로 다음 반복은 반대쪽 descriptor set 사용
+    void recordErosionIterations(VkCommandBuffer cmd, uint32_t count) {
+        // 이전 제출의 erosion / write back 읽기 → 덮어쓰기
+        recordComputeBarrier(cmd);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, erosionPipeline);
+
+        for (uint32_t i = 0; i < count; i++) {
+            bindErosionState(cmd);
+            recordErosionPass(cmd, EROSION_FLUX);
+            recordComputeBarrier(cmd);
+            recordErosionPass(cmd, EROSION_WATER);
+            recordComputeBarrier(cmd);
+            recordErosionPass(cmd, EROSION_TRANSPORT);
+            recordComputeBarrier(cmd);
+            recordErosionPass(cmd, EROSION_THERMAL);
+            recordComputeBarrier(cmd);
+
+            erosionCurrent ^= 1;
+            erosionIterations++;
+        }
+    }
+
+    // 시뮬레이션 지형 → heightMap, normal 다시 계산 (terrain_bake.comp mode 2)
+    // heightBakeCount가 바뀌므로 clipmap 레벨과 높이 범위 pyramid도 다시 만들어짐
+    void recordErosionWriteBack(VkCommandBuffer cmd) {
+        recordImageBarrier(cmd, {heightImage, normalImage}, VK_IMAGE_LAYOUT_GENERAL,
+            terrainReadStage | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, erosionPipeline);
+        bindErosionState(cmd);
+        recordErosionPass(cmd, EROSION_WRITE_BACK);
+
+        recordImageBarrier(cmd, {heightImage}, VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, bakePipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, bakePipelineLayout,
+            0, 1, &bakeDescriptorSet, 0, nullptr);
+        recordBakePass(cmd, BAKE_NORMAL, bakedTime);
+
+        recordImageBarrier(cmd, {heightImage, normalImage}, VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            terrainReadStage, VK_ACCESS_SHADER_READ_BIT);
+
+        bakedHeightScale = heightScale;
+        heightBakeCount++;
+        normalBakeCount++;
+    }
+
+    // 프레임마다 몇 반복씩 진행 (멈춰 있으면 heightScale이 바뀔 때만 normal 갱신)
+    void recordErosion(VkCommandBuffer cmd) {
+        if (!erosionInitialized) {
+            recordErosionInit(cmd);
+        }
+
+        uint32_t count = erosionRunning ? static_cast<uint32_t>(erosionIterationsPerFrame) : 0;
+        if (count == 0 && heightScale == bakedHeightScale) {
+            return;
+        }
+
+        if (count > 0) {
+            if (timestampQueryPool != VK_NULL_HANDLE) {
+                vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampQueryPool, currentFrame * 4 + 2);
+            }
+            recordErosionIterations(cmd, count);
+            if (timestampQueryPool != VK_NULL_HANDLE) {
+                vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampQueryPool, currentFrame * 4 + 3);
+                erosionTimestampIterations[currentFrame] = count;
+            }
+        }
+        recordErosionWriteBack(cmd);
+    }
+
+    std::vector<float> readBackHeightfield() {
+        const size_t texelCount = size_t(HEIGHTMAP_SIZE) * HEIGHTMAP_SIZE;
+        VkDeviceSize bytes = sizeof(float) * texelCount;
+
+        VkBuffer readback;
+        VkDeviceMemory readbackMemory;
+        createBuffer(bytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     readback, readbackMemory);
+
+        VkCommandBuffer cmd = beginSingleTimeCommands();
+        recordImageBarrier(cmd, {heightImage}, VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+        VkBufferImageCopy region{};
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {HEIGHTMAP_SIZE, HEIGHTMAP_SIZE, 1};
+        vkCmdCopyImageToBuffer(cmd, heightImage, VK_IMAGE_LAYOUT_GENERAL, readback, 1, &region);
+        endSingleTimeCommands(cmd);
+
+        std::vector<float> heights(texelCount);
+        void* data;
+        vkMapMemory(device, readbackMemory, 0, bytes, 0, &data);
+        std::memcpy(heights.data(), data, bytes);
+        vkUnmapMemory(device, readbackMemory);
+
+        vkDestroyBuffer(device, readback, nullptr);
+        vkFreeMemory(device, readbackMemory, nullptr);
+        return heights;
+    }
+
+    // --erode: time 0 지형에서 시작해 EROSION_BATCH_CHUNK 반복씩 제출
+    // 처리량은 타임스탬프가 있으면 GPU 시간, 없으면 제출/대기를 포함한 wall clock 기준
+    bool erodeHeightfield(uint32_t iterations, const std::string& outputPath) {
+        const size_t texelCount = size_t(HEIGHTMAP_SIZE) * HEIGHTMAP_SIZE;
+
+        VkCommandBuffer cmd = beginSingleTimeCommands();
+        recordHeightfieldBake(cmd, 0.0f);
+        recordErosionInit(cmd);
+        endSingleTimeCommands(cmd);
+        std::vector<float> before = readBackHeightfield();
+
+        std::cout << "Eroding " << HEIGHTMAP_SIZE << "x" << HEIGHTMAP_SIZE << " heightfield, "
+                  << iterations << " iterations..." << std::endl;
+
+        double gpuMs = 0.0;
+        auto wallStart = std::chrono::high_resolution_clock::now();
+        for (uint32_t done = 0; done < iterations;) {
+            uint32_t count = std::min(EROSION_BATCH_CHUNK, iterations - done);
+
+            cmd = beginSingleTimeCommands();
+            if (timestampQueryPool != VK_NULL_HANDLE) {
+                vkCmdResetQueryPool(cmd, timestampQueryPool, 0, 2);
+                vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampQueryPool, 0);
+            }
+            recordErosionIterations(cmd, count);
+            if (timestampQueryPool != VK_NULL_HANDLE) {
+                vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampQueryPool, 1);
+            }
+            endSingleTimeCommands(cmd);
+
+            if (timestampQueryPool != VK_NULL_HANDLE) {
+                uint64_t ticks[2];
+                VkResult result = vkGetQueryPoolResults(device, timestampQueryPool, 0, 2,
+                    sizeof(ticks), ticks, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+                if (result == VK_SUCCESS) {
+                    gpuMs += static_cast<double>(ticks[1] - ticks[0]) * timestampPeriod * 1e-6;
+                }
+            }
+            done += count;
+        }
+        double wallMs = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - wallStart).count();
+
+        cmd = beginSingleTimeCommands();
+        recordErosionWriteBack(cmd);
+        endSingleTimeCommands(cmd);
+        std::vector<float> after = readBackHeightfield();
+
+        // 지형 부피 변화 = 아직 물에 떠 있는 퇴적물 (경계는 벽이라 밖으로 빠져나가지 않음)
+        double volumeBefore = 0.0;
+        double volumeAfter = 0.0;
+        double totalChange = 0.0;
+        float maxErosion = 0.0f;
+        float maxDeposition = 0.0f;
+        for (size_t i = 0; i < texelCount; i++) {
+            float delta = after[i] - before[i];
+            volumeBefore += before[i];
+            volumeAfter += after[i];
+            totalChange += std::abs(delta);
+            maxErosion = std::max(maxErosion, -delta);
+            maxDeposition = std::max(maxDeposition, delta);
+        }
+
+        bool gpuTimed = timestampQueryPool != VK_NULL_HANDLE;
+        double ms = gpuTimed ? gpuMs : wallMs;
+        double msPerIteration = iterations > 0 ? ms / iterations : 0.0;
+        double texelIterations = double(texelCount) * iterations;
+        double seconds = std::max(ms, 1e-6) * 1e-3;
+
+        std::cout << "Erosion: " << iterations << " iterations in " << ms << " ms ("
+                  << (gpuTimed ? "GPU timestamps" : "wall clock") << "), " << msPerIteration << " ms/iteration, "
+                  << texelIterations / seconds * 1e-6 << " Mtexel-iterations/s, ~"
+                  << texelIterations * EROSION_BYTES_PER_TEXEL / seconds * 1e-9 << " GB/s (estimated)" << std::endl;
+        std::cout << "Terrain: volume change " << (volumeAfter - volumeBefore) / volumeBefore * 100.0
+                  << "% (sediment in suspension), mean |change| " << totalChange / texelCount
+                  << ", max erosion " << maxErosion << ", max deposition " << maxDeposition
+                  << " (heightMap units)" << std::endl;
+
+        if (!outputPath.empty()) {
+            return writeErodedTileFile(after, outputPath);
+        }
+        return true;
+    }
+
+    // HEIGHTMAP_SIZE 텍셀 → ERODED_DEM_SIZE 샘플 bilinear 재표본 (둘 다 지형 코너가 끝 샘플)
+    // 타일 파일은 tiles * cells + 1 크기여야 하므로 2048을 그대로 저장할 수 없음
+    bool writeErodedTileFile(const std::vector<float>& heights, const std::string& path) {
+        std::vector<uint16_t> samples(size_t(ERODED_DEM_SIZE) * ERODED_DEM_SIZE);
+        float scale = float(HEIGHTMAP_SIZE - 1) / float(ERODED_DEM_SIZE - 1);
+
+        for (uint32_t y = 0; y < ERODED_DEM_SIZE; y++) {
+            float v = y * scale;
+            uint32_t y0 = std::min(static_cast<uint32_t>(v), HEIGHTMAP_SIZE - 2);
+            float fy = v - y0;
+            for (uint32_t x = 0; x < ERODED_DEM_SIZE; x++) {
+                float u = x * scale;
+                uint32_t x0 = std::min(static_cast<uint32_t>(u), HEIGHTMAP_SIZE - 2);
+                float fx = u - x0;
+
+                const float* row0 = &heights[size_t(y0) * HEIGHTMAP_SIZE + x0];
+                const float* row1 = row0 + HEIGHTMAP_SIZE;
+                float h = (row0[0] * (1.0f - fx) + row0[1] * fx) * (1.0f - fy) +
+                          (row1[0] * (1.0f - fx) + row1[1] * fx) * fy;
+
+                // generateTileFile과 같은 정규화
+                h /= TERRAIN_HEIGHT_BOUND;
+                samples[size_t(y) * ERODED_DEM_SIZE + x] =
+                    static_cast<uint16_t>(std::clamp(h, 0.0f, 1.0f) * 65535.0f + 0.5f);
+            }
+        }
+
+        std::string error;
+        if (!terrain::writeHeightTileFile(path, samples, ERODED_DEM_SIZE, ERODED_DEM_SIZE,
+                                          ERODED_DEM_TILE_CELLS, 257, error)) {
+            std::cerr << "Failed to write " << path << ": " << error << std::endl;
+            return false;
+        }
+        std::cout << "Wrote " << path << " (" << ERODED_DEM_SIZE << "x" << ERODED_DEM_SIZE << ")" << std::endl;
+        return true;
+    }
+
+    // ========================================================================
+    // DEM Tile Streaming
+    // ========================================================================
+    void createTileStreamingResources() {
+        if (tileFile.open(tileFilePath)) {
+            const auto& header = tileFile.header();
+            tilesAvailable = true;
+            tilesX = header.tilesX;
+            tilesY = header.tilesY;
+            tileSamples = tileFile.tileSamples();
+            overviewSize = header.overviewSize;
+            std::cout << "Loaded tile file " << tileFilePath << ": " << tilesX << "x" << tilesY
+                      << " tiles, " << header.tileCells << " cells/tile" << std::endl;
+        } else {
+            std::cout << "No DEM tiles (" << tileFile.error() << ") - streaming disabled" << std::endl;
+        }
+
+        // 타일 캐시 (texture array), page table, overview - 모두 R16_UINT + texelFetch
+        createTileImage(tileSamples, tileSamples, TILE_CACHE_LAYERS, tileCacheImage, tileCacheMemory);
+        createTileImage(tilesX, tilesY, 1, pageTableImage, pageTableMemory);
+        createTileImage(overviewSize, overviewSize, 1, overviewImage, overviewMemory);
+
+        tileCacheView = createLayeredImageView(tileCacheImage, VK_FORMAT_R16_UINT,
+            VK_IMAGE_VIEW_TYPE_2D_ARRAY, TILE_CACHE_LAYERS);
+        pageTableView = createLayeredImageView(pageTableImage, VK_FORMAT_R16_UINT, VK_IMAGE_VIEW_TYPE_2D, 1);
+        overviewView = createLayeredImageView(overviewImage, VK_FORMAT_R16_UINT, VK_IMAGE_VIEW_TYPE_2D, 1);
+
+        tileCacheSlots.assign(TILE_CACHE_LAYERS, TileCacheSlot{});
+        tileResidentSlot.assign(tilesX * tilesY, -1);
+        pageTableData.assign(tilesX * tilesY, 0);
+
+        // copy의 bufferOffset 정렬을 위해 16바이트 단위로 배치
+        auto align16 = [](VkDeviceSize size) { return (size + 15) & ~VkDeviceSize(15); };
+        VkDeviceSize pageTableBytes = VkDeviceSize(tilesX) * tilesY * sizeof(uint16_t);
+        VkDeviceSize overviewBytes = VkDeviceSize(overviewSize) * overviewSize * sizeof(uint16_t);
+        stagingOverviewOffset = align16(pageTableBytes);
+        stagingTilesOffset = stagingOverviewOffset + align16(overviewBytes);
+        stagingTileStride = align16(VkDeviceSize(tileSamples) * tileSamples * sizeof(uint16_t));
+        VkDeviceSize stagingSize = stagingTilesOffset + stagingTileStride * MAX_TILE_UPLOADS_PER_FRAME;
+
+        tileStagingBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        tileStagingMemory.resize(MAX_FRAMES_IN_FLIGHT);
+        tileStagingMapped.resize(MAX_FRAMES_IN_FLIGHT);
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            createBuffer(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         tileStagingBuffers[i], tileStagingMemory[i]);
+            vkMapMemory(device, tileStagingMemory[i], 0, stagingSize, 0,
+                        reinterpret_cast<void**>(&tileStagingMapped[i]));
+        }
+
+        if (tilesAvailable) {
+            tileStreamer.start(&tileFile);
+        }
+    }
+
+    // 카메라 타일 주변 정사각형 영역을 상주 목표로, 한 링 바깥은 prefetch
+    // 우선순위: 상주 영역 > prefetch 링, 그 안에서 frustum 안 > 밖, 가까운 순
+    void updateTileRequests(const glm::mat4& viewProj) {
+        if (!tilesAvailable || heightSource != HEIGHT_SOURCE_STREAMED) {
+            return;
+        }
+
+        float tileWorldX = TERRAIN_SIZE / tilesX;
+        float tileWorldZ = TERRAIN_SIZE / tilesY;
+        float rootMin = -TERRAIN_SIZE * 0.5f;
+        int camX = std::clamp(static_cast<int>(std::floor((cameraPos.x - rootMin) / tileWorldX)), 0, int(tilesX) - 1);
+        int camZ = std::clamp(static_cast<int>(std::floor((cameraPos.z - rootMin) / tileWorldZ)), 0, int(tilesY) - 1);
+
+        auto planes = extractFrustumPlanes(viewProj);
+        float maxY = heightScale * TERRAIN_HEIGHT_BOUND;
+        int prefetchRadius = tileStreamRadius + 1;
+
+        struct Candidate {
+            uint32_t tile;
+            int priority;
+            float distance;
+        };
+        std::vector<Candidate> candidates;
+
+        for (int z = camZ - prefetchRadius; z <= camZ + prefetchRadius; z++) {
+            for (int x = camX - prefetchRadius; x <= camX + prefetchRadius; x++) {
+                if (x < 0 || z < 0 || x >= int(tilesX) || z >= int(tilesY)) {
+                    continue;
+                }
+
+                glm::vec3 boxMin(rootMin + x * tileWorldX, 0.0f, rootMin + z * tileWorldZ);
+                glm::vec3 boxMax(boxMin.x + tileWorldX, maxY, boxMin.z + tileWorldZ);
+                glm::vec3 closest = glm::clamp(cameraPos, boxMin, boxMax);
+
+                int ring = std::max(std::abs(x - camX), std::abs(z - camZ));
+                bool visible = intersectsFrustum(planes, boxMin, boxMax);
+                int priority = (ring > tileStreamRadius ? 2 : 0) + (visible ? 0 : 1);
+
+                candidates.push_back({uint32_t(z) * tilesX + uint32_t(x), priority, glm::length(cameraPos - closest)});
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.priority != b.priority ? a.priority < b.priority : a.distance < b.distance;
+        });
+
+        tileRequestScratch.clear();
+        for (const Candidate& c : candidates) {
+            int32_t slot = tileResidentSlot[c.tile];
+            if (slot >= 0) {
+                tileCacheSlots[slot].lastUsedFrame = streamFrameIndex;
+            } else {
+                tileRequestScratch.push_back(c.tile);
+            }
+        }
+
+        // 목록을 통째로 교체 → 카메라가 지나간 뒤의 오래된 요청은 버려짐
+        tileStreamer.requestTiles(tileRequestScratch);
+    }
+
+    // 빈 slot, 없으면 이번 프레임에 쓰지 않은 가장 오래된 slot (-1 = 모두 사용 중)
+    int32_t acquireTileSlot() {
+        int32_t best = -1;
+        for (uint32_t i = 0; i < tileCacheSlots.size(); i++) {
+            const TileCacheSlot& slot = tileCacheSlots[i];
+            if (slot.tile < 0) {
+                return static_cast<int32_t>(i);
+            }
+            if (slot.lastUsedFrame < streamFrameIndex &&
+                (best < 0 || slot.lastUsedFrame < tileCacheSlots[best].lastUsedFrame)) {
+                best = static_cast<int32_t>(i);
+            }
+        }
+        return best;
+    }
+
+    // 워커가 읽어 둔 타일을 staging → 캐시 layer로 복사하고 page table 갱신
+    // (렌더 스레드는 매핑된 파일을 건드리지 않으므로 디스크 I/O로 막히지 않음)
+    void recordTileStreaming(VkCommandBuffer cmd) {
+        std::vector<VkImage> tileImages = {tileCacheImage, pageTableImage, overviewImage};
+        uint8_t* staging = tileStagingMapped[currentFrame];
+        std::vector<VkBufferImageCopy> tileCopies;
+        bool uploadOverview = false;
+
+        if (!tileResourcesInitialized) {
+            recordImageBarrier(cmd, tileImages, VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+            // 상주하지 않은 layer도 정의된 값을 갖도록 0으로 채움
+            VkClearColorValue zero{};
+            VkImageSubresourceRange range = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, TILE_CACHE_LAYERS};
+            vkCmdClearColorImage(cmd, tileCacheImage, VK_IMAGE_LAYOUT_GENERAL, &zero, 1, &range);
+            recordImageBarrier(cmd, {tileCacheImage}, VK_IMAGE_LAYOUT_GENERAL,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+            size_t overviewBytes = size_t(overviewSize) * overviewSize * sizeof(uint16_t);
+            if (tilesAvailable) {
+                memcpy(staging + stagingOverviewOffset, tileFile.overviewData(), overviewBytes);
+            } else {
+                memset(staging + stagingOverviewOffset, 0, overviewBytes);
+            }
+            uploadOverview = true;
+            pageTableDirty = true;
+            tileResourcesInitialized = true;
+        }
+
+        terrain::LoadedTile tile;
+        size_t tileBytes = size_t(tileSamples) * tileSamples * sizeof(uint16_t);
+        while (tileCopies.size() < MAX_TILE_UPLOADS_PER_FRAME && tileStreamer.popLoaded(tile)) {
+            if (tileResidentSlot[tile.tileIndex] >= 0) {
+                continue;
+            }
+            int32_t slot = acquireTileSlot();
+            if (slot < 0) {
+                continue;  // 캐시 전체가 이번 프레임에 사용 중 → 다음 요청 때 다시 읽음
+            }
+
+            // LRU 축출
+            TileCacheSlot& cacheSlot = tileCacheSlots[slot];
+            if (cacheSlot.tile >= 0) {
+                tileResidentSlot[cacheSlot.tile] = -1;
+                pageTableData[cacheSlot.tile] = 0;
+                residentTileCount--;
+            }
+            cacheSlot.tile = static_cast<int32_t>(tile.tileIndex);
+            cacheSlot.lastUsedFrame = streamFrameIndex;
+            tileResidentSlot[tile.tileIndex] = slot;
+            pageTableData[tile.tileIndex] = static_cast<uint16_t>(slot + 1);
+            residentTileCount++;
+            pageTableDirty = true;
+
+            VkDeviceSize offset = stagingTilesOffset + stagingTileStride * tileCopies.size();
+            memcpy(staging + offset, tile.samples.data(), tileBytes);
+
+            VkBufferImageCopy region{};
+            region.bufferOffset = offset;
+            region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, static_cast<uint32_t>(slot), 1};
+            region.imageExtent = {tileSamples, tileSamples, 1};
+            tileCopies.push_back(region);
+        }
+        tileUploadsLastFrame = static_cast<uint32_t>(tileCopies.size());
+        streamFrameIndex++;
+
+        if (!uploadOverview && !pageTableDirty && tileCopies.empty()) {
+            return;
+        }
+
+        // 이전 프레임(다른 in-flight 프레임 포함)의 TES 읽기가 끝난 뒤에 덮어씀 (WAR)
+        if (!uploadOverview) {
+            recordImageBarrier(cmd, tileImages, VK_IMAGE_LAYOUT_GENERAL,
+                terrainReadStage, VK_ACCESS_SHADER_READ_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+        }
+
+        if (!tileCopies.empty()) {
+            vkCmdCopyBufferToImage(cmd, tileStagingBuffers[currentFrame], tileCacheImage,
+                VK_IMAGE_LAYOUT_GENERAL, static_cast<uint32_t>(tileCopies.size()), tileCopies.data());
+        }
+
+        if (pageTableDirty) {
+            memcpy(staging, pageTableData.data(), pageTableData.size() * sizeof(uint16_t));
+
+            VkBufferImageCopy region{};
+            region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            region.imageExtent = {tilesX, tilesY, 1};
+            vkCmdCopyBufferToImage(cmd, tileStagingBuffers[currentFrame], pageTableImage,
+                VK_IMAGE_LAYOUT_GENERAL, 1, &region);
+            pageTableDirty = false;
+        }
+
+        if (uploadOverview) {
+            VkBufferImageCopy region{};
+            region.bufferOffset = stagingOverviewOffset;
+            region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            region.imageExtent = {overviewSize, overviewSize, 1};
+            vkCmdCopyBufferToImage(cmd, tileStagingBuffers[currentFrame], overviewImage,
+                VK_IMAGE_LAYOUT_GENERAL, 1, &region);
+        }
+
+        recordImageBarrier(cmd, tileImages, VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            terrainReadStage, VK_ACCESS_SHADER_READ_BIT);
+    }
+
+    // ========================================================================
+    // Pipeline
+    // ========================================================================
+    void createPipeline() {
+        // Load shaders
+        auto vertCode = readFile("shaders/terrain_vert.spv");
+        auto tescCode = readFile("shaders/terrain_tesc.spv");
+        auto teseCode = readFile("shaders/terrain_tese.spv");
+        // terrain_bary_frag.spv = terrain.frag을 WIRE_BARYCENTRIC으로 컴파일 (gl_BaryCoordEXT로 엣지 거리)
+        auto fragCode = readFile(barycentricSupported ? "shaders/terrain_bary_frag.spv" : "shaders/terrain_frag.spv");
+        auto clipmapVertCode = readFile("shaders/clipmap_vert.spv");
+
+        VkShaderModule clipmapVertModule = createShaderModule(clipmapVertCode);
+        VkShaderModule vertModule = createShaderModule(vertCode);
+        VkShaderModule tescModule = createShaderModule(tescCode);
+        VkShaderModule teseModule = createShaderModule(teseCode);
+        VkShaderModule fragModule = createShaderModule(fragCode);
+
+        // Shader stages
+        VkPipelineShaderStageCreateInfo vertStage{};
+        vertStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        vertStage.stage = VK_SHADER_STAGE_VERTEX_BIT;
+        vertStage.module = vertModule;
+        vertStage.pName = "main";
+
+        VkPipelineShaderStageCreateInfo tescStage{};
+        tescStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        tescStage.stage = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+        tescStage.module = tescModule;
+        tescStage.pName = "main";
+
+        VkPipelineShaderStageCreateInfo teseStage{};
+        teseStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        teseStage.stage = VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+        teseStage.module = teseModule;
+        teseStage.pName = "main";
+
+        VkPipelineShaderStageCreateInfo fragStage{};
+        fragStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        fragStage.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        fragStage.module = fragModule;
+        fragStage.pName = "main";
+
+        std::array<VkPipelineShaderStageCreateInfo, 4> shaderStages = {
+            vertStage, tescStage, teseStage, fragStage
+        };
+
+        // Vertex input (인스턴스 속성만)
+        std::array<VkVertexInputBindingDescription, 1> bindingDescs = {
+            PatchInstance::getBindingDescription()
+        };
+        auto attrDescs = getPatchAttributeDescriptions();
+
+        VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+        vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescs.size());
+        vertexInputInfo.pVertexBindingDescriptions = bindingDescs.data();
+        vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attrDescs.size());
+        vertexInputInfo.pVertexAttributeDescriptions = attrDescs.data();
+
+        // Input assembly - PATCH_LIST for tessellation
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_PATCH_LIST;  // 중요!
+        inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+        // Tessellation state
+        VkPipelineTessellationStateCreateInfo tessellationState{};
+        tessellationState.sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO;
+        tessellationState.patchControlPoints = 4;  // Quad patches
+
+        // Viewport
+        VkViewport viewport{};
+        viewport.x = 0.0f;
+        viewport.y = 0.0f;
+        viewport.width = static_cast<float>(swapchainExtent.width);
+        viewport.height = static_cast<float>(swapchainExtent.height);
+        viewport.minDepth = 0.0f;
+        viewport.maxDepth = 1.0f;
+
+        VkRect2D scissor{};
+        scissor.offset = {0, 0};
+        scissor.extent = swapchainExtent;
+
+        VkPipelineViewportStateCreateInfo viewportState{};
+        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.pViewports = &viewport;
+        viewportState.scissorCount = 1;
+        viewportState.pScissors = &scissor;
+
+        // Rasterizer (solid fill)
+        VkPipelineRasterizationStateCreateInfo rasterizer{};
+        rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizer.depthClampEnable = VK_FALSE;
+        rasterizer.rasterizerDiscardEnable = VK_FALSE;
+        rasterizer.polygonMode = VK_POLYGON_MODE_FILL;  // Solid
+        rasterizer.lineWidth = 1.0f;
+        rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+        rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        rasterizer.depthBiasEnable = VK_FALSE;
+
+        // Multisample
+        VkPipelineMultisampleStateCreateInfo multisampling{};
+        multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampling.sampleShadingEnable = VK_FALSE;
+        multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        // Depth stencil
+        VkPipelineDepthStencilStateCreateInfo depthStencil{};
+        depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable = VK_TRUE;
+        depthStencil.depthWriteEnable = VK_TRUE;
+        depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+        depthStencil.depthBoundsTestEnable = VK_FALSE;
+        depthStencil.stencilTestEnable = VK_FALSE;
+
+        // Color blending
+        VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                              VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        colorBlendAttachment.blendEnable = VK_FALSE;
+
+        VkPipelineColorBlendStateCreateInfo colorBlending{};
+        colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlending.logicOpEnable = VK_FALSE;
+        colorBlending.attachmentCount = 1;
+        colorBlending.pAttachments = &colorBlendAttachment;
+
+        // Push constants (clipmap 파이프라인도 같은 layout 사용: VS + FS)
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT |
+                                       VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT |
+                                       VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT |
+                                       VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(PushConstants);
+
+        // Pipeline layout
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &terrainDescriptorSetLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create pipeline layout!");
+        }
+
+        // Create solid pipeline
+        VkGraphicsPipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.stageCount = static_cast<uint32_t>(shaderStages.size());
+        pipelineInfo.pStages = shaderStages.data();
+        pipelineInfo.pVertexInputState = &vertexInputInfo;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pTessellationState = &tessellationState;  // 중요!
+        pipelineInfo.pViewportState = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState = &multisampling;
+        pipelineInfo.pDepthStencilState = &depthStencil;
+        pipelineInfo.pColorBlendState = &colorBlending;
+        pipelineInfo.layout = pipelineLayout;
+        pipelineInfo.renderPass = renderPass;
+        pipelineInfo.subpass = 0;
+
+        // 와이어프레임은 fragment shader overlay (push constant)라 별도 파이프라인 없음
+        if (tessellationSupported) {
+            if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
+                                          &tessellationPipeline) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create tessellation pipeline!");
+            }
+        }
+
+        // Geometry clipmap: VS + FS, 일반 삼각형 리스트 (테셀레이션 단계 없음)
+        VkPipelineShaderStageCreateInfo clipmapVertStage = vertStage;
+        clipmapVertStage.module = clipmapVertModule;
+        std::array<VkPipelineShaderStageCreateInfo, 2> clipmapStages = {clipmapVertStage, fragStage};
+
+        std::array<VkVertexInputBindingDescription, 2> clipmapBindingDescs = {
+            ClipmapVertex::getBindingDescription(),
+            ClipmapLevel::getBindingDescription()
+        };
+        auto clipmapAttrDescs = getClipmapAttributeDescriptions();
+        vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(clipmapBindingDescs.size());
+        vertexInputInfo.pVertexBindingDescriptions = clipmapBindingDescs.data();
+        vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(clipmapAttrDescs.size());
+        vertexInputInfo.pVertexAttributeDescriptions = clipmapAttrDescs.data();
+
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        pipelineInfo.stageCount = static_cast<uint32_t>(clipmapStages.size());
+        pipelineInfo.pStages = clipmapStages.data();
+        pipelineInfo.pTessellationState = nullptr;
+
+        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
+                                      &clipmapPipeline) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create clipmap pipeline!");
         }
 
+        vkDestroyShaderModule(device, clipmapVertModule, nullptr);
         vkDestroyShaderModule(device, vertModule, nullptr);
         vkDestroyShaderModule(device, tescModule, nullptr);
         vkDestroyShaderModule(device, teseModule, nullptr);
@@ -918,6 +3137,285 @@ private:
         }
     }
 
+    void createQueryPool() {
+        // 타임스탬프: 프레임마다 [지형 시작, 지형 끝, erosion 시작, erosion 끝] 4개
+        if (timestampsSupported) {
+            VkQueryPoolCreateInfo timestampPoolInfo{};
+            timestampPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            timestampPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+            timestampPoolInfo.queryCount = 4 * MAX_FRAMES_IN_FLIGHT;
+
+            if (vkCreateQueryPool(device, &timestampPoolInfo, nullptr, &timestampQueryPool) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create timestamp query pool!");
+            }
+            timestampQueryIssued.assign(MAX_FRAMES_IN_FLIGHT, false);
+            erosionTimestampIterations.assign(MAX_FRAMES_IN_FLIGHT, 0);
+        } else {
+            std::cout << "Timestamps not supported - GPU timing disabled" << std::endl;
+        }
+
+        if (!pipelineStatisticsSupported) {
+            std::cout << "pipelineStatisticsQuery not supported - primitive stats disabled" << std::endl;
+            return;
+        }
+
+        // 프레임마다 query 1개 (지형 draw만 감쌈, ImGui 제외)
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        queryPoolInfo.queryCount = MAX_FRAMES_IN_FLIGHT;
+        queryPoolInfo.pipelineStatistics = PIPELINE_STATISTICS_FLAGS;
+
+        if (vkCreateQueryPool(device, &queryPoolInfo, nullptr, &statisticsQueryPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create pipeline statistics query pool!");
+        }
+
+        statisticsQueryIssued.assign(MAX_FRAMES_IN_FLIGHT, false);
+    }
+
+    // 이 프레임 슬롯의 fence를 기다린 뒤 호출 → 이전 제출 결과는 이미 준비됨
+    void readPipelineStatistics() {
+        if (statisticsQueryPool == VK_NULL_HANDLE || !statisticsQueryIssued[currentFrame]) {
+            return;
+        }
+
+        uint64_t results[PIPELINE_STATISTICS_COUNT];
+        VkResult result = vkGetQueryPoolResults(device, statisticsQueryPool, currentFrame, 1,
+            sizeof(results), results, sizeof(results), VK_QUERY_RESULT_64_BIT);
+        if (result == VK_SUCCESS) {
+            std::copy(std::begin(results), std::end(results), pipelineStatistics);
+        }
+    }
+
+    void readTimestamps() {
+        if (timestampQueryPool == VK_NULL_HANDLE || !timestampQueryIssued[currentFrame]) {
+            return;
+        }
+
+        uint64_t ticks[2];
+        VkResult result = vkGetQueryPoolResults(device, timestampQueryPool, currentFrame * 4, 2,
+            sizeof(ticks), ticks, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+        if (result == VK_SUCCESS) {
+            terrainGpuMs = static_cast<double>(ticks[1] - ticks[0]) * timestampPeriod * 1e-6;
+        }
+
+        if (erosionTimestampIterations[currentFrame] > 0) {
+            result = vkGetQueryPoolResults(device, timestampQueryPool, currentFrame * 4 + 2, 2,
+                sizeof(ticks), ticks, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+            if (result == VK_SUCCESS) {
+                erosionGpuMs = static_cast<double>(ticks[1] - ticks[0]) * timestampPeriod * 1e-6;
+                erosionTimedIterations = erosionTimestampIterations[currentFrame];
+            }
+        }
+    }
+
+    // ========================================================================
+    // CPU Height Query Verification
+    // ========================================================================
+    // heightMap / normalMap을 구워 host 버퍼로 복사한 뒤 같은 텍셀 좌표에서 CPU 쿼리 경로별로 비교
+    // 높이는 비트 단위 일치가 기준, 노말은 RGBA16F 저장이라 허용 오차로 비교
+    bool verifyHeightQuery(float time) {
+        const size_t texelCount = size_t(HEIGHTMAP_SIZE) * HEIGHTMAP_SIZE;
+        VkDeviceSize heightBytes = sizeof(float) * texelCount;
+        VkDeviceSize normalBytes = sizeof(uint16_t) * 4 * texelCount;
+
+        VkBuffer heightReadback, normalReadback;
+        VkDeviceMemory heightReadbackMemory, normalReadbackMemory;
+        createBuffer(heightBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     heightReadback, heightReadbackMemory);
+        createBuffer(normalBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     normalReadback, normalReadbackMemory);
+
+        VkCommandBuffer cmd = beginSingleTimeCommands();
+
+        // bake rate 제한을 받지 않도록 강제로 다시 구움
+        bakedTime = -1.0f;
+        bakeRate = 1000.0f;
+        recordHeightfieldBake(cmd, time);
+
+        recordImageBarrier(cmd, {heightImage, normalImage}, VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+        VkBufferImageCopy region{};
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {HEIGHTMAP_SIZE, HEIGHTMAP_SIZE, 1};
+        vkCmdCopyImageToBuffer(cmd, heightImage, VK_IMAGE_LAYOUT_GENERAL, heightReadback, 1, &region);
+        vkCmdCopyImageToBuffer(cmd, normalImage, VK_IMAGE_LAYOUT_GENERAL, normalReadback, 1, &region);
+
+        endSingleTimeCommands(cmd);
+
+        // 셰이더와 같은 식으로 텍셀 좌표 생성: i * texelSpacing - terrainSize / 2
+        std::vector<float> xs(texelCount), zs(texelCount), heights(texelCount);
+        for (uint32_t y = 0; y < HEIGHTMAP_SIZE; y++) {
+            for (uint32_t x = 0; x < HEIGHTMAP_SIZE; x++) {
+                size_t i = size_t(y) * HEIGHTMAP_SIZE + x;
+                xs[i] = float(x) * HEIGHTMAP_TEXEL_SPACING - TERRAIN_SIZE * 0.5f;
+                zs[i] = float(y) * HEIGHTMAP_TEXEL_SPACING - TERRAIN_SIZE * 0.5f;
+            }
+        }
+
+        const float* gpuHeights;
+        const uint16_t* gpuNormals;
+        vkMapMemory(device, heightReadbackMemory, 0, heightBytes, 0, (void**)&gpuHeights);
+        vkMapMemory(device, normalReadbackMemory, 0, normalBytes, 0, (void**)&gpuNormals);
+
+        // 스칼라 경로와 (지원되면) AVX2 경로를 각각 GPU 결과와 비교
+        std::vector<terrain::QueryPath> paths = {terrain::QueryPath::Scalar};
+        if (terrain::bestQueryPath() == terrain::QueryPath::Avx2) {
+            paths.push_back(terrain::QueryPath::Avx2);
+        }
+
+        std::vector<float> nx(texelCount), ny(texelCount), nz(texelCount);
+        bool ok = true;
+        for (terrain::QueryPath path : paths) {
+            terrain::queryHeights(xs.data(), zs.data(), texelCount, time, heights.data(), path);
+            terrain::queryNormals(xs.data(), zs.data(), texelCount, time, heightScale, HEIGHTMAP_TEXEL_SPACING,
+                                  nx.data(), ny.data(), nz.data(), path);
+
+            size_t heightMismatches = 0;
+            float maxHeightError = 0.0f;
+            for (size_t i = 0; i < texelCount; i++) {
+                if (std::memcmp(&gpuHeights[i], &heights[i], sizeof(float)) != 0) {
+                    heightMismatches++;
+                    maxHeightError = std::max(maxHeightError, std::abs(gpuHeights[i] - heights[i]));
+                }
+            }
+
+            // 가장자리 텍셀은 셰이더가 clamp하므로 내부만 비교
+            size_t normalMismatches = 0;
+            float maxNormalError = 0.0f;
+            for (uint32_t y = 1; y + 1 < HEIGHTMAP_SIZE; y++) {
+                for (uint32_t x = 1; x + 1 < HEIGHTMAP_SIZE; x++) {
+                    size_t i = size_t(y) * HEIGHTMAP_SIZE + x;
+                    glm::vec3 gpu(glm::unpackHalf1x16(gpuNormals[i * 4 + 0]),
+                                  glm::unpackHalf1x16(gpuNormals[i * 4 + 1]),
+                                  glm::unpackHalf1x16(gpuNormals[i * 4 + 2]));
+                    glm::vec3 error = glm::abs(gpu - glm::vec3(nx[i], ny[i], nz[i]));
+                    float e = std::max({error.x, error.y, error.z});
+                    maxNormalError = std::max(maxNormalError, e);
+                    if (e > NORMAL_QUERY_TOLERANCE) {
+                        normalMismatches++;
+                    }
+                }
+            }
+
+            bool pathOk = heightMismatches == 0 && normalMismatches == 0;
+            std::cout << "Height query @ time " << time << " (" << terrain::queryPathName(path)
+                      << "): " << heightMismatches << "/" << texelCount << " heights differ from GPU"
+                      << " (max error " << maxHeightError << "), "
+                      << normalMismatches << " normals over tolerance (max error " << maxNormalError << ") - "
+                      << (pathOk ? "PASS" : "FAIL") << std::endl;
+            ok = pathOk && ok;
+        }
+
+        vkUnmapMemory(device, heightReadbackMemory);
+        vkUnmapMemory(device, normalReadbackMemory);
+        vkDestroyBuffer(device, heightReadback, nullptr);
+        vkFreeMemory(device, heightReadbackMemory, nullptr);
+        vkDestroyBuffer(device, normalReadback, nullptr);
+        vkFreeMemory(device, normalReadbackMemory, nullptr);
+        return ok;
+    }
+
+    // 무작위 지형 좌표에 대한 batch 쿼리 처리량 (단일 스레드, 경로별)
+    void measureHeightQueryThroughput() {
+        std::vector<float> xs(HEIGHT_QUERY_BENCH_SAMPLES), zs(HEIGHT_QUERY_BENCH_SAMPLES);
+        std::vector<float> heights(HEIGHT_QUERY_BENCH_SAMPLES);
+
+        uint32_t state = 12345u;
+        for (size_t i = 0; i < HEIGHT_QUERY_BENCH_SAMPLES; i++) {
+            state = terrain::hashBits(static_cast<int32_t>(state), static_cast<int32_t>(i));
+            xs[i] = (float(state >> 8) / 16777216.0f - 0.5f) * TERRAIN_SIZE;
+            state = terrain::hashBits(static_cast<int32_t>(state), static_cast<int32_t>(i));
+            zs[i] = (float(state >> 8) / 16777216.0f - 0.5f) * TERRAIN_SIZE;
+        }
+
+        std::vector<terrain::QueryPath> paths = {terrain::QueryPath::Scalar};
+        if (terrain::bestQueryPath() == terrain::QueryPath::Avx2) {
+            paths.push_back(terrain::QueryPath::Avx2);
+        }
+
+        for (terrain::QueryPath path : paths) {
+            auto start = std::chrono::high_resolution_clock::now();
+            terrain::queryHeights(xs.data(), zs.data(), xs.size(), 12.5f, heights.data(), path);
+            double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+            std::cout << "Height query throughput (" << terrain::queryPathName(path) << "): "
+                      << xs.size() / seconds * 1e-6 << " M samples/s" << std::endl;
+        }
+    }
+
+    // ========================================================================
+    // Benchmark
+    // ========================================================================
+    // 테셀레이션 → clipmap 순서로 같은 자동 회전 카메라 경로를 재생하며 평균을 냄
+    // 두 모드 모두 같은 heightfield를 같은 최고 해상도(텍셀 간격)로 그림
+    void startBenchmark() {
+        savedTerrainMode = terrainMode;
+        savedAutoRotate = autoRotate;
+        savedCameraYaw = cameraYaw;
+        benchmarkResults = {};
+        beginBenchmarkMode(tessellationSupported ? TERRAIN_MODE_TESSELLATION : TERRAIN_MODE_CLIPMAP);
+    }
+
+    void beginBenchmarkMode(int mode) {
+        benchmarkMode = mode;
+        benchmarkFrame = 0;
+        benchmarkAccum = {};
+        terrainMode = mode;
+        autoRotate = true;
+        cameraYaw = 0.0f;
+    }
+
+    // 이전 제출의 query 결과를 읽은 뒤 호출
+    void updateBenchmark() {
+        if (benchmarkMode < 0) {
+            return;
+        }
+
+        benchmarkFrame++;
+        if (benchmarkFrame <= BENCHMARK_WARMUP_FRAMES) {
+            return;
+        }
+
+        benchmarkAccum.gpuMs += terrainGpuMs;
+        benchmarkAccum.frameMs += lastFrameMs;
+        benchmarkAccum.primitives += static_cast<double>(pipelineStatistics[0]);
+
+        if (benchmarkFrame < BENCHMARK_WARMUP_FRAMES + BENCHMARK_FRAMES) {
+            return;
+        }
+
+        BenchmarkResult& result = benchmarkResults[benchmarkMode];
+        result.valid = true;
+        result.gpuMs = benchmarkAccum.gpuMs / BENCHMARK_FRAMES;
+        result.frameMs = benchmarkAccum.frameMs / BENCHMARK_FRAMES;
+        result.primitives = benchmarkAccum.primitives / BENCHMARK_FRAMES;
+        if (benchmarkMode == TERRAIN_MODE_CLIPMAP && !pipelineStatisticsSupported) {
+            result.primitives = static_cast<double>(clipmapTriangleCount());
+        }
+
+        std::cout << "Benchmark [" << (benchmarkMode == TERRAIN_MODE_TESSELLATION ? "tessellation" : "clipmap")
+                  << "] GPU " << result.gpuMs << " ms, frame " << result.frameMs << " ms, "
+                  << static_cast<uint64_t>(result.primitives) << " primitives" << std::endl;
+
+        if (benchmarkMode == TERRAIN_MODE_TESSELLATION) {
+            beginBenchmarkMode(TERRAIN_MODE_CLIPMAP);
+        } else {
+            benchmarkMode = -1;
+            terrainMode = savedTerrainMode;
+            autoRotate = savedAutoRotate;
+            cameraYaw = savedCameraYaw;
+        }
+    }
+
+    uint32_t clipmapTriangleCount() const {
+        return (clipmapFullIndexCount + clipmapRingIndexCount * (CLIPMAP_LEVELS - 1)) / 3;
+    }
+
     // ========================================================================
     // ImGui
     // ========================================================================
@@ -978,6 +3476,11 @@ private:
 
         vkResetFences(device, 1, &inFlightFences[currentFrame]);
 
+        readPipelineStatistics();
+        readTimestamps();
+        readCullStatistics();
+        updateBenchmark();
+
         recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
 
         VkSubmitInfo submitInfo{};
@@ -1014,9 +3517,15 @@ private:
         beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
         vkBeginCommandBuffer(cmd, &beginInfo);
 
-        // Calculate time
+        // Calculate time (애니메이션을 멈추면 heightfield도 다시 굽지 않음)
         auto currentTime = std::chrono::high_resolution_clock::now();
-        float time = std::chrono::duration<float>(currentTime - startTime).count();
+        float frameTime = std::chrono::duration<float>(currentTime - lastFrameTime).count();
+        lastFrameTime = currentTime;
+        lastFrameMs = frameTime * 1000.0f;
+        if (animateTerrain) {
+            animationTime += frameTime;
+        }
+        float time = animationTime;
 
         // Camera rotation
         if (autoRotate) {
@@ -1041,7 +3550,7 @@ private:
         }
 
         glm::mat4 proj = glm::perspective(glm::radians(45.0f),
-            swapchainExtent.width / (float)swapchainExtent.height, 0.1f, 100.0f);
+            swapchainExtent.width / (float)swapchainExtent.height, 0.1f, 500.0f);
         proj[1][1] *= -1;  // Vulkan Y flip
 
         PushConstants pc{};
@@ -1050,6 +3559,65 @@ private:
         pc.tessLevelInner = tessLevelInner;
         pc.heightScale = heightScale;
         pc.time = time;
+        pc.cameraPos = cameraPos;
+        pc.screenScale = std::abs(proj[1][1]) * swapchainExtent.height * 0.5f;
+        pc.targetEdgePixels = targetEdgePixels;
+        pc.adaptive = adaptiveTessellation ? 1 : 0;
+        pc.frustumCull = frustumCulling ? 1 : 0;
+        pc.terrainSize = TERRAIN_SIZE;
+        // Clipmap은 구운 절차적 heightfield만 사용 (DEM 스트리밍은 테셀레이션 경로 전용)
+        bool useClipmap = terrainMode == TERRAIN_MODE_CLIPMAP;
+        pc.heightSource = (tilesAvailable && !useClipmap) ? heightSource : HEIGHT_SOURCE_PROCEDURAL;
+        pc.wireframe = wireframe ? 1 : 0;
+
+        // 이번 프레임 인스턴스 버퍼 갱신 (fence 대기 후라 덮어써도 안전)
+        if (useClipmap) {
+            updateClipmapLevels();
+        } else {
+            updateQuadtree(pc.mvp, pc.screenScale);  // 보이는 패치 선택 → 인스턴스/indirect 버퍼
+        }
+
+        // Query reset은 render pass 밖에서
+        if (statisticsQueryPool != VK_NULL_HANDLE) {
+            vkCmdResetQueryPool(cmd, statisticsQueryPool, currentFrame, 1);
+        }
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            vkCmdResetQueryPool(cmd, timestampQueryPool, currentFrame * 4, 4);
+            erosionTimestampIterations[currentFrame] = 0;
+        }
+        if (!useClipmap) {
+            recordPatchInstanceUpload(cmd);
+        }
+
+        // Heightfield bake (compute, render pass 밖) - DEM 모드에서는 최초 초기화만
+        // erosion 중에는 구운 지형을 시뮬레이션이 덮어쓰므로 재굽기 중지
+        bool useErosion = erosionEnabled && pc.heightSource == HEIGHT_SOURCE_PROCEDURAL;
+        if (!heightfieldInitialized || (pc.heightSource == HEIGHT_SOURCE_PROCEDURAL && !useErosion)) {
+            recordHeightfieldBake(cmd, time);
+        }
+        if (useErosion) {
+            recordErosion(cmd);
+        }
+        bool useGpuCulling = gpuCulling && !useClipmap;
+        if (useGpuCulling && pc.heightSource == HEIGHT_SOURCE_PROCEDURAL) {
+            recordHeightBoundsBuild(cmd);
+        }
+
+        // DEM 타일: 요청 갱신 + 도착한 타일 업로드 (transfer, render pass 밖)
+        if (!useClipmap) {
+            updateTileRequests(pc.mvp);
+        }
+        recordTileStreaming(cmd);
+
+        // 지형 GPU 시간: 여기부터 지형 draw 끝까지 (clipmap은 레벨 갱신 포함)
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampQueryPool, currentFrame * 4);
+        }
+        if (useClipmap) {
+            recordClipmapUpdate(cmd);
+        } else if (useGpuCulling) {
+            recordPatchCull(cmd, pc.mvp, pc.heightSource);
+        }
 
         // Begin render pass
         VkRenderPassBeginInfo rpInfo{};
@@ -1068,30 +3636,64 @@ private:
         vkCmdBeginRenderPass(cmd, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
 
         // Bind pipeline
-        VkPipeline activePipeline = wireframe ? wireframePipeline : tessellationPipeline;
+        VkPipeline activePipeline = useClipmap ? clipmapPipeline : tessellationPipeline;
         vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, activePipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+            0, 1, &terrainDescriptorSet, 0, nullptr);
 
         // Push constants
         vkCmdPushConstants(cmd, pipelineLayout,
+            VK_SHADER_STAGE_VERTEX_BIT |
             VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT |
             VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT |
             VK_SHADER_STAGE_FRAGMENT_BIT,
             0, sizeof(PushConstants), &pc);
 
-        // Bind vertex buffer
-        VkBuffer vbuffers[] = {vertexBuffer};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(cmd, 0, 1, vbuffers, offsets);
-        vkCmdBindIndexBuffer(cmd, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        if (statisticsQueryPool != VK_NULL_HANDLE) {
+            vkCmdBeginQuery(cmd, statisticsQueryPool, currentFrame, 0);
+        }
+
+        if (useClipmap) {
+            // 레벨마다 draw 1회, firstInstance = 레벨 → VS가 인스턴스 속성으로 레벨 데이터를 받음
+            VkBuffer vbuffers[] = {clipmapVertexBuffer, clipmapLevelBuffers[currentFrame]};
+            VkDeviceSize offsets[] = {0, 0};
+            vkCmdBindVertexBuffers(cmd, 0, 2, vbuffers, offsets);
+            vkCmdBindIndexBuffer(cmd, clipmapIndexBuffer, 0, VK_INDEX_TYPE_UINT16);
+
+            vkCmdDrawIndexed(cmd, clipmapFullIndexCount, 1, 0, 0, 0);
+            for (uint32_t l = 1; l < CLIPMAP_LEVELS; l++) {
+                vkCmdDrawIndexed(cmd, clipmapRingIndexCount, 1,
+                    clipmapRingFirstIndex[clipmapRingVariant[l]], 0, l);
+            }
+        } else {
+            // 인스턴스 버퍼만 바인딩 (코너는 gl_VertexIndex, index 버퍼 없음)
+            // GPU culling이면 patch_cull.comp가 압축한 버퍼
+            VkDeviceSize offset = 0;
+            VkBuffer patchBuffer = useGpuCulling ? culledInstanceBuffers[currentFrame] : instanceBuffers[currentFrame];
+            vkCmdBindVertexBuffers(cmd, 0, 1, &patchBuffer, &offset);
+
+            // 보이는 모든 패치를 indirect draw 1회로 (instanceCount는 CPU 또는 patch_cull.comp가 씀)
+            vkCmdDrawIndirect(cmd, indirectBuffers[currentFrame], 0, 1, sizeof(VkDrawIndirectCommand));
+        }
 
-        // Draw patches
-        vkCmdDrawIndexed(cmd, indexCount, 1, 0, 0, 0);
+        if (statisticsQueryPool != VK_NULL_HANDLE) {
+            vkCmdEndQuery(cmd, statisticsQueryPool, currentFrame);
+            statisticsQueryIssued[currentFrame] = true;
+        }
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampQueryPool, currentFrame * 4 + 1);
+            timestampQueryIssued[currentFrame] = true;
+        }
 
         // ImGui
         renderImGui();
         ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), cmd);
 
         vkCmdEndRenderPass(cmd);
+
+        // 다음 프레임 occlusion culling용 Hi-Z
+        recordHiZBuild(cmd, pc.mvp);
+
         vkEndCommandBuffer(cmd);
     }
 
@@ -1106,11 +3708,64 @@ private:
         ImGui::Begin("Tessellation Terrain");
 
         ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            ImGui::Text("Terrain GPU: %.3f ms", terrainGpuMs);
+        }
+        ImGui::Separator();
+
+        ImGui::Text("Renderer");
+        if (!tessellationSupported) {
+            ImGui::TextDisabled("Tessellation not supported - clipmap only");
+        } else if (benchmarkMode < 0) {
+            ImGui::RadioButton("Tessellation", &terrainMode, TERRAIN_MODE_TESSELLATION);
+            ImGui::SameLine();
+            ImGui::RadioButton("Geometry Clipmap", &terrainMode, TERRAIN_MODE_CLIPMAP);
+        }
+        if (terrainMode == TERRAIN_MODE_CLIPMAP) {
+            ImGui::Text("Clipmap: %u levels x %u^2 vertices, %u triangles",
+                CLIPMAP_LEVELS, CLIPMAP_TEXELS, clipmapTriangleCount());
+            ImGui::Text("Levels updated: %u (full updates: %u)", clipmapLevelsUpdated, clipmapFullUpdates);
+        }
+
+        if (benchmarkMode >= 0) {
+            ImGui::Text("Benchmarking %s... %u/%u",
+                benchmarkMode == TERRAIN_MODE_TESSELLATION ? "tessellation" : "clipmap",
+                benchmarkFrame, BENCHMARK_WARMUP_FRAMES + BENCHMARK_FRAMES);
+        } else if (ImGui::Button("Run Benchmark")) {
+            startBenchmark();
+        }
+        for (int mode = 0; mode < 2; mode++) {
+            const BenchmarkResult& result = benchmarkResults[mode];
+            if (!result.valid) {
+                continue;
+            }
+            double nsPerTriangle = result.primitives > 0.0 ? result.gpuMs * 1e6 / result.primitives : 0.0;
+            ImGui::Text("  %-12s GPU %.3f ms, frame %.2f ms, %.0f prims (%.2f ns/prim)",
+                mode == TERRAIN_MODE_TESSELLATION ? "Tessellation" : "Clipmap",
+                result.gpuMs, result.frameMs, result.primitives, nsPerTriangle);
+        }
         ImGui::Separator();
 
         ImGui::Text("Tessellation Settings");
-        ImGui::SliderFloat("Outer Level", &tessLevelOuter, 1.0f, 64.0f);
-        ImGui::SliderFloat("Inner Level", &tessLevelInner, 1.0f, 64.0f);
+        ImGui::Checkbox("Adaptive (Screen-Space Error)", &adaptiveTessellation);
+        ImGui::Checkbox("Frustum Culling", &frustumCulling);
+        ImGui::Checkbox("GPU Patch Culling (Compute)", &gpuCulling);
+        if (gpuCulling) {
+            ImGui::SameLine();
+            if (hiZSupported) {
+                ImGui::Checkbox("Hi-Z Occlusion", &occlusionCulling);
+            } else {
+                ImGui::TextDisabled("(no Hi-Z)");
+            }
+        }
+        ImGui::SliderFloat("LOD Split (px)", &lodSplitPixels, 32.0f, 1024.0f);
+        if (adaptiveTessellation) {
+            ImGui::SliderFloat("Target Edge (px)", &targetEdgePixels, 2.0f, 64.0f);
+            ImGui::SliderFloat("Max Level", &tessLevelOuter, 1.0f, 64.0f);
+        } else {
+            ImGui::SliderFloat("Outer Level", &tessLevelOuter, 1.0f, 64.0f);
+            ImGui::SliderFloat("Inner Level", &tessLevelInner, 1.0f, 64.0f);
+        }
 
         // Quick presets
         if (ImGui::Button("Low (4)")) { tessLevelOuter = 4.0f; tessLevelInner = 4.0f; }
@@ -1121,11 +3776,75 @@ private:
 
         ImGui::Separator();
         ImGui::Text("Terrain Settings");
+        if (tilesAvailable && terrainMode == TERRAIN_MODE_TESSELLATION) {
+            ImGui::RadioButton("Procedural", &heightSource, HEIGHT_SOURCE_PROCEDURAL);
+            ImGui::SameLine();
+            ImGui::RadioButton("Streamed DEM", &heightSource, HEIGHT_SOURCE_STREAMED);
+            if (heightSource == HEIGHT_SOURCE_STREAMED) {
+                ImGui::SliderInt("Stream Radius (tiles)", &tileStreamRadius, 1, MAX_TILE_STREAM_RADIUS);
+                ImGui::Text("Tiles: %u/%u resident, %zu pending, %u uploaded",
+                    residentTileCount, TILE_CACHE_LAYERS, tileStreamer.pendingCount(), tileUploadsLastFrame);
+                ImGui::Text("Loaded from disk: %llu", static_cast<unsigned long long>(tileStreamer.loadedTotal()));
+            }
+        } else if (!tilesAvailable) {
+            ImGui::TextDisabled("DEM tiles: %s not found", tileFilePath.c_str());
+        }
         ImGui::SliderFloat("Height Scale", &heightScale, 0.0f, 10.0f);
+        ImGui::Checkbox("Animate Terrain", &animateTerrain);
+        if (animateTerrain) {
+            ImGui::SliderFloat("Bake Rate (Hz)", &bakeRate, 1.0f, 120.0f);
+        }
+        ImGui::Text("Heightfield %ux%u, bakes: height %u / normal %u",
+            HEIGHTMAP_SIZE, HEIGHTMAP_SIZE, heightBakeCount, normalBakeCount);
+
+        if (heightSource == HEIGHT_SOURCE_PROCEDURAL) {
+            if (ImGui::Checkbox("Erode", &erosionEnabled)) {
+                // 켤 때: 지금 구운 지형에서 시작, 끌 때: 절차적 지형을 다시 구움
+                erosionInitialized = false;
+                if (!erosionEnabled) {
+                    bakedTime = -1.0f;
+                }
+            }
+            if (erosionEnabled) {
+                ImGui::SameLine();
+                ImGui::Checkbox("Run", &erosionRunning);
+                ImGui::SameLine();
+                if (ImGui::Button("Reset")) {
+                    bakedTime = -1.0f;
+                    erosionEnabled = false;
+                    erosionInitialized = false;
+                }
+                ImGui::SliderInt("Iterations / Frame", &erosionIterationsPerFrame, 1, MAX_EROSION_ITERATIONS_PER_FRAME);
+                ImGui::SliderFloat("Time Step", &erosionTimeStep, 0.002f, 0.05f, "%.3f");
+                ImGui::SliderFloat("Rain", &rainRate, 0.0f, 0.05f, "%.4f");
+                ImGui::SliderFloat("Capacity", &sedimentCapacity, 0.0f, 0.5f, "%.3f");
+                ImGui::SliderFloat("Dissolve", &dissolveRate, 0.0f, 1.0f);
+                ImGui::SliderFloat("Deposition", &depositionRate, 0.0f, 1.0f);
+                ImGui::SliderFloat("Evaporation", &evaporationRate, 0.0f, 5.0f);
+                ImGui::SliderFloat("Talus (tan)", &talusTangent, 0.1f, 3.0f);
+                ImGui::SliderFloat("Thermal Rate", &thermalRate, 0.0f, 20.0f);
+                ImGui::Text("Iterations: %u", erosionIterations);
+                if (timestampQueryPool != VK_NULL_HANDLE && erosionTimedIterations > 0) {
+                    double msPerIteration = erosionGpuMs / erosionTimedIterations;
+                    double texels = double(HEIGHTMAP_SIZE) * HEIGHTMAP_SIZE;
+                    ImGui::Text("Erosion GPU: %.3f ms/iter, ~%.0f GB/s",
+                        msPerIteration, texels * EROSION_BYTES_PER_TEXEL / (msPerIteration * 1e6));
+                }
+            }
+        }
+
+        // 게임플레이 쿼리 예시: 카메라 아래 지형 높이 (CPU, 구운 heightfield와 같은 식)
+        float groundHeight;
+        terrain::queryHeights(&cameraPos.x, &cameraPos.z, 1, std::max(bakedTime, 0.0f), &groundHeight);
+        ImGui::Text("Ground under camera (CPU %s): %.3f",
+            terrain::queryPathName(terrain::bestQueryPath()), groundHeight * heightScale);
 
         ImGui::Separator();
         ImGui::Text("Display");
-        ImGui::Checkbox("Wireframe (Space)", &wireframe);
+        ImGui::Checkbox("Wireframe Overlay (Space)", &wireframe);
+        if (wireframe) {
+            ImGui::Text("  Edges: %s", barycentricSupported ? "triangle barycentrics" : "tess lattice (inner only)");
+        }
         ImGui::Checkbox("Auto Rotate", &autoRotate);
         if (autoRotate) {
             ImGui::SliderFloat("Rotation Speed", &rotationSpeed, 0.01f, 1.0f);
@@ -1135,12 +3854,38 @@ private:
         ImGui::Text("Camera: (%.1f, %.1f, %.1f)", cameraPos.x, cameraPos.y, cameraPos.z);
         ImGui::Text("Controls: WASD=Move, QE=Up/Down");
 
-        // Calculate triangle count
+        // 균일 레벨일 때의 삼각형 수 (비교 기준)
         float avgTess = (tessLevelOuter + tessLevelInner) / 2.0f;
-        int patchCount = 64; // 8x8 grid
+        uint32_t drawnPatches = gpuCulling ? gpuVisiblePatchCount : visiblePatchCount;
+        int patchCount = static_cast<int>(drawnPatches);
         int estimatedTris = static_cast<int>(patchCount * avgTess * avgTess * 2);
         ImGui::Separator();
-        ImGui::Text("Estimated triangles: ~%d", estimatedTris);
+        if (gpuCulling) {
+            // GPU 결과는 readback 때문에 MAX_FRAMES_IN_FLIGHT 프레임 늦음
+            ImGui::Text("Quadtree: %zu nodes, %u leaves, %u drawn (GPU culled %u)",
+                quadtreeNodes.size(), quadtreeLeafCount, drawnPatches,
+                visiblePatchCount - std::min(drawnPatches, visiblePatchCount));
+        } else {
+            ImGui::Text("Quadtree: %zu nodes, %u leaves in view, %u drawn",
+                quadtreeNodes.size(), quadtreeLeafCount, visiblePatchCount);
+        }
+        ImGui::Text("Quadtree update (CPU): %.3f ms, upload %zu bytes",
+            quadtreeUpdateMs, sizeof(PatchInstance) * visiblePatchCount);
+        ImGui::Text("Uniform estimate: ~%d triangles", estimatedTris);
+
+        if (statisticsQueryPool != VK_NULL_HANDLE) {
+            ImGui::Text("Pipeline Statistics");
+            ImGui::Text("  Patches (TCS): %llu", static_cast<unsigned long long>(pipelineStatistics[2]));
+            ImGui::Text("  TES invocations: %llu", static_cast<unsigned long long>(pipelineStatistics[3]));
+            ImGui::Text("  Emitted primitives: %llu", static_cast<unsigned long long>(pipelineStatistics[0]));
+            ImGui::Text("  After clipping: %llu", static_cast<unsigned long long>(pipelineStatistics[1]));
+            if (pipelineStatistics[0] > 0) {
+                ImGui::Text("  vs uniform: %.1fx fewer",
+                    static_cast<float>(estimatedTris) / static_cast<float>(pipelineStatistics[0]));
+            }
+        } else {
+            ImGui::TextDisabled("Pipeline statistics query not supported");
+        }
 
         ImGui::End();
 
@@ -1212,10 +3957,151 @@ private:
         vkBindBufferMemory(device, buffer, bufferMemory, 0);
     }
 
+    VkCommandBuffer beginSingleTimeCommands() {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandPool = commandPool;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer cmd;
+        vkAllocateCommandBuffers(device, &allocInfo, &cmd);
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        vkBeginCommandBuffer(cmd, &beginInfo);
+        return cmd;
+    }
+
+    void endSingleTimeCommands(VkCommandBuffer cmd) {
+        vkEndCommandBuffer(cmd);
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &cmd;
+
+        vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+        vkQueueWaitIdle(graphicsQueue);
+
+        vkFreeCommandBuffers(device, commandPool, 1, &cmd);
+    }
+
+    // 정적 데이터: staging 버퍼로 올린 뒤 device-local 버퍼로 복사
+    void createDeviceLocalBuffer(const void* data, VkDeviceSize size, VkBufferUsageFlags usage,
+                                 VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingMemory;
+        createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     stagingBuffer, stagingMemory);
+
+        void* mapped;
+        vkMapMemory(device, stagingMemory, 0, size, 0, &mapped);
+        memcpy(mapped, data, static_cast<size_t>(size));
+        vkUnmapMemory(device, stagingMemory);
+
+        createBuffer(size, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                     buffer, bufferMemory);
+
+        VkCommandBuffer cmd = beginSingleTimeCommands();
+        VkBufferCopy region{};
+        region.size = size;
+        vkCmdCopyBuffer(cmd, stagingBuffer, buffer, 1, &region);
+        endSingleTimeCommands(cmd);
+
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        vkFreeMemory(device, stagingMemory, nullptr);
+    }
+
+    void createTileImage(uint32_t width, uint32_t height, uint32_t layers,
+                         VkImage& image, VkDeviceMemory& imageMemory) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = {width, height, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = layers;
+        imageInfo.format = VK_FORMAT_R16_UINT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+        if (vkCreateImage(device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create tile image!");
+        }
+
+        VkMemoryRequirements memReqs;
+        vkGetImageMemoryRequirements(device, image, &memReqs);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memReqs.size;
+        allocInfo.memoryTypeIndex = findMemoryType(memReqs.memoryTypeBits,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        vkAllocateMemory(device, &allocInfo, nullptr, &imageMemory);
+        vkBindImageMemory(device, image, imageMemory, 0);
+    }
+
+    VkImageView createLayeredImageView(VkImage image, VkFormat format, VkImageViewType viewType, uint32_t layers) {
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = image;
+        viewInfo.viewType = viewType;
+        viewInfo.format = format;
+        viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, layers};
+
+        VkImageView view;
+        if (vkCreateImageView(device, &viewInfo, nullptr, &view) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create image view!");
+        }
+        return view;
+    }
+
+    void createStorageImage(VkFormat format, uint32_t size, uint32_t layers,
+                            VkImage& image, VkDeviceMemory& imageMemory) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = {size, size, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = layers;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                          VK_IMAGE_USAGE_TRANSFER_SRC_BIT;  // 검증용 readback
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+        if (vkCreateImage(device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create heightfield image!");
+        }
+
+        VkMemoryRequirements memReqs;
+        vkGetImageMemoryRequirements(device, image, &memReqs);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memReqs.size;
+        allocInfo.memoryTypeIndex = findMemoryType(memReqs.memoryTypeBits,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        vkAllocateMemory(device, &allocInfo, nullptr, &imageMemory);
+        vkBindImageMemory(device, image, imageMemory, 0);
+    }
+
     // ========================================================================
     // Cleanup
     // ========================================================================
     void cleanup() {
+        // 워커가 매핑된 파일을 읽고 있을 수 있으므로 먼저 정지
+        tileStreamer.stop();
+        tileFile.close();
+
         ImGui_ImplVulkan_Shutdown();
         ImGui_ImplGlfw_Shutdown();
         ImGui::DestroyContext();
@@ -1227,15 +4113,104 @@ private:
             vkDestroyFence(device, inFlightFences[i], nullptr);
         }
 
-        vkDestroyBuffer(device, vertexBuffer, nullptr);
-        vkFreeMemory(device, vertexBufferMemory, nullptr);
-        vkDestroyBuffer(device, indexBuffer, nullptr);
-        vkFreeMemory(device, indexBufferMemory, nullptr);
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            vkDestroyBuffer(device, instanceStagingBuffers[i], nullptr);
+            vkFreeMemory(device, instanceStagingMemory[i], nullptr);
+            vkDestroyBuffer(device, instanceBuffers[i], nullptr);
+            vkFreeMemory(device, instanceBuffersMemory[i], nullptr);
+            vkDestroyBuffer(device, indirectBuffers[i], nullptr);
+            vkFreeMemory(device, indirectBuffersMemory[i], nullptr);
+            vkDestroyBuffer(device, culledInstanceBuffers[i], nullptr);
+            vkFreeMemory(device, culledInstanceMemory[i], nullptr);
+            vkDestroyBuffer(device, cullParamBuffers[i], nullptr);
+            vkFreeMemory(device, cullParamMemory[i], nullptr);
+            vkDestroyBuffer(device, cullReadbackBuffers[i], nullptr);
+            vkFreeMemory(device, cullReadbackMemory[i], nullptr);
+        }
+        vkDestroyBuffer(device, heightBoundsBuffer, nullptr);
+        vkFreeMemory(device, heightBoundsMemory, nullptr);
+        vkDestroyBuffer(device, hiZBuffer, nullptr);
+        vkFreeMemory(device, hiZMemory, nullptr);
+
+        if (statisticsQueryPool != VK_NULL_HANDLE) {
+            vkDestroyQueryPool(device, statisticsQueryPool, nullptr);
+        }
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            vkDestroyQueryPool(device, timestampQueryPool, nullptr);
+        }
 
         vkDestroyPipeline(device, tessellationPipeline, nullptr);
-        vkDestroyPipeline(device, wireframePipeline, nullptr);
+        vkDestroyPipeline(device, clipmapPipeline, nullptr);
         vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
 
+        vkDestroyPipeline(device, bakePipeline, nullptr);
+        vkDestroyPipelineLayout(device, bakePipelineLayout, nullptr);
+        vkDestroyPipeline(device, erosionPipeline, nullptr);
+        vkDestroyPipelineLayout(device, erosionPipelineLayout, nullptr);
+        vkDestroyPipeline(device, heightBoundsPipeline, nullptr);
+        vkDestroyPipeline(device, hiZPipeline, nullptr);
+        vkDestroyPipeline(device, patchCullPipeline, nullptr);
+        vkDestroyPipelineLayout(device, cullPipelineLayout, nullptr);
+        vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(device, bakeDescriptorSetLayout, nullptr);
+        vkDestroyDescriptorSetLayout(device, cullDescriptorSetLayout, nullptr);
+        vkDestroyDescriptorSetLayout(device, erosionDescriptorSetLayout, nullptr);
+        vkDestroyDescriptorSetLayout(device, terrainDescriptorSetLayout, nullptr);
+
+        vkDestroySampler(device, terrainSampler, nullptr);
+        vkDestroySampler(device, nearestSampler, nullptr);
+
+        vkDestroyImageView(device, clipmapHeightView, nullptr);
+        vkDestroyImage(device, clipmapHeightImage, nullptr);
+        vkFreeMemory(device, clipmapHeightMemory, nullptr);
+        vkDestroyBuffer(device, clipmapVertexBuffer, nullptr);
+        vkFreeMemory(device, clipmapVertexMemory, nullptr);
+        vkDestroyBuffer(device, clipmapIndexBuffer, nullptr);
+        vkFreeMemory(device, clipmapIndexMemory, nullptr);
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            vkDestroyBuffer(device, clipmapLevelBuffers[i], nullptr);
+            vkFreeMemory(device, clipmapLevelMemory[i], nullptr);
+        }
+        vkDestroyPipeline(device, clipmapUpdatePipeline, nullptr);
+        vkDestroyPipelineLayout(device, clipmapUpdatePipelineLayout, nullptr);
+
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            vkDestroyBuffer(device, tileStagingBuffers[i], nullptr);
+            vkFreeMemory(device, tileStagingMemory[i], nullptr);
+        }
+        vkDestroyImageView(device, tileCacheView, nullptr);
+        vkDestroyImage(device, tileCacheImage, nullptr);
+        vkFreeMemory(device, tileCacheMemory, nullptr);
+        vkDestroyImageView(device, pageTableView, nullptr);
+        vkDestroyImage(device, pageTableImage, nullptr);
+        vkFreeMemory(device, pageTableMemory, nullptr);
+        vkDestroyImageView(device, overviewView, nullptr);
+        vkDestroyImage(device, overviewImage, nullptr);
+        vkFreeMemory(device, overviewMemory, nullptr);
+        vkDestroyImageView(device, staticHeightView, nullptr);
+        vkDestroyImage(device, staticHeightImage, nullptr);
+        vkFreeMemory(device, staticHeightMemory, nullptr);
+        vkDestroyImageView(device, heightView, nullptr);
+        vkDestroyImage(device, heightImage, nullptr);
+        vkFreeMemory(device, heightMemory, nullptr);
+        vkDestroyImageView(device, normalView, nullptr);
+        vkDestroyImage(device, normalImage, nullptr);
+        vkFreeMemory(device, normalMemory, nullptr);
+        for (uint32_t k = 0; k < 2; k++) {
+            vkDestroyImageView(device, erosionStateViews[k], nullptr);
+            vkDestroyImage(device, erosionStateImages[k], nullptr);
+            vkFreeMemory(device, erosionStateMemory[k], nullptr);
+        }
+        vkDestroyImageView(device, erosionFluxView, nullptr);
+        vkDestroyImage(device, erosionFluxImage, nullptr);
+        vkFreeMemory(device, erosionFluxMemory, nullptr);
+        vkDestroyImageView(device, erosionVelocityView, nullptr);
+        vkDestroyImage(device, erosionVelocityImage, nullptr);
+        vkFreeMemory(device, erosionVelocityMemory, nullptr);
+        vkDestroyImageView(device, erosionThermalView, nullptr);
+        vkDestroyImage(device, erosionThermalImage, nullptr);
+        vkFreeMemory(device, erosionThermalMemory, nullptr);
+
         vkDestroyCommandPool(device, commandPool, nullptr);
 
         for (auto fb : framebuffers) {
@@ -1269,12 +4244,117 @@ private:
     }
 };
 
+// ============================================================================
+// Tile File Tools
+// ============================================================================
+
+// 절차적 지형 (time = 0)을 DEM 타일 파일로 저장 - 스트리밍 데모용
+static bool generateTileFile(const std::string& path, uint32_t tiles, uint32_t tileCells) {
+    uint32_t size = tiles * tileCells + 1;
+    std::vector<uint16_t> samples(size_t(size) * size);
+
+    std::cout << "Generating " << size << "x" << size << " DEM (" << tiles << "x" << tiles
+              << " tiles)..." << std::endl;
+
+    // 텍셀 i ↔ 월드 -T/2 + i * T / (N - 1) (terrain_bake.comp와 같은 정점 중심 그리드)
+    // 높이는 [0, TERRAIN_HEIGHT_BOUND]를 [0, 65535]로 정규화
+    uint32_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t]() {
+            // 한 행씩 batch 쿼리 (AVX2 경로)
+            std::vector<float> xs(size), zs(size), heights(size);
+            for (uint32_t x = 0; x < size; x++) {
+                xs[x] = -TERRAIN_SIZE * 0.5f + TERRAIN_SIZE * x / (size - 1);
+            }
+            for (uint32_t y = t; y < size; y += threadCount) {
+                std::fill(zs.begin(), zs.end(), -TERRAIN_SIZE * 0.5f + TERRAIN_SIZE * y / (size - 1));
+                terrain::queryHeights(xs.data(), zs.data(), size, 0.0f, heights.data());
+                for (uint32_t x = 0; x < size; x++) {
+                    float h = heights[x] / TERRAIN_HEIGHT_BOUND;
+                    samples[size_t(y) * size + x] = static_cast<uint16_t>(std::clamp(h, 0.0f, 1.0f) * 65535.0f + 0.5f);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::string error;
+    if (!terrain::writeHeightTileFile(path, samples, size, size, tileCells, 257, error)) {
+        std::cerr << "Failed to write " << path << ": " << error << std::endl;
+        return false;
+    }
+    std::cout << "Wrote " << path << std::endl;
+    return true;
+}
+
+// Raw 16-bit little-endian DEM (.r16, width = tiles * cells + 1) → 타일 파일
+static bool buildTileFile(const std::string& input, uint32_t width, uint32_t height,
+                          const std::string& output, uint32_t tileCells) {
+    std::ifstream file(input, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open " << input << std::endl;
+        return false;
+    }
+
+    std::vector<uint16_t> samples(size_t(width) * height);
+    file.read(reinterpret_cast<char*>(samples.data()), samples.size() * sizeof(uint16_t));
+    if (file.gcount() != static_cast<std::streamsize>(samples.size() * sizeof(uint16_t))) {
+        std::cerr << input << " has fewer than " << width << "x" << height << " samples" << std::endl;
+        return false;
+    }
+
+    std::string error;
+    if (!terrain::writeHeightTileFile(output, samples, width, height, tileCells, 257, error)) {
+        std::cerr << "Failed to write " << output << ": " << error << std::endl;
+        return false;
+    }
+    std::cout << "Wrote " << output << std::endl;
+    return true;
+}
+
 // ============================================================================
 // Main
 // ============================================================================
-int main() {
+// 사용법:
+//   ch02-09 [--tiles <file.htiles>]
+//   ch02-09 --generate-tiles <out.htiles> [tiles=16] [cells=256]
+//   ch02-09 --build-tiles <in.r16> <width> <height> <out.htiles> [cells=256]
+//   ch02-09 --verify-height-query
+//   ch02-09 --erode <iterations> [out.htiles]
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    std::string tilePath = DEFAULT_TILE_FILE;
+
     try {
-        TessellationTerrainApp app;
+        if (args.size() >= 2 && args[0] == "--generate-tiles") {
+            uint32_t tiles = args.size() >= 3 ? static_cast<uint32_t>(std::stoul(args[2])) : 16;
+            uint32_t cells = args.size() >= 4 ? static_cast<uint32_t>(std::stoul(args[3])) : 256;
+            return generateTileFile(args[1], tiles, cells) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        if (args.size() >= 5 && args[0] == "--build-tiles") {
+            uint32_t cells = args.size() >= 6 ? static_cast<uint32_t>(std::stoul(args[5])) : 256;
+            bool ok = buildTileFile(args[1], static_cast<uint32_t>(std::stoul(args[2])),
+                                    static_cast<uint32_t>(std::stoul(args[3])), args[4], cells);
+            return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        if (args.size() >= 2 && args[0] == "--tiles") {
+            tilePath = args[1];
+        }
+        if (args.size() >= 1 && args[0] == "--verify-height-query") {
+            TessellationTerrainApp app(tilePath);
+            return app.runHeightQueryVerification() ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        if (args.size() >= 2 && args[0] == "--erode") {
+            TessellationTerrainApp app(tilePath);
+            uint32_t iterations = static_cast<uint32_t>(std::stoul(args[1]));
+            std::string output = args.size() >= 3 ? args[2] : std::string();
+            return app.runErosionBatch(iterations, output) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        TessellationTerrainApp app(tilePath);
         app.run();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
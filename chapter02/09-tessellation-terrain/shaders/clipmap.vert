@@ -0,0 +1,102 @@
+#version 450
+
+// Geometry clipmap vertex shader (Losasso & Hoppe 2004)
+// 카메라를 중심으로 간격이 2배씩 커지는 중첩 링, 레벨마다 정점 수는 같음
+// 테셀레이션 단계 없이 VS가 레벨 텍스처(toroidal)에서 높이를 직접 읽음
+//
+// 레벨 0은 전체 격자, 나머지는 안쪽 레벨 자리를 비운 링 (index buffer로 구분)
+// 링 바깥쪽으로 갈수록 높이를 다음 레벨 값으로 morph → 경계 정점이 거친 레벨 엣지 위에 놓여 crack 없음
+
+layout(location = 0) in vec2 inGrid;        // 레벨 안의 격자 좌표 (0 ~ cells)
+layout(location = 1) in ivec4 inOrigins;    // instance: 레벨 origin.xy, 다음 레벨 origin.zw
+layout(location = 2) in float inSpacing;    // instance: 레벨 격자 간격
+layout(location = 3) in uint inLevel;       // instance: 레벨 (= texture layer)
+
+layout(location = 0) out vec3 outWorldPos;
+layout(location = 1) out vec3 outNormal;
+layout(location = 2) out vec2 outTexCoord;
+layout(location = 3) out float outHeight;
+layout(location = 4) out vec3 outWireCoord;  // 격자 x, z, 대각선 (x - z): 정수 = 삼각형 엣지
+
+layout(push_constant) uniform PushConstants {
+    mat4 mvp;
+    float tessLevelOuter;
+    float tessLevelInner;
+    float heightScale;
+    float time;
+    vec3 cameraPos;
+    float screenScale;
+    float targetEdgePixels;
+    int adaptive;
+    int frustumCull;
+    float terrainSize;
+    int heightSource;
+    int wireframe;
+} pc;
+
+// clipmap_update.comp가 갱신하는 레벨별 높이 (layer = 레벨, 텍셀 = 격자점 mod N)
+layout(set = 0, binding = 5) uniform sampler2DArray clipmapHeights;
+
+// 레벨 창 [origin, origin + N) 안의 격자점 높이 (창 밖은 가장자리로 clamp)
+float fetchLevel(ivec2 g, int level, ivec2 origin) {
+    int n = textureSize(clipmapHeights, 0).x;
+    g = clamp(g, origin, origin + ivec2(n - 1));
+    ivec2 texel = ((g % n) + n) % n;
+    return texelFetch(clipmapHeights, ivec3(texel, level), 0).r;
+}
+
+void main() {
+    ivec2 origin = inOrigins.xy;
+    ivec2 g = origin + ivec2(inGrid);
+    int level = int(inLevel);
+    int levels = textureSize(clipmapHeights, 0).z;
+    int cells = textureSize(clipmapHeights, 0).x - 1;
+
+    // 격자 원점 = 지형 코너 → 레벨 0 격자점이 heightMap 텍셀과 정확히 겹침
+    float halfSize = pc.terrainSize * 0.5;
+    vec2 world = vec2(g) * inSpacing - halfSize;
+    float height = fetchLevel(g, level, origin);
+
+    // 레벨 경계 morph: 카메라에서 (레벨 간격 단위) 거리가 창 절반에 가까워지면 alpha → 1
+    // 창은 카메라로부터 최소 cells/2 - 2 떨어져 있으므로 경계 정점에서 alpha = 1
+    if (level + 1 < levels) {
+        vec2 d = abs(world - pc.cameraPos.xz) / inSpacing;
+        float blendWidth = float(cells) * 0.1;
+        float alpha = clamp((max(d.x, d.y) - (float(cells) * 0.5 - blendWidth - 2.5)) / blendWidth, 0.0, 1.0);
+
+        if (alpha > 0.0) {
+            // 다음 레벨 좌표 g / 2 (홀수면 두 격자점 사이) bilinear
+            ivec2 c0 = g >> 1;
+            vec2 f = vec2(g & 1) * 0.5;
+            ivec2 coarseOrigin = inOrigins.zw;
+
+            float h00 = fetchLevel(c0, level + 1, coarseOrigin);
+            float h10 = fetchLevel(c0 + ivec2(1, 0), level + 1, coarseOrigin);
+            float h01 = fetchLevel(c0 + ivec2(0, 1), level + 1, coarseOrigin);
+            float h11 = fetchLevel(c0 + ivec2(1, 1), level + 1, coarseOrigin);
+            float coarse = mix(mix(h00, h10, f.x), mix(h01, h11, f.x), f.y);
+
+            height = mix(height, coarse, alpha);
+        }
+    }
+
+    // 노말: 같은 레벨의 중앙 차분 (terrain_bake.comp와 같은 식)
+    float hL = fetchLevel(g - ivec2(1, 0), level, origin) * pc.heightScale;
+    float hR = fetchLevel(g + ivec2(1, 0), level, origin) * pc.heightScale;
+    float hD = fetchLevel(g - ivec2(0, 1), level, origin) * pc.heightScale;
+    float hU = fetchLevel(g + ivec2(0, 1), level, origin) * pc.heightScale;
+    vec3 normal = normalize(vec3(hL - hR, 2.0 * inSpacing, hD - hU));
+
+    // 지형 밖 정점은 가장자리로 모음 → 밖의 삼각형은 면적 0으로 퇴화
+    world = clamp(world, vec2(-halfSize), vec2(halfSize));
+
+    vec3 pos = vec3(world.x, height * pc.heightScale, world.y);
+
+    outWorldPos = pos;
+    outNormal = normal;
+    outTexCoord = world / pc.terrainSize + 0.5;
+    outHeight = height;
+    outWireCoord = vec3(inGrid, inGrid.x - inGrid.y);
+
+    gl_Position = pc.mvp * vec4(pos, 1.0);
+}
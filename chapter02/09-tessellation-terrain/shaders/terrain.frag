@@ -2,11 +2,21 @@
 
 // Tessellation terrain fragment shader
 // 높이 기반 색상 + 조명
+// wireframe = 1: 같은 pass에서 삼각형 엣지를 셰이딩 위에 overlay
+//   WIRE_BARYCENTRIC (terrain_bary_frag.spv): 래스터라이저가 만든 삼각형의 gl_BaryCoordEXT 성분이
+//     0이 되는 곳이 엣지 → outer 레벨 전이 띠를 포함한 실제 테셀레이션 결과 그대로
+//   fallback: inWireCoord의 각 성분이 정수가 되는 곳이 엣지 (TES: 내부 테셀레이션 격자, clipmap VS: 격자 + 대각선)
+//   화면 공간 거리 = 엣지까지의 거리 / fwidth → 해상도와 무관하게 일정한 선 두께
+
+#ifdef WIRE_BARYCENTRIC
+#extension GL_EXT_fragment_shader_barycentric : require
+#endif
 
 layout(location = 0) in vec3 inWorldPos;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
 layout(location = 3) in float inHeight;
+layout(location = 4) in vec3 inWireCoord;
 
 layout(location = 0) out vec4 outColor;
 
@@ -16,6 +26,14 @@ layout(push_constant) uniform PushConstants {
     float tessLevelInner;
     float heightScale;
     float time;
+    vec3 cameraPos;
+    float screenScale;
+    float targetEdgePixels;
+    int adaptive;
+    int frustumCull;
+    float terrainSize;
+    int heightSource;
+    int wireframe;
 } pc;
 
 // 높이 기반 지형 색상
@@ -85,10 +103,21 @@ void main() {
     vec3 litColor = terrainColor * (ambient + diffuse * 0.7) + vec3(specular);
     vec3 finalColor = mix(fogColor, litColor, fogFactor);
 
-    // 와이어프레임 힌트 (테셀레이션 시각화용 옵션)
-    // 그리드 라인 표시
-    vec2 grid = fract(inTexCoord * 16.0);
-    float line = step(0.95, max(grid.x, grid.y));
+    if (pc.wireframe != 0) {
+        // 가장 가까운 엣지까지의 픽셀 거리
+#ifdef WIRE_BARYCENTRIC
+        vec3 toEdge = gl_BaryCoordEXT;
+        vec3 pixels = toEdge / max(fwidth(gl_BaryCoordEXT), vec3(1e-6));
+#else
+        vec3 toEdge = abs(inWireCoord - round(inWireCoord));
+        vec3 pixels = toEdge / max(fwidth(inWireCoord), vec3(1e-6));
+#endif
+        float edgeDistance = min(min(pixels.x, pixels.y), pixels.z);
+
+        // 1 픽셀 선 + 1 픽셀 anti-aliasing
+        float line = 1.0 - smoothstep(0.5, 1.5, edgeDistance);
+        finalColor = mix(finalColor, vec3(0.05, 0.05, 0.08), line * 0.85);
+    }
 
     outColor = vec4(finalColor, 1.0);
 }
@@ -1,16 +1,52 @@
 #version 450
 
 // Tessellation terrain vertex shader
-// 패치 제어점을 TCS에 전달
+// 정점/index 버퍼 없이 패치 코너를 gl_VertexIndex (0~3)로 만들고
+// 16-bit quadtree 인스턴스 (leaf 격자 좌표, 깊이)로 배치해 TCS에 전달
 
-layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec2 inTexCoord;
+// instance: (gridX, gridZ, depth, coarserEdges)
+// coarserEdges = 더 큰 이웃과 맞닿은 엣지 비트 (-x, -z, +x, +z)
+layout(location = 0) in uvec4 inPatch;
 
 layout(location = 0) out vec3 outPosition;
 layout(location = 1) out vec2 outTexCoord;
+layout(location = 2) out uint outCoarserEdges;
+layout(location = 3) out float outPatchSize;
+
+layout(push_constant) uniform PushConstants {
+    mat4 mvp;
+    float tessLevelOuter;
+    float tessLevelInner;
+    float heightScale;
+    float time;
+    vec3 cameraPos;
+    float screenScale;
+    float targetEdgePixels;
+    int adaptive;
+    int frustumCull;
+    float terrainSize;
+    int heightSource;
+    int wireframe;
+} pc;
+
+// main.cpp의 QUADTREE_MAX_DEPTH와 같은 값 (격자 좌표 단위 = 최대 깊이 leaf 크기)
+const int QUADTREE_MAX_DEPTH = 7;
+
+// 코너 순서 (counter-clockwise): 0 = (0,0), 1 = (1,0), 2 = (1,1), 3 = (0,1)
+const vec2 CORNERS[4] = vec2[4](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
 
 void main() {
-    // 패치 정점을 그대로 전달 (실제 변환은 TES에서)
-    outPosition = inPosition;
-    outTexCoord = inTexCoord;
+    // ldexp는 지수만 바꾸므로 정확 (나눗셈은 GPU 정밀도가 보장되지 않음)
+    // 노드 좌표는 leaf 크기의 정수배라 float로 정확히 표현됨
+    // → 이웃 패치와 공유하는 코너가 비트 단위로 일치
+    float leafSize = ldexp(pc.terrainSize, -QUADTREE_MAX_DEPTH);
+    float patchSize = ldexp(pc.terrainSize, -int(inPatch.z));
+    vec2 origin = vec2(inPatch.xy) * leafSize - pc.terrainSize * 0.5;
+    vec2 xz = origin + CORNERS[gl_VertexIndex & 3] * patchSize;
+
+    // 실제 변환은 TES에서
+    outPosition = vec3(xz.x, 0.0, xz.y);
+    outTexCoord = xz / pc.terrainSize + 0.5;
+    outCoarserEdges = inPatch.w;
+    outPatchSize = patchSize;
 }
@@ -0,0 +1,93 @@
+#pragma once
+
+/**
+ * 지형 노이즈 CPU 구현
+ *
+ * shaders/terrain_bake.comp의 hash / noise / fbm / getHeight와 같은 식
+ * 타일 파일 생성(--generate-tiles) 등 CPU에서 지형 높이가 필요할 때 사용
+ *
+ * 셰이더와 연산 순서까지 같으므로 FMA 결합만 막으면 (-ffp-contract=off) 결과가 비트 단위로 같음
+ * 대량 쿼리는 terrain_query.h의 batch API (AVX2) 사용
+ */
+
+#include <cmath>
+#include <cstdint>
+
+namespace terrain {
+
+inline float fract(float x) {
+    return x - std::floor(x);
+}
+
+inline float mix(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+// 격자점 해시 (정수 avalanche) → [0, 1)
+inline uint32_t hashBits(int32_t x, int32_t y) {
+    uint32_t h = (uint32_t(x) * 0x8da6b343u) ^ (uint32_t(y) * 0xd8163841u);
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return h;
+}
+
+inline float hash(int32_t x, int32_t y) {
+    return float(hashBits(x, y) >> 8) * (1.0f / 16777216.0f);
+}
+
+inline float noise(float x, float y) {
+    float flx = std::floor(x);
+    float fly = std::floor(y);
+    int32_t ix = static_cast<int32_t>(flx);
+    int32_t iy = static_cast<int32_t>(fly);
+    float fx = x - flx;
+    float fy = y - fly;
+
+    // Cubic Hermite smoothing
+    float ux = fx * fx * (3.0f - 2.0f * fx);
+    float uy = fy * fy * (3.0f - 2.0f * fy);
+
+    return mix(
+        mix(hash(ix, iy), hash(ix + 1, iy), ux),
+        mix(hash(ix, iy + 1), hash(ix + 1, iy + 1), ux),
+        uy
+    );
+}
+
+inline float fbm(float x, float y) {
+    float value = 0.0f;
+    float amplitude = 0.5f;
+    float frequency = 1.0f;
+
+    for (int i = 0; i < 4; i++) {
+        value += amplitude * noise(x * frequency, y * frequency);
+        frequency *= 2.0f;
+        amplitude *= 0.5f;
+    }
+
+    return value;
+}
+
+// 시간과 무관한 항 (디테일 노이즈 + 산악 지형)
+inline float staticHeight(float x, float z) {
+    float h = noise(x * 2.0f, z * 2.0f) * 0.2f;
+
+    float ridge = std::abs(noise(x * 0.8f + 100.0f, z * 0.8f + 100.0f) - 0.5f) * 2.0f;
+    h += ridge * ridge * 0.4f;
+
+    return h;
+}
+
+// 시간에 따라 흐르는 기본 언덕
+inline float animatedHeight(float x, float z, float time) {
+    return fbm(x * 0.5f + time * 0.05f, z * 0.5f + time * 0.05f) * 0.6f;
+}
+
+inline float height(float x, float z, float time) {
+    return staticHeight(x, z) + animatedHeight(x, z, time);
+}
+
+} // namespace terrain
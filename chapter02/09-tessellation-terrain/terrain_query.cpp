@@ -0,0 +1,204 @@
+#include "terrain_query.h"
+#include "terrain_noise.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define TERRAIN_QUERY_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang: 이 함수들만 AVX2로 컴파일 (실행 여부는 런타임 CPU 검사로 결정)
+// MSVC는 target 지정 없이 intrinsic 사용 가능
+#if defined(TERRAIN_QUERY_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TERRAIN_AVX2 __attribute__((target("avx2")))
+#else
+#define TERRAIN_AVX2
+#endif
+
+namespace terrain {
+
+namespace {
+
+#ifdef TERRAIN_QUERY_X86
+bool detectAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // OS가 YMM 레지스터를 저장하는지 (OSXSAVE + XCR0의 SSE/AVX 비트)
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+// terrain_noise.h의 hashBits / hash를 8 lane으로
+TERRAIN_AVX2 inline __m256 hash8(__m256i x, __m256i y) {
+    __m256i h = _mm256_xor_si256(_mm256_mullo_epi32(x, _mm256_set1_epi32(int32_t(0x8da6b343u))),
+                                 _mm256_mullo_epi32(y, _mm256_set1_epi32(int32_t(0xd8163841u))));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32(int32_t(0x7feb352du)));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 15));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32(int32_t(0x846ca68bu)));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+
+    // 상위 24비트는 양수 int32 범위 → 부호 있는 변환으로도 정확
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(h, 8)), _mm256_set1_ps(1.0f / 16777216.0f));
+}
+
+TERRAIN_AVX2 inline __m256 lerp8(__m256 a, __m256 b, __m256 t) {
+    return _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), t));
+}
+
+TERRAIN_AVX2 inline __m256 noise8(__m256 x, __m256 y) {
+    __m256 flx = _mm256_floor_ps(x);
+    __m256 fly = _mm256_floor_ps(y);
+    __m256i ix = _mm256_cvttps_epi32(flx);
+    __m256i iy = _mm256_cvttps_epi32(fly);
+    __m256 fx = _mm256_sub_ps(x, flx);
+    __m256 fy = _mm256_sub_ps(y, fly);
+
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 three = _mm256_set1_ps(3.0f);
+    __m256 ux = _mm256_mul_ps(_mm256_mul_ps(fx, fx), _mm256_sub_ps(three, _mm256_mul_ps(two, fx)));
+    __m256 uy = _mm256_mul_ps(_mm256_mul_ps(fy, fy), _mm256_sub_ps(three, _mm256_mul_ps(two, fy)));
+
+    const __m256i one = _mm256_set1_epi32(1);
+    __m256i ix1 = _mm256_add_epi32(ix, one);
+    __m256i iy1 = _mm256_add_epi32(iy, one);
+
+    return lerp8(
+        lerp8(hash8(ix, iy), hash8(ix1, iy), ux),
+        lerp8(hash8(ix, iy1), hash8(ix1, iy1), ux),
+        uy
+    );
+}
+
+TERRAIN_AVX2 inline __m256 height8(__m256 x, __m256 z, __m256 timeOffset) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    // staticHeight
+    __m256 h = _mm256_mul_ps(noise8(_mm256_mul_ps(x, _mm256_set1_ps(2.0f)),
+                                    _mm256_mul_ps(z, _mm256_set1_ps(2.0f))),
+                             _mm256_set1_ps(0.2f));
+
+    __m256 rx = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(0.8f)), _mm256_set1_ps(100.0f));
+    __m256 rz = _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(0.8f)), _mm256_set1_ps(100.0f));
+    __m256 ridge = _mm256_sub_ps(noise8(rx, rz), _mm256_set1_ps(0.5f));
+    ridge = _mm256_mul_ps(_mm256_andnot_ps(signMask, ridge), _mm256_set1_ps(2.0f));
+    h = _mm256_add_ps(h, _mm256_mul_ps(_mm256_mul_ps(ridge, ridge), _mm256_set1_ps(0.4f)));
+
+    // animatedHeight (fbm 4 옥타브)
+    __m256 px = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(0.5f)), timeOffset);
+    __m256 pz = _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(0.5f)), timeOffset);
+
+    __m256 value = _mm256_setzero_ps();
+    float amplitude = 0.5f;
+    float frequency = 1.0f;
+    for (int i = 0; i < 4; i++) {
+        __m256 f = _mm256_set1_ps(frequency);
+        __m256 n = noise8(_mm256_mul_ps(px, f), _mm256_mul_ps(pz, f));
+        value = _mm256_add_ps(value, _mm256_mul_ps(_mm256_set1_ps(amplitude), n));
+        frequency *= 2.0f;
+        amplitude *= 0.5f;
+    }
+
+    return _mm256_add_ps(h, _mm256_mul_ps(value, _mm256_set1_ps(0.6f)));
+}
+
+TERRAIN_AVX2 size_t queryHeightsAvx2(const float* x, const float* z, size_t count, float time, float* heights) {
+    __m256 timeOffset = _mm256_set1_ps(time * 0.05f);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 h = height8(_mm256_loadu_ps(x + i), _mm256_loadu_ps(z + i), timeOffset);
+        _mm256_storeu_ps(heights + i, h);
+    }
+    return i;
+}
+#endif
+
+bool avx2Supported() {
+#ifdef TERRAIN_QUERY_X86
+    static const bool supported = detectAvx2();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+QueryPath bestQueryPath() {
+    return avx2Supported() ? QueryPath::Avx2 : QueryPath::Scalar;
+}
+
+const char* queryPathName(QueryPath path) {
+    return path == QueryPath::Avx2 ? "AVX2" : "scalar";
+}
+
+void queryHeights(const float* x, const float* z, size_t count, float time, float* heights, QueryPath path) {
+    size_t done = 0;
+#ifdef TERRAIN_QUERY_X86
+    if (path == QueryPath::Avx2 && avx2Supported()) {
+        done = queryHeightsAvx2(x, z, count, time, heights);
+    }
+#endif
+
+    // 8개 미만 나머지 (또는 스칼라 경로 전체)
+    for (size_t i = done; i < count; i++) {
+        heights[i] = height(x[i], z[i], time);
+    }
+}
+
+void queryNormals(const float* x, const float* z, size_t count, float time,
+                  float heightScale, float spacing, float* nx, float* ny, float* nz, QueryPath path) {
+    // 블록 단위로 좌/우/아래/위 샘플 좌표를 만들어 높이 batch 4회
+    constexpr size_t BLOCK = 256;
+    float sx[4][BLOCK], sz[4][BLOCK], sh[4][BLOCK];
+
+    for (size_t base = 0; base < count; base += BLOCK) {
+        size_t n = std::min(BLOCK, count - base);
+        for (size_t i = 0; i < n; i++) {
+            float px = x[base + i];
+            float pz = z[base + i];
+            sx[0][i] = px - spacing; sz[0][i] = pz;  // L
+            sx[1][i] = px + spacing; sz[1][i] = pz;  // R
+            sx[2][i] = px; sz[2][i] = pz - spacing;  // D
+            sx[3][i] = px; sz[3][i] = pz + spacing;  // U
+        }
+        for (int s = 0; s < 4; s++) {
+            queryHeights(sx[s], sz[s], n, time, sh[s], path);
+        }
+
+        // terrain_bake.comp mode 2와 같은 식
+        for (size_t i = 0; i < n; i++) {
+            float ax = sh[0][i] * heightScale - sh[1][i] * heightScale;
+            float ay = 2.0f * spacing;
+            float az = sh[2][i] * heightScale - sh[3][i] * heightScale;
+            float invLength = 1.0f / std::sqrt(ax * ax + ay * ay + az * az);
+            nx[base + i] = ax * invLength;
+            ny[base + i] = ay * invLength;
+            nz[base + i] = az * invLength;
+        }
+    }
+}
+
+} // namespace terrain
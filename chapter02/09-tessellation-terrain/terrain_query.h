@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * CPU 지형 높이/노말 batch 쿼리 (충돌, 오브젝트 배치 등 게임플레이용)
+ *
+ * 높이 = terrain_bake.comp의 mode 1 결과와 비트 단위로 같은 값 (terrain_noise.h와 같은 식)
+ * → 같은 월드 좌표로 구운 heightfield 텍셀과 정확히 일치
+ * 노말 = terrain_bake.comp mode 2와 같은 중앙 차분 (normalize만 GPU 구현 정밀도 차이가 있음)
+ *
+ * x86에서 AVX2를 지원하면 8개씩 처리하고 나머지와 비지원 CPU는 스칼라 경로 사용
+ * 두 경로 모두 같은 IEEE 연산 순서라 결과가 같음 (FMA 결합 금지, CMakeLists.txt 참고)
+ */
+
+#include <cstddef>
+
+namespace terrain {
+
+enum class QueryPath {
+    Scalar,
+    Avx2
+};
+
+// 이 CPU에서 쓸 수 있는 가장 빠른 경로
+QueryPath bestQueryPath();
+const char* queryPathName(QueryPath path);
+
+// heights[i] = height(x[i], z[i], time)
+void queryHeights(const float* x, const float* z, size_t count, float time, float* heights,
+                  QueryPath path = bestQueryPath());
+
+// (x[i], z[i])의 노말: 간격 spacing의 중앙 차분, 높이는 heightScale 배
+// 구운 normalMap과 같은 값을 원하면 spacing = heightfield 텍셀 간격
+void queryNormals(const float* x, const float* z, size_t count, float time,
+                  float heightScale, float spacing, float* nx, float* ny, float* nz,
+                  QueryPath path = bestQueryPath());
+
+} // namespace terrain
@@ -0,0 +1,127 @@
+#include "acceleration.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace rt {
+
+namespace {
+
+// object space AABB의 꼭짓점 8개를 변환한 월드 AABB
+Aabb transformBounds(const Aabb& bounds, const glm::mat4& transform) {
+    Aabb result;
+    for (int corner = 0; corner < 8; corner++) {
+        glm::vec3 p((corner & 1) ? bounds.max.x : bounds.min.x,
+                    (corner & 2) ? bounds.max.y : bounds.min.y,
+                    (corner & 4) ? bounds.max.z : bounds.min.z);
+        result.grow(glm::vec3(transform * glm::vec4(p, 1.0f)));
+    }
+    return result;
+}
+
+} // namespace
+
+void AccelerationStructure::build(const Scene& scene, TaskPool& pool) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    primitives.clear();
+    blasNodes.clear();
+    blases.assign(scene.meshes.size(), BlasRange{});
+    blasStats = BlasStats{};
+
+    // mesh 하나의 BVH는 pool로 병렬 빌드, mesh끼리는 순서대로 (pool.wait는 중첩 불가)
+    std::vector<Aabb> bounds;
+    for (size_t m = 0; m < scene.meshes.size(); m++) {
+        const Mesh& mesh = scene.meshes[m];
+        BlasRange& blas = blases[m];
+        blas.nodeFirst = static_cast<uint32_t>(blasNodes.size());
+        blas.primitiveFirst = static_cast<uint32_t>(primitives.size());
+        blas.primitiveCount = mesh.primitiveCount;
+
+        bounds.resize(mesh.primitiveCount);
+        for (uint32_t i = 0; i < mesh.primitiveCount; i++) {
+            bounds[i] = primitiveBounds(scene.primitives[mesh.firstPrimitive + i]);
+            blas.bounds.grow(bounds[i]);
+        }
+
+        Bvh bvh = buildBvh(bounds, pool);
+        for (uint32_t ref : bvh.primitiveOrder) {
+            primitives.push_back(scene.primitives[mesh.firstPrimitive + ref]);
+        }
+
+        // 구간 상대 인덱스 → 전체 배열 절대 인덱스
+        for (BvhNode node : bvh.nodes) {
+            node.missIndex += blas.nodeFirst;
+            if (node.isLeaf()) {
+                node.primitiveInfo = ((node.firstPrimitive() + blas.primitiveFirst) << BVH_LEAF_COUNT_BITS) |
+                                     node.primitiveCount();
+            }
+            blasNodes.push_back(node);
+        }
+        blas.nodeEnd = static_cast<uint32_t>(blasNodes.size());
+
+        blasStats.maxDepth = std::max(blasStats.maxDepth, bvh.stats.maxDepth);
+    }
+
+    planeFirst = static_cast<uint32_t>(primitives.size());
+    planeCount = static_cast<uint32_t>(scene.planes.size());
+    primitives.insert(primitives.end(), scene.planes.begin(), scene.planes.end());
+
+    tlasInputs.clear();
+    inputMeshes.clear();
+    inputMaterials.clear();
+    for (size_t i = 0; i < scene.instances.size(); i++) {
+        const Instance& instance = scene.instances[i];
+        if (blases[instance.mesh].primitiveCount == 0) {
+            continue;  // 빈 mesh: AABB가 없어 TLAS에 넣을 수 없음
+        }
+        tlasInputs.push_back(static_cast<uint32_t>(i));
+        inputMeshes.push_back(instance.mesh);
+        inputMaterials.push_back(instance.material);
+    }
+    worldBounds.resize(tlasInputs.size());
+    tlas = Bvh{};
+    instances.clear();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    blasStats.buildMs = std::chrono::duration<double, std::milli>(end - start).count();
+    blasStats.meshCount = static_cast<uint32_t>(scene.meshes.size());
+    blasStats.nodeCount = static_cast<uint32_t>(blasNodes.size());
+    blasStats.primitiveCount = planeFirst;
+}
+
+void AccelerationStructure::updateInstances(const std::vector<glm::mat4>& transforms, bool rebuild,
+                                            TaskPool& pool) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < tlasInputs.size(); i++) {
+        worldBounds[i] = transformBounds(blases[inputMeshes[i]].bounds, transforms[tlasInputs[i]]);
+    }
+
+    // instance 순서는 TLAS 리프 순서를 따름 → 구조가 바뀌는 rebuild 때만 다시 정렬
+    lastUpdateRebuilt = rebuild || tlas.nodes.empty();
+    if (lastUpdateRebuilt) {
+        tlas = buildBvh(worldBounds, pool);
+    } else {
+        refitBvh(tlas, worldBounds);
+    }
+
+    instances.resize(tlas.primitiveOrder.size());
+    for (size_t slot = 0; slot < instances.size(); slot++) {
+        uint32_t input = tlas.primitiveOrder[slot];
+        const BlasRange& blas = blases[inputMeshes[input]];
+
+        GpuInstance& gpu = instances[slot];
+        gpu.worldToObject = glm::inverse(transforms[tlasInputs[input]]);
+        gpu.nodeFirst = blas.nodeFirst;
+        gpu.nodeEnd = blas.nodeEnd;
+        gpu.primitiveFirst = blas.primitiveFirst;
+        gpu.primitiveCount = blas.primitiveCount;
+        gpu.material = inputMaterials[input];
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    updateMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace rt
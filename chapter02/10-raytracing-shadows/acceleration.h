@@ -0,0 +1,79 @@
+#pragma once
+
+/**
+ * 2단계 가속 구조 (BLAS / TLAS)
+ *
+ * - BLAS: mesh마다 object space BVH 하나, 장면이 바뀔 때만 빌드
+ *   모든 BLAS 노드 / primitive를 한 배열에 이어 붙이고 missIndex / 리프 first를 절대 인덱스로 저장
+ *   → 셰이더는 [nodeFirst, nodeEnd) 구간을 그대로 스택 없이 순회
+ * - TLAS: instance의 월드 AABB (BLAS 루트 AABB를 변환한 것)에 대한 BVH
+ *   매 프레임 refit (또는 rebuild) → 비용은 instance 수에만 비례 (삼각형 수와 무관)
+ * - 광선은 instance 리프에서 worldToObject로 object space로 옮겨 BLAS를 순회
+ *   방향을 정규화하지 않으므로 t가 월드 / object space에서 같음
+ */
+
+#include "bvh.h"
+#include "scene.h"
+
+#include <vector>
+
+namespace rt {
+
+// raytrace.comp의 Instance와 같은 레이아웃 (std430, 96 byte)
+struct GpuInstance {
+    glm::mat4 worldToObject;
+    uint32_t nodeFirst;       // BLAS 노드 구간 [nodeFirst, nodeEnd)
+    uint32_t nodeEnd;
+    uint32_t primitiveFirst;  // BLAS 순회 없이 검사할 때 (useBvh = 0)
+    uint32_t primitiveCount;
+    uint32_t material;        // MATERIAL_FROM_MESH = primitive 재질
+    uint32_t padding[3];
+};
+static_assert(sizeof(GpuInstance) == 96, "GpuInstance must match raytrace.comp (std430)");
+
+struct BlasStats {
+    double buildMs = 0.0;
+    uint32_t meshCount = 0;
+    uint32_t nodeCount = 0;
+    uint32_t primitiveCount = 0;
+    uint32_t maxDepth = 0;
+};
+
+struct AccelerationStructure {
+    // GPU 업로드 대상
+    std::vector<Primitive> primitives;  // [BLAS 리프 순서 (object space), 평면 (월드)]
+    uint32_t planeFirst = 0;
+    uint32_t planeCount = 0;
+    std::vector<BvhNode> blasNodes;
+    Bvh tlas;                           // primitiveOrder = TLAS 리프 순서 → TLAS 입력 인덱스
+    std::vector<GpuInstance> instances; // TLAS 리프 순서 (리프 first가 바로 이 배열을 가리킴)
+
+    BlasStats blasStats;
+    double updateMs = 0.0;  // 마지막 updateInstances (월드 AABB + refit / rebuild + 역행렬)
+    bool lastUpdateRebuilt = false;
+
+    // BLAS를 모두 빌드하고 TLAS 입력 (빈 mesh를 가리키지 않는 instance)을 정함
+    // TLAS는 다음 updateInstances에서 빌드
+    void build(const Scene& scene, TaskPool& pool);
+
+    // transforms = scene.instances 순서의 object → world 변환
+    // rebuild = false면 트리 구조를 유지하고 AABB만 refit (움직임이 커지면 품질이 떨어짐)
+    void updateInstances(const std::vector<glm::mat4>& transforms, bool rebuild, TaskPool& pool);
+
+private:
+    struct BlasRange {
+        uint32_t nodeFirst = 0;
+        uint32_t nodeEnd = 0;
+        uint32_t primitiveFirst = 0;
+        uint32_t primitiveCount = 0;
+        Aabb bounds;  // object space 루트 AABB
+    };
+
+    std::vector<BlasRange> blases;         // mesh 순서
+    std::vector<uint32_t> tlasInputs;      // TLAS 입력 인덱스 → scene instance
+    std::vector<uint32_t> inputMeshes;     // TLAS 입력 인덱스 → mesh
+    std::vector<uint32_t> inputMaterials;
+    std::vector<Aabb> worldBounds;         // TLAS 입력 순서
+};
+
+} // namespace rt
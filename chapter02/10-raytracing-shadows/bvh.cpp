@@ -0,0 +1,281 @@
+#include "bvh.h"
+#include "scene.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+namespace rt {
+
+namespace {
+
+constexpr int BIN_COUNT = 16;
+constexpr float TRAVERSAL_COST = 1.0f;
+constexpr float INTERSECTION_COST = 1.0f;
+constexpr uint32_t PARALLEL_THRESHOLD = 1024;  // 이보다 큰 서브트리는 별도 작업
+constexpr uint32_t MAX_DEPTH = 64;             // 넘으면 SAH 대신 중앙값 분할
+
+// 빌드 중 트리 (자식 인덱스), 끝나면 DFS로 평탄화
+struct BuildNode {
+    Aabb bounds;
+    uint32_t left = 0;
+    uint32_t right = 0;
+    uint32_t first = 0;  // 리프: refs 범위
+    uint32_t count = 0;  // 0 = 내부 노드
+};
+
+struct BuildContext {
+    const std::vector<Aabb>& bounds;
+    std::vector<glm::vec3> centroids;
+    std::vector<uint32_t> refs;
+    std::vector<BuildNode> nodes;  // 최대 2N - 1개 미리 할당 → 작업 간 재할당 없음
+    std::atomic<uint32_t> nodeCount{1};
+    TaskPool& pool;
+
+    BuildContext(const std::vector<Aabb>& b, TaskPool& p) : bounds(b), pool(p) {}
+};
+
+struct Split {
+    int axis = -1;
+    int bin = 0;
+    float cost = FLT_MAX;
+};
+
+struct Bin {
+    Aabb bounds;
+    uint32_t count = 0;
+};
+
+int binIndex(float c, float lo, float scale) {
+    return std::min(BIN_COUNT - 1, static_cast<int>((c - lo) * scale));
+}
+
+Split findBestSplit(const BuildContext& ctx, uint32_t begin, uint32_t end,
+                    const Aabb& bounds, const Aabb& centroidBounds) {
+    Split best;
+    float invParentArea = 1.0f / std::max(bounds.surfaceArea(), 1e-12f);
+
+    for (int axis = 0; axis < 3; axis++) {
+        float lo = centroidBounds.min[axis];
+        float extent = centroidBounds.max[axis] - lo;
+        if (extent <= 0.0f) {
+            continue;
+        }
+        float scale = BIN_COUNT / extent;
+
+        Bin bins[BIN_COUNT];
+        for (uint32_t i = begin; i < end; i++) {
+            uint32_t ref = ctx.refs[i];
+            Bin& bin = bins[binIndex(ctx.centroids[ref][axis], lo, scale)];
+            bin.bounds.grow(ctx.bounds[ref]);
+            bin.count++;
+        }
+
+        // 오른쪽에서 왼쪽으로 누적 → 각 분할 위치의 오른쪽 면적 * 개수
+        float rightCost[BIN_COUNT];
+        Aabb rightBounds;
+        uint32_t rightCount = 0;
+        for (int b = BIN_COUNT - 1; b > 0; b--) {
+            rightBounds.grow(bins[b].bounds);
+            rightCount += bins[b].count;
+            rightCost[b] = rightBounds.surfaceArea() * rightCount;
+        }
+
+        Aabb leftBounds;
+        uint32_t leftCount = 0;
+        for (int b = 0; b < BIN_COUNT - 1; b++) {
+            leftBounds.grow(bins[b].bounds);
+            leftCount += bins[b].count;
+            if (leftCount == 0 || leftCount == end - begin) {
+                continue;
+            }
+            float cost = TRAVERSAL_COST + INTERSECTION_COST *
+                (leftBounds.surfaceArea() * leftCount + rightCost[b + 1]) * invParentArea;
+            if (cost < best.cost) {
+                best.axis = axis;
+                best.bin = b;
+                best.cost = cost;
+            }
+        }
+    }
+    return best;
+}
+
+void buildRecursive(BuildContext& ctx, uint32_t nodeIndex, uint32_t begin, uint32_t end, uint32_t depth) {
+    BuildNode& node = ctx.nodes[nodeIndex];
+
+    Aabb centroidBounds;
+    for (uint32_t i = begin; i < end; i++) {
+        uint32_t ref = ctx.refs[i];
+        node.bounds.grow(ctx.bounds[ref]);
+        centroidBounds.grow(ctx.centroids[ref]);
+    }
+
+    uint32_t count = end - begin;
+    if (count == 1) {
+        node.first = begin;
+        node.count = count;
+        return;
+    }
+
+    Split split;
+    if (depth < MAX_DEPTH) {
+        split = findBestSplit(ctx, begin, end, node.bounds, centroidBounds);
+    }
+
+    float leafCost = INTERSECTION_COST * count;
+    if (count <= BVH_MAX_LEAF_SIZE && (split.axis < 0 || leafCost <= split.cost)) {
+        node.first = begin;
+        node.count = count;
+        return;
+    }
+
+    auto first = ctx.refs.begin() + begin;
+    auto last = ctx.refs.begin() + end;
+    uint32_t mid = begin;
+    if (split.axis >= 0) {
+        int axis = split.axis;
+        float lo = centroidBounds.min[axis];
+        float scale = BIN_COUNT / (centroidBounds.max[axis] - lo);
+        mid = static_cast<uint32_t>(std::partition(first, last, [&](uint32_t ref) {
+            return binIndex(ctx.centroids[ref][axis], lo, scale) <= split.bin;
+        }) - ctx.refs.begin());
+    }
+
+    if (mid == begin || mid == end) {
+        // 중심이 모두 같거나 깊이 제한: 가장 긴 축의 중앙값으로 반씩
+        glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+        int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        mid = begin + count / 2;
+        std::nth_element(first, ctx.refs.begin() + mid, last, [&](uint32_t a, uint32_t b) {
+            return ctx.centroids[a][axis] < ctx.centroids[b][axis];
+        });
+    }
+
+    uint32_t left = ctx.nodeCount.fetch_add(2);
+    node.left = left;
+    node.right = left + 1;
+
+    if (end - mid >= PARALLEL_THRESHOLD && mid - begin >= PARALLEL_THRESHOLD) {
+        ctx.pool.submit([&ctx, left, mid, end, depth] {
+            buildRecursive(ctx, left + 1, mid, end, depth + 1);
+        });
+    } else {
+        buildRecursive(ctx, left + 1, mid, end, depth + 1);
+    }
+    buildRecursive(ctx, left, begin, mid, depth + 1);
+}
+
+void flatten(const BuildContext& ctx, uint32_t buildIndex, uint32_t depth, Bvh& bvh, float invRootArea) {
+    const BuildNode& node = ctx.nodes[buildIndex];
+    uint32_t index = static_cast<uint32_t>(bvh.nodes.size());
+
+    BvhNode flat{};
+    flat.boundsMin = node.bounds.min;
+    flat.boundsMax = node.bounds.max;
+    bvh.nodes.push_back(flat);
+
+    BvhStats& stats = bvh.stats;
+    stats.maxDepth = std::max(stats.maxDepth, depth);
+    float relativeArea = node.bounds.surfaceArea() * invRootArea;
+
+    if (node.count > 0) {
+        uint32_t first = static_cast<uint32_t>(bvh.primitiveOrder.size());
+        for (uint32_t i = 0; i < node.count; i++) {
+            bvh.primitiveOrder.push_back(ctx.refs[node.first + i]);
+        }
+        bvh.nodes[index].primitiveInfo = (first << BVH_LEAF_COUNT_BITS) | node.count;
+        stats.leafCount++;
+        stats.sahCost += INTERSECTION_COST * node.count * relativeArea;
+    } else {
+        flatten(ctx, node.left, depth + 1, bvh, invRootArea);
+        flatten(ctx, node.right, depth + 1, bvh, invRootArea);
+        stats.sahCost += TRAVERSAL_COST * relativeArea;
+    }
+
+    bvh.nodes[index].missIndex = static_cast<uint32_t>(bvh.nodes.size());
+}
+
+} // namespace
+
+bool isBounded(const Primitive& primitive) {
+    return primitive.type != PRIMITIVE_PLANE;
+}
+
+Aabb primitiveBounds(const Primitive& primitive) {
+    Aabb bounds;
+    switch (primitive.type) {
+    case PRIMITIVE_SPHERE:
+        bounds.grow(primitive.p0 - glm::vec3(primitive.param));
+        bounds.grow(primitive.p0 + glm::vec3(primitive.param));
+        break;
+    case PRIMITIVE_TRIANGLE:
+        bounds.grow(primitive.p0);
+        bounds.grow(primitive.p1);
+        bounds.grow(primitive.p2);
+        break;
+    case PRIMITIVE_BOX:
+    case PRIMITIVE_MESH_TRIANGLE:  // 정점 대신 미리 계산한 AABB
+        bounds.grow(primitive.p0);
+        bounds.grow(primitive.p1);
+        break;
+    default:
+        break;  // 평면: 빈 AABB
+    }
+    return bounds;
+}
+
+Bvh buildBvh(const std::vector<Aabb>& bounds, TaskPool& pool) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Bvh bvh;
+    uint32_t count = static_cast<uint32_t>(bounds.size());
+    if (count == 0) {
+        return bvh;
+    }
+
+    BuildContext ctx(bounds, pool);
+    ctx.centroids.resize(count);
+    ctx.refs.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        ctx.centroids[i] = bounds[i].center();
+        ctx.refs[i] = i;
+    }
+    ctx.nodes.resize(2 * static_cast<size_t>(count) - 1);
+
+    buildRecursive(ctx, 0, 0, count, 0);
+    pool.wait();
+
+    uint32_t nodeCount = ctx.nodeCount.load();
+    bvh.nodes.reserve(nodeCount);
+    bvh.primitiveOrder.reserve(count);
+    flatten(ctx, 0, 0, bvh, 1.0f / std::max(ctx.nodes[0].bounds.surfaceArea(), 1e-12f));
+
+    auto end = std::chrono::high_resolution_clock::now();
+    bvh.stats.buildMs = std::chrono::duration<double, std::milli>(end - start).count();
+    bvh.stats.threadCount = pool.threadCount();
+    bvh.stats.nodeCount = nodeCount;
+    bvh.stats.averageLeafSize = static_cast<float>(count) / bvh.stats.leafCount;
+    return bvh;
+}
+
+void refitBvh(Bvh& bvh, const std::vector<Aabb>& bounds) {
+    for (size_t i = bvh.nodes.size(); i-- > 0;) {
+        BvhNode& node = bvh.nodes[i];
+        Aabb box;
+        if (node.isLeaf()) {
+            for (uint32_t k = 0; k < node.primitiveCount(); k++) {
+                box.grow(bounds[bvh.primitiveOrder[node.firstPrimitive() + k]]);
+            }
+        } else {
+            const BvhNode& left = bvh.nodes[i + 1];
+            const BvhNode& right = bvh.nodes[left.missIndex];
+            box.min = glm::min(left.boundsMin, right.boundsMin);
+            box.max = glm::max(left.boundsMax, right.boundsMax);
+        }
+        node.boundsMin = box.min;
+        node.boundsMax = box.max;
+    }
+}
+
+} // namespace rt
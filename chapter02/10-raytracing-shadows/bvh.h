@@ -0,0 +1,93 @@
+#pragma once
+
+/**
+ * Binned SAH BVH (CPU 빌드, raytrace.comp와 같은 평탄화 레이아웃)
+ *
+ * 노드 32 byte, 깊이 우선 (DFS preorder) 순서
+ * - 내부 노드의 왼쪽 자식 = index + 1, 오른쪽 자식 = 왼쪽 자식의 missIndex
+ * - missIndex = 서브트리 바로 다음 노드 → AABB를 놓치거나 리프를 검사한 뒤 이동 (스택 없는 순회)
+ * - 순회는 index == nodeCount에서 끝남
+ *
+ * 빌더는 AABB 배열만 받으므로 primitive BVH와 instance BVH (TLAS)에 같이 사용
+ */
+
+#include "task_pool.h"
+
+#include <glm/glm.hpp>
+
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+
+namespace rt {
+
+struct Primitive;
+
+constexpr uint32_t BVH_LEAF_COUNT_BITS = 4;
+constexpr uint32_t BVH_LEAF_COUNT_MASK = (1u << BVH_LEAF_COUNT_BITS) - 1;
+constexpr uint32_t BVH_MAX_LEAF_SIZE = 8;  // 리프 primitive 수 상한 (<= BVH_LEAF_COUNT_MASK)
+
+struct BvhNode {
+    glm::vec3 boundsMin;
+    uint32_t missIndex;
+    glm::vec3 boundsMax;
+    uint32_t primitiveInfo;  // 리프: (first << 4) | count, 내부 노드: 0
+
+    bool isLeaf() const { return (primitiveInfo & BVH_LEAF_COUNT_MASK) != 0; }
+    uint32_t firstPrimitive() const { return primitiveInfo >> BVH_LEAF_COUNT_BITS; }
+    uint32_t primitiveCount() const { return primitiveInfo & BVH_LEAF_COUNT_MASK; }
+};
+static_assert(sizeof(BvhNode) == 32, "BvhNode must match raytrace.comp (std430)");
+
+struct Aabb {
+    glm::vec3 min = glm::vec3(FLT_MAX);
+    glm::vec3 max = glm::vec3(-FLT_MAX);
+
+    void grow(const glm::vec3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    void grow(const Aabb& b) {
+        min = glm::min(min, b.min);
+        max = glm::max(max, b.max);
+    }
+    bool valid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+    float surfaceArea() const {
+        if (!valid()) {
+            return 0.0f;
+        }
+        glm::vec3 e = max - min;
+        return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+};
+
+struct BvhStats {
+    double buildMs = 0.0;
+    unsigned threadCount = 0;
+    uint32_t nodeCount = 0;
+    uint32_t leafCount = 0;
+    uint32_t maxDepth = 0;
+    float averageLeafSize = 0.0f;
+    // SAH 비용 (traversal = 1, 교차 = 1, 루트 면적으로 정규화): 광선당 예상 작업량
+    float sahCost = 0.0f;
+};
+
+struct Bvh {
+    std::vector<BvhNode> nodes;
+    std::vector<uint32_t> primitiveOrder;  // 리프 순서 → 입력 AABB 인덱스
+    BvhStats stats;
+};
+
+// 평면은 무한 → 유계가 아님 (BVH 밖에서 따로 검사)
+bool isBounded(const Primitive& primitive);
+Aabb primitiveBounds(const Primitive& primitive);
+
+// 서브트리가 충분히 크면 pool에 작업으로 나눠 빌드 (결과는 스레드 수와 무관하게 같음)
+Bvh buildBvh(const std::vector<Aabb>& bounds, TaskPool& pool);
+
+// 트리 구조는 그대로 두고 AABB만 아래에서 위로 다시 계산 (bounds는 입력 순서)
+// 역 DFS 순서 = 자식이 항상 부모보다 먼저
+void refitBvh(Bvh& bvh, const std::vector<Aabb>& bounds);
+
+} // namespace rt
@@ -0,0 +1,1167 @@
+#include "cpu_tracer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define RT_CPU_TRACER_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang: 이 함수들만 AVX2로 컴파일 (실행 여부는 런타임 CPU 검사로 결정)
+// MSVC는 target 지정 없이 intrinsic 사용 가능
+#if defined(RT_CPU_TRACER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define RT_AVX2 __attribute__((target("avx2")))
+#else
+#define RT_AVX2
+#endif
+
+namespace rt {
+
+namespace {
+
+// raytrace.comp와 같은 상수
+constexpr float T_MIN = 0.001f;
+constexpr float T_MISS = 1e10f;
+constexpr uint32_t NO_INSTANCE = 0xFFFFFFFFu;
+
+constexpr uint32_t TILE_SIZE = 16;      // 셰이더 local_size와 같음
+constexpr uint32_t PACKET_WIDTH = 4;    // packet = 4x2 픽셀
+constexpr uint32_t PACKET_HEIGHT = 2;
+constexpr uint32_t PACKET_SIZE = PACKET_WIDTH * PACKET_HEIGHT;
+
+struct Ray {
+    glm::vec3 origin;
+    glm::vec3 direction;
+};
+
+// 광선 8개 (SoA), t = 입력 tMax / 출력 가장 가까운 교차 거리
+struct RayPacket {
+    alignas(32) float origin[3][PACKET_SIZE] = {};
+    alignas(32) float direction[3][PACKET_SIZE] = {};
+    alignas(32) float t[PACKET_SIZE] = {};
+    alignas(32) uint32_t primitive[PACKET_SIZE] = {};
+    alignas(32) uint32_t instance[PACKET_SIZE] = {};
+    uint32_t active = 0;  // 추적할 lane 비트
+    uint32_t hit = 0;     // 출력: tMax보다 가까운 교차를 찾은 lane 비트
+
+    void set(uint32_t lane, const Ray& ray, float tMax) {
+        for (int axis = 0; axis < 3; axis++) {
+            origin[axis][lane] = ray.origin[axis];
+            direction[axis][lane] = ray.direction[axis];
+        }
+        t[lane] = tMax;
+        active |= 1u << lane;
+    }
+
+    Ray ray(uint32_t lane) const {
+        return {glm::vec3(origin[0][lane], origin[1][lane], origin[2][lane]),
+                glm::vec3(direction[0][lane], direction[1][lane], direction[2][lane])};
+    }
+};
+
+// raytrace.comp의 Camera (원점을 바라봄)
+struct Camera {
+    glm::vec3 position;
+    glm::vec3 forward;
+    glm::vec3 right;
+    glm::vec3 up;
+    float tanHalfFov;
+    float aspect;
+};
+
+struct TraceContext {
+    const AccelerationStructure& accel;
+    const Scene& scene;  // 재질 / 텍스처 / mesh 정점 (primitive는 accel의 BLAS 순서)
+    const RayTracePushConstants& pc;
+    Camera camera;
+    uint32_t width;
+    uint32_t height;
+    TracePath path;
+};
+
+// 스레드별 카운터 (false sharing 방지)
+struct alignas(64) WorkerStats {
+    uint64_t primaryRays = 0;
+    uint64_t totalRays = 0;
+    uint32_t stolenTiles = 0;
+};
+
+// ============================================================================
+// 스칼라 교차 (raytrace.comp와 같은 식, 같은 연산 순서)
+// ============================================================================
+
+// mat4 * vec4(p, 1) / mat3(m) * v, AVX2 경로와 같은 덧셈 순서
+glm::vec3 transformPoint(const glm::mat4& m, const glm::vec3& p) {
+    return glm::vec3(m[0]) * p.x + glm::vec3(m[1]) * p.y + glm::vec3(m[2]) * p.z + glm::vec3(m[3]);
+}
+
+glm::vec3 transformVector(const glm::mat4& m, const glm::vec3& v) {
+    return glm::vec3(m[0]) * v.x + glm::vec3(m[1]) * v.y + glm::vec3(m[2]) * v.z;
+}
+
+bool hitAabb(const glm::vec3& origin, const glm::vec3& invDir, const glm::vec3& boundsMin,
+             const glm::vec3& boundsMax, float tMax) {
+    glm::vec3 t0 = (boundsMin - origin) * invDir;
+    glm::vec3 t1 = (boundsMax - origin) * invDir;
+    glm::vec3 tSmall = glm::min(t0, t1);
+    glm::vec3 tLarge = glm::max(t0, t1);
+    float tNear = std::max(std::max(tSmall.x, tSmall.y), tSmall.z);
+    float tFar = std::min(std::min(tLarge.x, tLarge.y), tLarge.z);
+    return tNear <= tFar && tFar > T_MIN && tNear < tMax;
+}
+
+float intersectSphere(const Ray& ray, const glm::vec3& center, float radius) {
+    glm::vec3 oc = ray.origin - center;
+    float a = glm::dot(ray.direction, ray.direction);
+    float b = 2.0f * glm::dot(oc, ray.direction);
+    float c = glm::dot(oc, oc) - radius * radius;
+
+    float discriminant = b * b - 4.0f * a * c;
+    if (discriminant > 0.0f) {
+        float t = (-b - std::sqrt(discriminant)) / (2.0f * a);
+        if (t > T_MIN) {
+            return t;
+        }
+    }
+    return T_MISS;
+}
+
+float intersectPlane(const Ray& ray, const glm::vec3& normal, float offset) {
+    float denom = glm::dot(normal, ray.direction);
+    if (std::abs(denom) > 0.001f) {
+        float t = (offset - glm::dot(normal, ray.origin)) / denom;
+        if (t > T_MIN) {
+            return t;
+        }
+    }
+    return T_MISS;
+}
+
+// watertight (Woop, Benthin, Wald 2013): 광선 방향의 가장 큰 축 kz를 z로 두고 전단한 2D 모서리 함수
+// 양면이므로 kx / ky 순서 (감기 방향)는 맞추지 않음, 0 경계의 double 재계산은 생략 (raytrace.comp와 같음)
+float intersectTriangle(const Ray& ray, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2) {
+    glm::vec3 ad = glm::abs(ray.direction);
+    int kz = ad.x > ad.y ? (ad.x > ad.z ? 0 : 2) : (ad.y > ad.z ? 1 : 2);
+    int kx = kz == 2 ? 0 : kz + 1;
+    int ky = kx == 2 ? 0 : kx + 1;
+    float sz = 1.0f / ray.direction[kz];
+    float sx = ray.direction[kx] * sz;
+    float sy = ray.direction[ky] * sz;
+
+    glm::vec3 a = v0 - ray.origin;
+    glm::vec3 b = v1 - ray.origin;
+    glm::vec3 c = v2 - ray.origin;
+    float ax = a[kx] - sx * a[kz];
+    float ay = a[ky] - sy * a[kz];
+    float bx = b[kx] - sx * b[kz];
+    float by = b[ky] - sy * b[kz];
+    float cx = c[kx] - sx * c[kz];
+    float cy = c[ky] - sy * c[kz];
+
+    float u = cx * by - cy * bx;
+    float v = ax * cy - ay * cx;
+    float w = bx * ay - by * ax;
+    if ((u < 0.0f || v < 0.0f || w < 0.0f) && (u > 0.0f || v > 0.0f || w > 0.0f)) {
+        return T_MISS;
+    }
+    float det = u + v + w;
+    if (det == 0.0f) {
+        return T_MISS;
+    }
+
+    float t = (u * (sz * a[kz]) + v * (sz * b[kz]) + w * (sz * c[kz])) / det;
+    return t > T_MIN ? t : T_MISS;
+}
+
+// PRIMITIVE_MESH_TRIANGLE의 정점 번호 3개
+const uint32_t* meshTriangle(const TraceContext& ctx, const Primitive& prim) {
+    return &ctx.scene.triangleIndices[size_t(meshTriangleIndex(prim)) * 3];
+}
+
+glm::vec3 meshPosition(const TraceContext& ctx, uint32_t vertex) {
+    return glm::vec3(ctx.scene.vertexPositions[vertex]);
+}
+
+float intersectBox(const Ray& ray, const glm::vec3& boxMin, const glm::vec3& boxMax) {
+    glm::vec3 invDir = 1.0f / ray.direction;
+    glm::vec3 t0 = (boxMin - ray.origin) * invDir;
+    glm::vec3 t1 = (boxMax - ray.origin) * invDir;
+    glm::vec3 tSmall = glm::min(t0, t1);
+    glm::vec3 tLarge = glm::max(t0, t1);
+    float tNear = std::max(std::max(tSmall.x, tSmall.y), tSmall.z);
+    float tFar = std::min(std::min(tLarge.x, tLarge.y), tLarge.z);
+
+    if (tNear > tFar || tFar <= T_MIN) {
+        return T_MISS;
+    }
+    return tNear > T_MIN ? tNear : tFar;
+}
+
+float intersectPrimitive(const TraceContext& ctx, const Ray& ray, const Primitive& prim) {
+    if (prim.type == PRIMITIVE_SPHERE) {
+        return intersectSphere(ray, prim.p0, prim.param);
+    } else if (prim.type == PRIMITIVE_PLANE) {
+        return intersectPlane(ray, prim.p0, prim.param);
+    } else if (prim.type == PRIMITIVE_TRIANGLE) {
+        return intersectTriangle(ray, prim.p0, prim.p1, prim.p2);
+    } else if (prim.type == PRIMITIVE_MESH_TRIANGLE) {
+        const uint32_t* tri = meshTriangle(ctx, prim);
+        return intersectTriangle(ray, meshPosition(ctx, tri[0]), meshPosition(ctx, tri[1]), meshPosition(ctx, tri[2]));
+    }
+    return intersectBox(ray, prim.p0, prim.p1);
+}
+
+float signOf(float x) {
+    return x > 0.0f ? 1.0f : (x < 0.0f ? -1.0f : 0.0f);
+}
+
+glm::vec3 primitiveNormal(const TraceContext& ctx, const Primitive& prim, const glm::vec3& point) {
+    if (prim.type == PRIMITIVE_SPHERE) {
+        return glm::normalize(point - prim.p0);
+    } else if (prim.type == PRIMITIVE_PLANE) {
+        return prim.p0;
+    } else if (prim.type == PRIMITIVE_TRIANGLE) {
+        return glm::normalize(glm::cross(prim.p1 - prim.p0, prim.p2 - prim.p0));
+    } else if (prim.type == PRIMITIVE_MESH_TRIANGLE) {
+        const uint32_t* tri = meshTriangle(ctx, prim);
+        glm::vec3 v0 = meshPosition(ctx, tri[0]);
+        return glm::normalize(glm::cross(meshPosition(ctx, tri[1]) - v0, meshPosition(ctx, tri[2]) - v0));
+    }
+
+    glm::vec3 center = (prim.p0 + prim.p1) * 0.5f;
+    glm::vec3 local = (point - center) / glm::max((prim.p1 - prim.p0) * 0.5f, glm::vec3(1e-6f));
+    glm::vec3 a = glm::abs(local);
+    if (a.x >= a.y && a.x >= a.z) {
+        return glm::vec3(signOf(local.x), 0.0f, 0.0f);
+    } else if (a.y >= a.z) {
+        return glm::vec3(0.0f, signOf(local.y), 0.0f);
+    }
+    return glm::vec3(0.0f, 0.0f, signOf(local.z));
+}
+
+// primitives[first, first + count)를 검사, anyHit이면 첫 교차에서 true
+bool testPrimitives(const TraceContext& ctx, const Ray& ray, uint32_t first, uint32_t count,
+                    uint32_t instanceIndex, bool anyHit, float& tClosest, uint32_t& closestPrim,
+                    uint32_t& closestInstance) {
+    for (uint32_t i = first; i < first + count; i++) {
+        float t = intersectPrimitive(ctx, ray, ctx.accel.primitives[i]);
+        if (t < tClosest) {
+            tClosest = t;
+            closestPrim = i;
+            closestInstance = instanceIndex;
+            if (anyHit) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool traverseInstance(const TraceContext& ctx, const Ray& ray, uint32_t instanceIndex, bool anyHit,
+                      float& tClosest, uint32_t& closestPrim, uint32_t& closestInstance) {
+    const GpuInstance& instance = ctx.accel.instances[instanceIndex];
+    Ray local{transformPoint(instance.worldToObject, ray.origin),
+              transformVector(instance.worldToObject, ray.direction)};
+
+    if (ctx.pc.useBvh == 0) {
+        return testPrimitives(ctx, local, instance.primitiveFirst, instance.primitiveCount, instanceIndex,
+                              anyHit, tClosest, closestPrim, closestInstance);
+    }
+
+    glm::vec3 invDir = 1.0f / local.direction;
+    uint32_t nodeIndex = instance.nodeFirst;
+    while (nodeIndex < instance.nodeEnd) {
+        const BvhNode& node = ctx.accel.blasNodes[nodeIndex];
+        if (!hitAabb(local.origin, invDir, node.boundsMin, node.boundsMax, tClosest)) {
+            nodeIndex = node.missIndex;
+            continue;
+        }
+        if (!node.isLeaf()) {
+            nodeIndex++;
+            continue;
+        }
+        if (testPrimitives(ctx, local, node.firstPrimitive(), node.primitiveCount(), instanceIndex,
+                           anyHit, tClosest, closestPrim, closestInstance)) {
+            return true;
+        }
+        nodeIndex = node.missIndex;
+    }
+    return false;
+}
+
+// raytrace.comp의 traverse (평면 → TLAS → instance별 BLAS)
+bool traverse(const TraceContext& ctx, const Ray& ray, bool anyHit, float& tClosest,
+              uint32_t& closestPrim, uint32_t& closestInstance) {
+    closestPrim = 0;
+    closestInstance = NO_INSTANCE;
+    float tStart = tClosest;
+
+    if (testPrimitives(ctx, ray, ctx.pc.planeFirst, ctx.pc.planeCount, NO_INSTANCE, anyHit,
+                       tClosest, closestPrim, closestInstance)) {
+        return true;
+    }
+
+    if (ctx.pc.useBvh == 0) {
+        for (uint32_t i = 0; i < ctx.pc.instanceCount; i++) {
+            if (traverseInstance(ctx, ray, i, anyHit, tClosest, closestPrim, closestInstance)) {
+                return true;
+            }
+        }
+        return tClosest < tStart;
+    }
+
+    const std::vector<BvhNode>& tlas = ctx.accel.tlas.nodes;
+    glm::vec3 invDir = 1.0f / ray.direction;
+    uint32_t nodeIndex = 0;
+    while (nodeIndex < ctx.pc.tlasNodeCount) {
+        const BvhNode& node = tlas[nodeIndex];
+        if (!hitAabb(ray.origin, invDir, node.boundsMin, node.boundsMax, tClosest)) {
+            nodeIndex = node.missIndex;
+            continue;
+        }
+        if (!node.isLeaf()) {
+            nodeIndex++;
+            continue;
+        }
+        uint32_t first = node.firstPrimitive();
+        for (uint32_t i = first; i < first + node.primitiveCount(); i++) {
+            if (traverseInstance(ctx, ray, i, anyHit, tClosest, closestPrim, closestInstance)) {
+                return true;
+            }
+        }
+        nodeIndex = node.missIndex;
+    }
+    return tClosest < tStart;
+}
+
+// ============================================================================
+// AVX2 packet 순회
+// ============================================================================
+// lane마다 tClosest가 다름 → 노드는 살아 있는 lane 중 하나라도 AABB에 맞으면 내려감
+// 맞지 않은 lane도 리프 primitive를 검사하지만 t < tClosest 비교라 결과는 스칼라와 같음
+// min / max는 glm (y < x ? y : x)과 NaN 처리가 같도록 피연산자 순서를 뒤집어 호출
+
+#ifdef RT_CPU_TRACER_X86
+bool detectAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // OS가 YMM 레지스터를 저장하는지 (OSXSAVE + XCR0의 SSE/AVX 비트)
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+struct Vec8 {
+    __m256 x, y, z;
+};
+
+RT_AVX2 inline __m256 min8(__m256 a, __m256 b) {
+    return _mm256_min_ps(b, a);
+}
+
+RT_AVX2 inline __m256 max8(__m256 a, __m256 b) {
+    return _mm256_max_ps(b, a);
+}
+
+RT_AVX2 inline Vec8 broadcast8(const glm::vec3& v) {
+    return {_mm256_set1_ps(v.x), _mm256_set1_ps(v.y), _mm256_set1_ps(v.z)};
+}
+
+RT_AVX2 inline Vec8 sub8(const Vec8& a, const Vec8& b) {
+    return {_mm256_sub_ps(a.x, b.x), _mm256_sub_ps(a.y, b.y), _mm256_sub_ps(a.z, b.z)};
+}
+
+RT_AVX2 inline Vec8 mul8(const Vec8& a, const Vec8& b) {
+    return {_mm256_mul_ps(a.x, b.x), _mm256_mul_ps(a.y, b.y), _mm256_mul_ps(a.z, b.z)};
+}
+
+RT_AVX2 inline __m256 dot8(const Vec8& a, const Vec8& b) {
+    return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a.x, b.x), _mm256_mul_ps(a.y, b.y)),
+                         _mm256_mul_ps(a.z, b.z));
+}
+
+RT_AVX2 inline Vec8 cross8(const Vec8& a, const Vec8& b) {
+    return {_mm256_sub_ps(_mm256_mul_ps(a.y, b.z), _mm256_mul_ps(b.y, a.z)),
+            _mm256_sub_ps(_mm256_mul_ps(a.z, b.x), _mm256_mul_ps(b.z, a.x)),
+            _mm256_sub_ps(_mm256_mul_ps(a.x, b.y), _mm256_mul_ps(b.x, a.y))};
+}
+
+RT_AVX2 inline __m256 abs8(__m256 a) {
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);
+}
+
+RT_AVX2 inline __m256 lt8(__m256 a, __m256 b) {
+    return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+}
+
+RT_AVX2 inline __m256 gt8(__m256 a, __m256 b) {
+    return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+}
+
+RT_AVX2 inline __m256 laneMask8(uint32_t bits) {
+    __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i selected = _mm256_and_si256(_mm256_set1_epi32(static_cast<int32_t>(bits)), lanes);
+    return _mm256_castsi256_ps(_mm256_cmpeq_epi32(selected, lanes));
+}
+
+// 교차하지 않은 lane은 T_MISS (스칼라 함수와 같은 판정 순서)
+RT_AVX2 inline __m256 missOr8(__m256 valid, __m256 t) {
+    return _mm256_blendv_ps(_mm256_set1_ps(T_MISS), t, valid);
+}
+
+RT_AVX2 inline Vec8 transformPoint8(const glm::mat4& m, const Vec8& p) {
+    Vec8 r;
+    __m256* out[3] = {&r.x, &r.y, &r.z};
+    for (int row = 0; row < 3; row++) {
+        __m256 v = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[0][row]), p.x),
+                                 _mm256_mul_ps(_mm256_set1_ps(m[1][row]), p.y));
+        v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_set1_ps(m[2][row]), p.z));
+        *out[row] = _mm256_add_ps(v, _mm256_set1_ps(m[3][row]));
+    }
+    return r;
+}
+
+RT_AVX2 inline Vec8 transformVector8(const glm::mat4& m, const Vec8& d) {
+    Vec8 r;
+    __m256* out[3] = {&r.x, &r.y, &r.z};
+    for (int row = 0; row < 3; row++) {
+        __m256 v = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[0][row]), d.x),
+                                 _mm256_mul_ps(_mm256_set1_ps(m[1][row]), d.y));
+        *out[row] = _mm256_add_ps(v, _mm256_mul_ps(_mm256_set1_ps(m[2][row]), d.z));
+    }
+    return r;
+}
+
+RT_AVX2 inline Vec8 reciprocal8(const Vec8& d) {
+    __m256 one = _mm256_set1_ps(1.0f);
+    return {_mm256_div_ps(one, d.x), _mm256_div_ps(one, d.y), _mm256_div_ps(one, d.z)};
+}
+
+// slab 테스트 → (tNear, tFar)
+RT_AVX2 inline void slab8(const Vec8& origin, const Vec8& invDir, const glm::vec3& boundsMin,
+                          const glm::vec3& boundsMax, __m256& tNear, __m256& tFar) {
+    Vec8 t0 = mul8(sub8(broadcast8(boundsMin), origin), invDir);
+    Vec8 t1 = mul8(sub8(broadcast8(boundsMax), origin), invDir);
+    tNear = max8(max8(min8(t0.x, t1.x), min8(t0.y, t1.y)), min8(t0.z, t1.z));
+    tFar = min8(min8(max8(t0.x, t1.x), max8(t0.y, t1.y)), max8(t0.z, t1.z));
+}
+
+RT_AVX2 inline __m256 hitAabb8(const Vec8& origin, const Vec8& invDir, const glm::vec3& boundsMin,
+                               const glm::vec3& boundsMax, __m256 tMax) {
+    __m256 tNear, tFar;
+    slab8(origin, invDir, boundsMin, boundsMax, tNear, tFar);
+    __m256 hit = _mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ);
+    hit = _mm256_and_ps(hit, gt8(tFar, _mm256_set1_ps(T_MIN)));
+    return _mm256_and_ps(hit, lt8(tNear, tMax));
+}
+
+RT_AVX2 __m256 intersectSphere8(const Vec8& origin, const Vec8& direction, const glm::vec3& center, float radius) {
+    Vec8 oc = sub8(origin, broadcast8(center));
+    __m256 a = dot8(direction, direction);
+    __m256 b = _mm256_mul_ps(_mm256_set1_ps(2.0f), dot8(oc, direction));
+    __m256 c = _mm256_sub_ps(dot8(oc, oc), _mm256_set1_ps(radius * radius));
+
+    __m256 discriminant = _mm256_sub_ps(_mm256_mul_ps(b, b),
+                                        _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(4.0f), a), c));
+    __m256 negB = _mm256_xor_ps(b, _mm256_set1_ps(-0.0f));
+    __m256 numerator = _mm256_sub_ps(negB, _mm256_sqrt_ps(discriminant));
+    __m256 t = _mm256_div_ps(numerator, _mm256_mul_ps(_mm256_set1_ps(2.0f), a));
+    __m256 valid = _mm256_and_ps(gt8(discriminant, _mm256_setzero_ps()), gt8(t, _mm256_set1_ps(T_MIN)));
+    return missOr8(valid, t);
+}
+
+RT_AVX2 __m256 intersectPlane8(const Vec8& origin, const Vec8& direction, const glm::vec3& normal, float offset) {
+    Vec8 n = broadcast8(normal);
+    __m256 denom = dot8(n, direction);
+    __m256 t = _mm256_div_ps(_mm256_sub_ps(_mm256_set1_ps(offset), dot8(n, origin)), denom);
+    __m256 valid = _mm256_and_ps(gt8(abs8(denom), _mm256_set1_ps(0.001f)), gt8(t, _mm256_set1_ps(T_MIN)));
+    return missOr8(valid, t);
+}
+
+// 광선 (lane)마다 kz가 다름 → 성분을 lane별로 고름 (isX = kz가 x, isY = kz가 y, 나머지 = z)
+struct AxisSelect8 {
+    __m256 isX;
+    __m256 isY;
+};
+
+RT_AVX2 inline __m256 pickKz8(const AxisSelect8& axis, const Vec8& v) {
+    return _mm256_blendv_ps(_mm256_blendv_ps(v.z, v.y, axis.isY), v.x, axis.isX);
+}
+
+RT_AVX2 inline __m256 pickKx8(const AxisSelect8& axis, const Vec8& v) {
+    return _mm256_blendv_ps(_mm256_blendv_ps(v.x, v.z, axis.isY), v.y, axis.isX);
+}
+
+RT_AVX2 inline __m256 pickKy8(const AxisSelect8& axis, const Vec8& v) {
+    return _mm256_blendv_ps(_mm256_blendv_ps(v.y, v.x, axis.isY), v.z, axis.isX);
+}
+
+RT_AVX2 __m256 intersectTriangle8(const Vec8& origin, const Vec8& direction,
+                                  const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2) {
+    __m256 adx = abs8(direction.x);
+    __m256 ady = abs8(direction.y);
+    __m256 adz = abs8(direction.z);
+    __m256 xGreaterY = gt8(adx, ady);
+    AxisSelect8 axis{_mm256_and_ps(xGreaterY, gt8(adx, adz)), _mm256_andnot_ps(xGreaterY, gt8(ady, adz))};
+    __m256 sz = _mm256_div_ps(_mm256_set1_ps(1.0f), pickKz8(axis, direction));
+    __m256 sx = _mm256_mul_ps(pickKx8(axis, direction), sz);
+    __m256 sy = _mm256_mul_ps(pickKy8(axis, direction), sz);
+
+    Vec8 a = sub8(broadcast8(v0), origin);
+    Vec8 b = sub8(broadcast8(v1), origin);
+    Vec8 c = sub8(broadcast8(v2), origin);
+    __m256 az = pickKz8(axis, a);
+    __m256 bz = pickKz8(axis, b);
+    __m256 cz = pickKz8(axis, c);
+    __m256 ax = _mm256_sub_ps(pickKx8(axis, a), _mm256_mul_ps(sx, az));
+    __m256 ay = _mm256_sub_ps(pickKy8(axis, a), _mm256_mul_ps(sy, az));
+    __m256 bx = _mm256_sub_ps(pickKx8(axis, b), _mm256_mul_ps(sx, bz));
+    __m256 by = _mm256_sub_ps(pickKy8(axis, b), _mm256_mul_ps(sy, bz));
+    __m256 cx = _mm256_sub_ps(pickKx8(axis, c), _mm256_mul_ps(sx, cz));
+    __m256 cy = _mm256_sub_ps(pickKy8(axis, c), _mm256_mul_ps(sy, cz));
+
+    __m256 u = _mm256_sub_ps(_mm256_mul_ps(cx, by), _mm256_mul_ps(cy, bx));
+    __m256 v = _mm256_sub_ps(_mm256_mul_ps(ax, cy), _mm256_mul_ps(ay, cx));
+    __m256 w = _mm256_sub_ps(_mm256_mul_ps(bx, ay), _mm256_mul_ps(by, ax));
+    __m256 det = _mm256_add_ps(_mm256_add_ps(u, v), w);
+    __m256 numerator = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(u, _mm256_mul_ps(sz, az)),
+                                                   _mm256_mul_ps(v, _mm256_mul_ps(sz, bz))),
+                                     _mm256_mul_ps(w, _mm256_mul_ps(sz, cz)));
+    __m256 t = _mm256_div_ps(numerator, det);
+
+    // 스칼라와 같은 판정: 모서리 함수 부호가 섞임 / det = 0 / t <= T_MIN
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 anyNegative = _mm256_or_ps(_mm256_or_ps(lt8(u, zero), lt8(v, zero)), lt8(w, zero));
+    __m256 anyPositive = _mm256_or_ps(_mm256_or_ps(gt8(u, zero), gt8(v, zero)), gt8(w, zero));
+    __m256 reject = _mm256_or_ps(_mm256_and_ps(anyNegative, anyPositive), _mm256_cmp_ps(det, zero, _CMP_EQ_OQ));
+    __m256 valid = _mm256_andnot_ps(reject, gt8(t, _mm256_set1_ps(T_MIN)));
+    return missOr8(valid, t);
+}
+
+RT_AVX2 __m256 intersectBox8(const Vec8& origin, const Vec8& invDir, const glm::vec3& boxMin, const glm::vec3& boxMax) {
+    __m256 tNear, tFar;
+    slab8(origin, invDir, boxMin, boxMax, tNear, tFar);
+
+    const __m256 tMin = _mm256_set1_ps(T_MIN);
+    __m256 reject = _mm256_or_ps(gt8(tNear, tFar), _mm256_cmp_ps(tFar, tMin, _CMP_LE_OQ));
+    __m256 t = _mm256_blendv_ps(tFar, tNear, gt8(tNear, tMin));
+    return _mm256_blendv_ps(t, _mm256_set1_ps(T_MISS), reject);
+}
+
+RT_AVX2 inline __m256 intersectPrimitive8(const TraceContext& ctx, const Vec8& origin, const Vec8& direction,
+                                          const Vec8& invDir, const Primitive& prim) {
+    if (prim.type == PRIMITIVE_SPHERE) {
+        return intersectSphere8(origin, direction, prim.p0, prim.param);
+    } else if (prim.type == PRIMITIVE_PLANE) {
+        return intersectPlane8(origin, direction, prim.p0, prim.param);
+    } else if (prim.type == PRIMITIVE_TRIANGLE) {
+        return intersectTriangle8(origin, direction, prim.p0, prim.p1, prim.p2);
+    } else if (prim.type == PRIMITIVE_MESH_TRIANGLE) {
+        const uint32_t* tri = meshTriangle(ctx, prim);
+        return intersectTriangle8(origin, direction, meshPosition(ctx, tri[0]), meshPosition(ctx, tri[1]),
+                                  meshPosition(ctx, tri[2]));
+    }
+    return intersectBox8(origin, invDir, prim.p0, prim.p1);
+}
+
+// 순회 중 lane별 상태 (레지스터)
+struct PacketState {
+    Vec8 origin;
+    Vec8 direction;
+    Vec8 invDir;
+    __m256 tClosest;
+    __m256i closestPrim;
+    __m256i closestInstance;
+    __m256 active;  // 아직 검색 중인 lane (anyHit이면 교차를 찾은 lane은 빠짐)
+};
+
+// anyHit에서 모든 lane이 끝났으면 true
+RT_AVX2 bool testPrimitives8(const TraceContext& ctx, const Vec8& origin, const Vec8& direction,
+                             const Vec8& invDir, uint32_t first, uint32_t count, uint32_t instanceIndex,
+                             bool anyHit, PacketState& state) {
+    for (uint32_t i = first; i < first + count; i++) {
+        __m256 t = intersectPrimitive8(ctx, origin, direction, invDir, ctx.accel.primitives[i]);
+        __m256 closer = _mm256_and_ps(lt8(t, state.tClosest), state.active);
+        if (_mm256_movemask_ps(closer) == 0) {
+            continue;
+        }
+
+        __m256i closerBits = _mm256_castps_si256(closer);
+        state.tClosest = _mm256_blendv_ps(state.tClosest, t, closer);
+        state.closestPrim = _mm256_blendv_epi8(state.closestPrim,
+                                               _mm256_set1_epi32(static_cast<int32_t>(i)), closerBits);
+        state.closestInstance = _mm256_blendv_epi8(state.closestInstance,
+                                                   _mm256_set1_epi32(static_cast<int32_t>(instanceIndex)),
+                                                   closerBits);
+        if (anyHit) {
+            state.active = _mm256_andnot_ps(closer, state.active);
+            if (_mm256_movemask_ps(state.active) == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+RT_AVX2 bool traverseInstance8(const TraceContext& ctx, uint32_t instanceIndex, bool anyHit, PacketState& state) {
+    const GpuInstance& instance = ctx.accel.instances[instanceIndex];
+    Vec8 origin = transformPoint8(instance.worldToObject, state.origin);
+    Vec8 direction = transformVector8(instance.worldToObject, state.direction);
+    Vec8 invDir = reciprocal8(direction);
+
+    if (ctx.pc.useBvh == 0) {
+        return testPrimitives8(ctx, origin, direction, invDir, instance.primitiveFirst, instance.primitiveCount,
+                               instanceIndex, anyHit, state);
+    }
+
+    uint32_t nodeIndex = instance.nodeFirst;
+    while (nodeIndex < instance.nodeEnd) {
+        const BvhNode& node = ctx.accel.blasNodes[nodeIndex];
+        __m256 hit = _mm256_and_ps(hitAabb8(origin, invDir, node.boundsMin, node.boundsMax, state.tClosest),
+                                   state.active);
+        if (_mm256_movemask_ps(hit) == 0) {
+            nodeIndex = node.missIndex;
+            continue;
+        }
+        if (!node.isLeaf()) {
+            nodeIndex++;
+            continue;
+        }
+        if (testPrimitives8(ctx, origin, direction, invDir, node.firstPrimitive(), node.primitiveCount(),
+                            instanceIndex, anyHit, state)) {
+            return true;
+        }
+        nodeIndex = node.missIndex;
+    }
+    return false;
+}
+
+// 평면 → TLAS → instance별 BLAS, anyHit에서 모든 lane이 끝났으면 true
+RT_AVX2 bool traverseWorld8(const TraceContext& ctx, bool anyHit, PacketState& state) {
+    if (testPrimitives8(ctx, state.origin, state.direction, state.invDir, ctx.pc.planeFirst, ctx.pc.planeCount,
+                        NO_INSTANCE, anyHit, state)) {
+        return true;
+    }
+
+    if (ctx.pc.useBvh == 0) {
+        for (uint32_t i = 0; i < ctx.pc.instanceCount; i++) {
+            if (traverseInstance8(ctx, i, anyHit, state)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const std::vector<BvhNode>& tlas = ctx.accel.tlas.nodes;
+    uint32_t nodeIndex = 0;
+    while (nodeIndex < ctx.pc.tlasNodeCount) {
+        const BvhNode& node = tlas[nodeIndex];
+        __m256 hit = _mm256_and_ps(hitAabb8(state.origin, state.invDir, node.boundsMin, node.boundsMax,
+                                            state.tClosest), state.active);
+        if (_mm256_movemask_ps(hit) == 0) {
+            nodeIndex = node.missIndex;
+            continue;
+        }
+        if (!node.isLeaf()) {
+            nodeIndex++;
+            continue;
+        }
+        uint32_t first = node.firstPrimitive();
+        for (uint32_t i = first; i < first + node.primitiveCount(); i++) {
+            if (traverseInstance8(ctx, i, anyHit, state)) {
+                return true;
+            }
+        }
+        nodeIndex = node.missIndex;
+    }
+    return false;
+}
+
+RT_AVX2 void traversePacketAvx2(const TraceContext& ctx, RayPacket& packet, bool anyHit) {
+    PacketState state;
+    state.origin = {_mm256_load_ps(packet.origin[0]), _mm256_load_ps(packet.origin[1]),
+                    _mm256_load_ps(packet.origin[2])};
+    state.direction = {_mm256_load_ps(packet.direction[0]), _mm256_load_ps(packet.direction[1]),
+                       _mm256_load_ps(packet.direction[2])};
+    state.invDir = reciprocal8(state.direction);
+    state.tClosest = _mm256_load_ps(packet.t);
+    state.closestPrim = _mm256_setzero_si256();
+    state.closestInstance = _mm256_set1_epi32(static_cast<int32_t>(NO_INSTANCE));
+    state.active = laneMask8(packet.active);
+    __m256 tStart = state.tClosest;
+
+    traverseWorld8(ctx, anyHit, state);
+
+    packet.hit = static_cast<uint32_t>(_mm256_movemask_ps(lt8(state.tClosest, tStart))) & packet.active;
+    _mm256_store_ps(packet.t, state.tClosest);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(packet.primitive), state.closestPrim);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(packet.instance), state.closestInstance);
+}
+#endif
+
+bool avx2Supported() {
+#ifdef RT_CPU_TRACER_X86
+    static const bool supported = detectAvx2();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// packet.active lane을 추적해 t / primitive / instance / hit을 채움
+void tracePacket(const TraceContext& ctx, RayPacket& packet, bool anyHit, WorkerStats& stats) {
+    stats.totalRays += static_cast<uint64_t>(std::popcount(packet.active));
+    packet.hit = 0;
+    if (packet.active == 0) {
+        return;
+    }
+
+#ifdef RT_CPU_TRACER_X86
+    if (ctx.path == TracePath::Avx2) {
+        traversePacketAvx2(ctx, packet, anyHit);
+        return;
+    }
+#endif
+
+    for (uint32_t lane = 0; lane < PACKET_SIZE; lane++) {
+        if ((packet.active & (1u << lane)) == 0) {
+            continue;
+        }
+        if (traverse(ctx, packet.ray(lane), anyHit, packet.t[lane], packet.primitive[lane], packet.instance[lane])) {
+            packet.hit |= 1u << lane;
+        }
+    }
+}
+
+// ============================================================================
+// 셰이딩 (lane별 스칼라, raytrace.comp의 traceScene / shade)
+// ============================================================================
+
+struct Surface {
+    glm::vec3 point;
+    glm::vec3 normal;
+    glm::vec3 color;
+    float shininess;
+    float reflectivity;
+};
+
+float glslMod(float x, float y) {
+    return x - y * std::floor(x / y);
+}
+
+// 교차 지점의 무게중심 좌표로 정점 노말 / uv 보간 (object space, raytrace.comp의 interpolateMesh)
+void interpolateMesh(const TraceContext& ctx, const Primitive& prim, const glm::vec3& point, glm::vec3& normal,
+                     glm::vec2& uv) {
+    const uint32_t* tri = meshTriangle(ctx, prim);
+    glm::vec3 v0 = meshPosition(ctx, tri[0]);
+    glm::vec3 e1 = meshPosition(ctx, tri[1]) - v0;
+    glm::vec3 e2 = meshPosition(ctx, tri[2]) - v0;
+    glm::vec3 d = point - v0;
+    float d11 = glm::dot(e1, e1);
+    float d12 = glm::dot(e1, e2);
+    float d22 = glm::dot(e2, e2);
+    float dp1 = glm::dot(d, e1);
+    float dp2 = glm::dot(d, e2);
+    float denom = d11 * d22 - d12 * d12;
+    float b1 = (d22 * dp1 - d12 * dp2) / denom;
+    float b2 = (d11 * dp2 - d12 * dp1) / denom;
+    float b0 = 1.0f - b1 - b2;
+
+    const std::vector<glm::vec4>& normals = ctx.scene.vertexNormals;
+    const std::vector<glm::vec2>& uvs = ctx.scene.vertexUvs;
+    normal = glm::normalize(b0 * glm::vec3(normals[tri[0]]) + b1 * glm::vec3(normals[tri[1]]) +
+                            b2 * glm::vec3(normals[tri[2]]));
+    uv = b0 * uvs[tri[0]] + b1 * uvs[tri[1]] + b2 * uvs[tri[2]];
+}
+
+// VK_FILTER_LINEAR + REPEAT, mip 0 (UNORM → [0, 1])
+glm::vec3 sampleTexture(const Texture& texture, const glm::vec2& uv) {
+    auto texel = [&](int x, int y) {
+        x = (x % static_cast<int>(texture.width) + static_cast<int>(texture.width)) % static_cast<int>(texture.width);
+        y = (y % static_cast<int>(texture.height) + static_cast<int>(texture.height)) % static_cast<int>(texture.height);
+        const uint8_t* p = &texture.rgba[(size_t(y) * texture.width + x) * 4];
+        return glm::vec3(p[0], p[1], p[2]) / 255.0f;
+    };
+
+    // 큰 uv에서 정수 변환이 넘치지 않도록 [0, 1)로 먼저 감음
+    float x = (uv.x - std::floor(uv.x)) * static_cast<float>(texture.width) - 0.5f;
+    float y = (uv.y - std::floor(uv.y)) * static_cast<float>(texture.height) - 0.5f;
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+    int x0 = static_cast<int>(fx);
+    int y0 = static_cast<int>(fy);
+    glm::vec3 top = glm::mix(texel(x0, y0), texel(x0 + 1, y0), x - fx);
+    glm::vec3 bottom = glm::mix(texel(x0, y0 + 1), texel(x0 + 1, y0 + 1), x - fx);
+    return glm::mix(top, bottom, y - fy);
+}
+
+Surface resolveSurface(const TraceContext& ctx, const Ray& ray, float t, uint32_t primIndex, uint32_t instanceIndex) {
+    const Primitive& prim = ctx.accel.primitives[primIndex];
+    uint32_t materialIndex = prim.material;
+    bool meshHit = false;
+    glm::vec3 shadingNormal(0.0f);
+    glm::vec2 uv(0.0f);
+
+    Surface surface;
+    surface.point = ray.origin + t * ray.direction;
+    if (instanceIndex == NO_INSTANCE) {
+        surface.normal = primitiveNormal(ctx, prim, surface.point);
+    } else {
+        const GpuInstance& instance = ctx.accel.instances[instanceIndex];
+        const glm::mat4& m = instance.worldToObject;
+        glm::vec3 localPoint = transformPoint(m, surface.point);
+        // transpose(mat3(worldToObject)) * n
+        auto normalToWorld = [&](const glm::vec3& n) {
+            return glm::normalize(glm::vec3(glm::dot(glm::vec3(m[0]), n), glm::dot(glm::vec3(m[1]), n),
+                                            glm::dot(glm::vec3(m[2]), n)));
+        };
+        surface.normal = normalToWorld(primitiveNormal(ctx, prim, localPoint));
+        if (prim.type == PRIMITIVE_MESH_TRIANGLE) {
+            glm::vec3 localNormal;
+            interpolateMesh(ctx, prim, localPoint, localNormal, uv);
+            shadingNormal = normalToWorld(localNormal);
+            meshHit = true;
+        }
+        if (instance.material != MATERIAL_FROM_MESH) {
+            materialIndex = instance.material;
+        }
+    }
+    const Material& material = ctx.scene.materials[materialIndex];
+    if (glm::dot(surface.normal, ray.direction) > 0.0f) {
+        surface.normal = -surface.normal;
+    }
+    if (meshHit) {
+        surface.normal = glm::dot(shadingNormal, surface.normal) < 0.0f ? -shadingNormal : shadingNormal;
+    }
+
+    surface.color = material.color;
+    if (material.pattern == PATTERN_CHECKER) {
+        float u = surface.point.x * material.patternScale;
+        float v = surface.point.z * material.patternScale;
+        bool checker = glslMod(std::floor(u) + std::floor(v), 2.0f) < 1.0f;
+        surface.color = checker ? material.color : material.color2;
+    }
+    if (meshHit && material.textureIndex != NO_TEXTURE) {
+        surface.color *= sampleTexture(ctx.scene.textures[material.textureIndex], uv);
+    }
+    surface.shininess = material.shininess;
+    surface.reflectivity = material.reflectivity;
+    return surface;
+}
+
+glm::vec3 shade(const TraceContext& ctx, const Surface& hit, const glm::vec3& viewDir, float shadow) {
+    glm::vec3 lightPos(ctx.pc.lightPos);
+    glm::vec3 lightDir = glm::normalize(lightPos - hit.point);
+    float intensity = ctx.pc.lightPos.w;
+
+    glm::vec3 ambient = 0.15f * hit.color;
+
+    float diff = std::max(glm::dot(hit.normal, lightDir), 0.0f);
+    glm::vec3 diffuse = diff * hit.color * intensity;
+
+    glm::vec3 halfDir = glm::normalize(lightDir + viewDir);
+    float spec = std::pow(std::max(glm::dot(hit.normal, halfDir), 0.0f), hit.shininess);
+    glm::vec3 specular = spec * glm::vec3(1.0f) * intensity;
+
+    return ambient + shadow * (diffuse + specular);
+}
+
+// rays를 closest-hit으로 추적하고 교차한 lane의 표면 / 직접광 (그림자 광선 packet 포함)을 계산
+// 반환 = 교차한 lane 비트
+uint32_t traceAndShade(const TraceContext& ctx, RayPacket& rays, Surface surfaces[PACKET_SIZE],
+                       glm::vec3 colors[PACKET_SIZE], WorkerStats& stats) {
+    tracePacket(ctx, rays, false, stats);
+    uint32_t hit = rays.hit;
+
+    RayPacket shadowRays;
+    float shadow[PACKET_SIZE];
+    glm::vec3 lightPos(ctx.pc.lightPos);
+    for (uint32_t lane = 0; lane < PACKET_SIZE; lane++) {
+        shadow[lane] = 1.0f;
+        if ((hit & (1u << lane)) == 0) {
+            continue;
+        }
+        surfaces[lane] = resolveSurface(ctx, rays.ray(lane), rays.t[lane], rays.primitive[lane], rays.instance[lane]);
+        if (ctx.pc.showShadows != 0) {
+            glm::vec3 lightDir = glm::normalize(lightPos - surfaces[lane].point);
+            float lightDist = glm::length(lightPos - surfaces[lane].point);
+            shadowRays.set(lane, {surfaces[lane].point + lightDir * 0.01f, lightDir}, lightDist - 0.01f);
+        }
+    }
+
+    // 가장 가까운 교차가 아니라 광원 앞의 교차 여부만 필요 → any-hit
+    tracePacket(ctx, shadowRays, true, stats);
+    for (uint32_t lane = 0; lane < PACKET_SIZE; lane++) {
+        if ((shadowRays.hit & (1u << lane)) != 0) {
+            shadow[lane] = ctx.pc.shadowIntensity;
+        }
+        if ((hit & (1u << lane)) != 0) {
+            colors[lane] = shade(ctx, surfaces[lane], -rays.ray(lane).direction, shadow[lane]);
+        }
+    }
+    return hit;
+}
+
+glm::vec3 cameraRayDir(const Camera& camera, float px, float py, uint32_t width, uint32_t height) {
+    float u = px / static_cast<float>(width) * 2.0f - 1.0f;
+    float v = py / static_cast<float>(height) * 2.0f - 1.0f;
+    u *= camera.aspect;
+    return glm::normalize(camera.forward + (u * camera.right + v * camera.up) * camera.tanHalfFov);
+}
+
+uint8_t toUnorm8(float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// 4x2 픽셀 packet 하나 (주 광선 → 그림자 → 반사 → 반사 지점 그림자)
+void renderPacket(const TraceContext& ctx, uint32_t x0, uint32_t y0, std::vector<uint8_t>& rgba,
+                  WorkerStats& stats) {
+    RayPacket primary;
+    for (uint32_t lane = 0; lane < PACKET_SIZE; lane++) {
+        uint32_t x = x0 + lane % PACKET_WIDTH;
+        uint32_t y = y0 + lane / PACKET_WIDTH;
+        if (x < ctx.width && y < ctx.height) {
+            glm::vec3 dir = cameraRayDir(ctx.camera, static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f,
+                                         ctx.width, ctx.height);
+            primary.set(lane, {ctx.camera.position, dir}, T_MISS);
+        }
+    }
+    stats.primaryRays += static_cast<uint64_t>(std::popcount(primary.active));
+
+    Surface surfaces[PACKET_SIZE];
+    glm::vec3 colors[PACKET_SIZE];
+    uint32_t hit = traceAndShade(ctx, primary, surfaces, colors, stats);
+
+    // 단순 반사 (1번만, reflectivity 비율로 섞음, 반사 광선이 놓치면 원래 색 유지)
+    if (ctx.pc.reflections != 0) {
+        RayPacket reflected;
+        for (uint32_t lane = 0; lane < PACKET_SIZE; lane++) {
+            if ((hit & (1u << lane)) != 0 && surfaces[lane].reflectivity > 0.0f) {
+                glm::vec3 dir = primary.ray(lane).direction;
+                glm::vec3 n = surfaces[lane].normal;
+                glm::vec3 reflectDir = dir - 2.0f * glm::dot(n, dir) * n;
+                reflected.set(lane, {surfaces[lane].point + n * 0.01f, reflectDir}, T_MISS);
+            }
+        }
+
+        Surface reflectSurfaces[PACKET_SIZE];
+        glm::vec3 reflectColors[PACKET_SIZE];
+        uint32_t reflectHit = traceAndShade(ctx, reflected, reflectSurfaces, reflectColors, stats);
+        for (uint32_t lane = 0; lane < PACKET_SIZE; lane++) {
+            if ((reflectHit & (1u << lane)) != 0) {
+                float r = surfaces[lane].reflectivity;
+                colors[lane] = colors[lane] * (1.0f - r) + reflectColors[lane] * r;
+            }
+        }
+    }
+
+    for (uint32_t lane = 0; lane < PACKET_SIZE; lane++) {
+        if ((primary.active & (1u << lane)) == 0) {
+            continue;
+        }
+        if ((hit & (1u << lane)) == 0) {
+            // 배경 (그라데이션 하늘)
+            float t = 0.5f * (primary.direction[1][lane] + 1.0f);
+            colors[lane] = glm::vec3(1.0f) * (1.0f - t) + glm::vec3(0.5f, 0.7f, 1.0f) * t;
+        }
+
+        // 누적 리셋 프레임: accumulated = color → 감마 보정 → rgba8
+        size_t offset = (size_t(y0 + lane / PACKET_WIDTH) * ctx.width + x0 + lane % PACKET_WIDTH) * 4;
+        for (int c = 0; c < 3; c++) {
+            rgba[offset + c] = toUnorm8(std::pow(colors[lane][c], 1.0f / 2.2f));
+        }
+        rgba[offset + 3] = 255;
+    }
+}
+
+void renderTile(const TraceContext& ctx, uint32_t tile, uint32_t tilesX, std::vector<uint8_t>& rgba,
+                WorkerStats& stats) {
+    uint32_t x0 = (tile % tilesX) * TILE_SIZE;
+    uint32_t y0 = (tile / tilesX) * TILE_SIZE;
+    uint32_t x1 = std::min(x0 + TILE_SIZE, ctx.width);
+    uint32_t y1 = std::min(y0 + TILE_SIZE, ctx.height);
+    for (uint32_t y = y0; y < y1; y += PACKET_HEIGHT) {
+        for (uint32_t x = x0; x < x1; x += PACKET_WIDTH) {
+            renderPacket(ctx, x, y, rgba, stats);
+        }
+    }
+}
+
+// 스레드 하나의 남은 타일 구간 [next, end)
+// 주인은 앞에서 꺼내고, 도둑은 뒤쪽 절반을 가져감
+struct TileRange {
+    std::mutex mutex;
+    uint32_t next = 0;
+    uint32_t end = 0;
+};
+
+// 남은 타일이 가장 많은 스레드에서 절반을 훔쳐 self에 넣음, 훔칠 것이 없으면 false
+bool stealTiles(std::vector<TileRange>& ranges, uint32_t self, WorkerStats& stats) {
+    while (true) {
+        uint32_t victim = self;
+        uint32_t most = 0;
+        for (uint32_t i = 0; i < ranges.size(); i++) {
+            if (i == self) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(ranges[i].mutex);
+            uint32_t remaining = ranges[i].end - ranges[i].next;
+            if (remaining > most) {
+                most = remaining;
+                victim = i;
+            }
+        }
+        if (victim == self) {
+            return false;
+        }
+
+        uint32_t first, end;
+        {
+            std::lock_guard<std::mutex> lock(ranges[victim].mutex);
+            uint32_t remaining = ranges[victim].end - ranges[victim].next;
+            if (remaining == 0) {
+                continue;  // 그 사이 다 처리됨 → 다시 고름
+            }
+            end = ranges[victim].end;
+            first = end - (remaining + 1) / 2;
+            ranges[victim].end = first;
+        }
+
+        std::lock_guard<std::mutex> lock(ranges[self].mutex);
+        ranges[self].next = first;
+        ranges[self].end = end;
+        stats.stolenTiles += end - first;
+        return true;
+    }
+}
+
+void traceWorker(const TraceContext& ctx, std::vector<TileRange>& ranges, uint32_t self, uint32_t tilesX,
+                 std::vector<uint8_t>& rgba, WorkerStats& stats) {
+    while (true) {
+        uint32_t tile;
+        {
+            std::lock_guard<std::mutex> lock(ranges[self].mutex);
+            if (ranges[self].next < ranges[self].end) {
+                tile = ranges[self].next++;
+            } else {
+                tile = UINT32_MAX;
+            }
+        }
+        if (tile == UINT32_MAX) {
+            if (!stealTiles(ranges, self, stats)) {
+                return;
+            }
+            continue;
+        }
+        renderTile(ctx, tile, tilesX, rgba, stats);
+    }
+}
+
+Camera makeCamera(const glm::vec4& positionFov, uint32_t width, uint32_t height) {
+    Camera camera;
+    camera.position = glm::vec3(positionFov);
+    camera.forward = glm::normalize(glm::vec3(0.0f) - camera.position);
+    camera.right = glm::normalize(glm::cross(camera.forward, glm::vec3(0.0f, 1.0f, 0.0f)));
+    camera.up = glm::cross(camera.right, camera.forward);
+    camera.tanHalfFov = std::tan(positionFov.w * 0.5f);
+    camera.aspect = static_cast<float>(width) / static_cast<float>(height);
+    return camera;
+}
+
+} // namespace
+
+TracePath bestTracePath() {
+    return avx2Supported() ? TracePath::Avx2 : TracePath::Scalar;
+}
+
+const char* tracePathName(TracePath path) {
+    return path == TracePath::Avx2 ? "AVX2" : "scalar";
+}
+
+CpuTraceStats traceImage(const AccelerationStructure& accel, const Scene& scene, const RayTracePushConstants& pc,
+                         uint32_t width, uint32_t height, TaskPool& pool, std::vector<uint8_t>& rgba, TracePath path) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (path == TracePath::Avx2 && !avx2Supported()) {
+        path = TracePath::Scalar;
+    }
+    TraceContext ctx{accel, scene, pc, makeCamera(pc.cameraPos, width, height), width, height, path};
+    rgba.assign(size_t(width) * height * 4, 0);
+
+    uint32_t tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    uint32_t tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    uint32_t tileCount = tilesX * tilesY;
+
+    // 스레드마다 행 우선 순서의 연속 구간 (이웃 타일끼리 BVH 노드를 공유해 캐시에 유리)
+    unsigned threadCount = pool.threadCount();
+    std::vector<TileRange> ranges(threadCount);
+    std::vector<WorkerStats> workerStats(threadCount);
+    for (unsigned i = 0; i < threadCount; i++) {
+        ranges[i].next = static_cast<uint32_t>(uint64_t(tileCount) * i / threadCount);
+        ranges[i].end = static_cast<uint32_t>(uint64_t(tileCount) * (i + 1) / threadCount);
+    }
+    for (unsigned i = 0; i < threadCount; i++) {
+        pool.submit([&, i]() { traceWorker(ctx, ranges, i, tilesX, rgba, workerStats[i]); });
+    }
+    pool.wait();
+
+    CpuTraceStats stats;
+    stats.threadCount = threadCount;
+    stats.tileCount = tileCount;
+    for (const WorkerStats& worker : workerStats) {
+        stats.primaryRays += worker.primaryRays;
+        stats.totalRays += worker.totalRays;
+        stats.stolenTiles += worker.stolenTiles;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    stats.ms = std::chrono::duration<double, std::milli>(end - start).count();
+    return stats;
+}
+
+bool writePpm(const std::string& path, uint32_t width, uint32_t height, const std::vector<uint8_t>& rgba) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file << "P6\n" << width << " " << height << "\n255\n";
+
+    // 이미지 행 0 = 화면 아래 (fullscreen.frag가 y를 뒤집어 표시) → 파일은 화면과 같은 방향으로
+    std::vector<uint8_t> rgb(size_t(width) * height * 3);
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t* src = rgba.data() + size_t(height - 1 - y) * width * 4;
+        uint8_t* dst = rgb.data() + size_t(y) * width * 3;
+        for (uint32_t x = 0; x < width; x++) {
+            dst[x * 3 + 0] = src[x * 4 + 0];
+            dst[x * 3 + 1] = src[x * 4 + 1];
+            dst[x * 3 + 2] = src[x * 4 + 2];
+        }
+    }
+    file.write(reinterpret_cast<const char*>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+    return file.good();
+}
+
+} // namespace rt
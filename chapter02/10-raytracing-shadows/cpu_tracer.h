@@ -0,0 +1,59 @@
+#pragma once
+
+/**
+ * CPU 레퍼런스 레이 트레이서 (GPU 없이 검증 / 벤치마크)
+ *
+ * raytrace.comp와 같은 입력을 그대로 사용
+ * - 장면: AccelerationStructure의 primitive / BLAS / TLAS / instance 배열,
+ *   Scene의 재질 / 텍스처 / 인덱스 mesh 정점 배열
+ * - 카메라 / 조명 / 토글: RayTracePushConstants
+ * → 같은 교차 / 셰이딩 식으로 누적 리셋 프레임 (픽셀 중심 1 샘플)과 같은 RGBA8 이미지를 만듦
+ *
+ * 순회는 8개 광선 묶음 (4x2 픽셀 packet) 단위
+ * - x86에서 AVX2를 지원하면 노드 AABB / primitive를 8 lane으로 한 번에 검사
+ *   (lane 하나라도 맞으면 내려가는 스택 없는 packet 순회)
+ * - 비지원 CPU는 같은 묶음을 광선마다 스칼라로 순회
+ *
+ * 병렬화: 16x16 타일 (셰이더 work group과 같은 크기)을 스레드마다 연속 구간으로 나누고,
+ * 자기 구간을 다 쓴 스레드는 남은 타일이 가장 많은 스레드의 뒤쪽 절반을 훔쳐 감 (work stealing)
+ */
+
+#include "acceleration.h"
+#include "task_pool.h"
+#include "trace_params.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rt {
+
+enum class TracePath {
+    Scalar,
+    Avx2
+};
+
+// 이 CPU에서 쓸 수 있는 가장 빠른 경로
+TracePath bestTracePath();
+const char* tracePathName(TracePath path);
+
+struct CpuTraceStats {
+    double ms = 0.0;
+    unsigned threadCount = 0;
+    uint64_t primaryRays = 0;
+    uint64_t totalRays = 0;      // 주 + 그림자 + 반사 (+ 반사 지점의 그림자)
+    uint32_t tileCount = 0;
+    uint32_t stolenTiles = 0;    // 다른 스레드 구간에서 가져온 타일 수
+};
+
+// width x height RGBA8 (감마 보정, GPU의 rgba8 출력과 같은 변환)
+// pc의 누적 필드 (historyMode / jitter / maxSamples), 경로 추적 필드 (renderMode / maxBounces),
+// 해상도 / 가변 밀도 필드 (renderWidth / renderHeight / variableRate)는 무시하고 Whitted 픽셀 중심 1 샘플
+CpuTraceStats traceImage(const AccelerationStructure& accel, const Scene& scene, const RayTracePushConstants& pc,
+                         uint32_t width, uint32_t height, TaskPool& pool, std::vector<uint8_t>& rgba,
+                         TracePath path = bestTracePath());
+
+// 바이너리 PPM (P6), RGBA8에서 alpha는 버리고 화면에 보이는 방향으로 (행 순서 뒤집음)
+bool writePpm(const std::string& path, uint32_t width, uint32_t height, const std::vector<uint8_t>& rgba);
+
+} // namespace rt
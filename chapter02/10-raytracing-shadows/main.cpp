@@ -5,7 +5,14 @@
  * 하드웨어 RT 없이도 Ray Tracing 개념 학습 가능
  *
  * 학습 목표:
- * - 광선-오브젝트 교차 (Ray-Sphere, Ray-Plane)
+ * - 광선-오브젝트 교차 (구, 평면, 삼각형, 박스, watertight 인덱스 삼각형 mesh + 텍스처, OBJ 로드)
+ * - 데이터 기반 장면 (primitive / material storage buffer)
+ * - SAH BVH 가속 구조 (멀티스레드 빌드, 스택 없는 GPU 순회)
+ * - 같은 장면 버퍼를 쓰는 CPU 레퍼런스 트레이서 (AVX2 packet, --compare로 GPU 결과 검증)
+ * - 경로 추적: megakernel vs wavefront (광선 큐 + indirect dispatch, --path-benchmark로 비교)
+ * - 2차 광선 정렬 (방향 8분면 + 원점 Morton 코드 counting sort)과 subgroup traversal SIMD 효율 측정
+ * - Edge-avoiding à-trous 잡음 제거 (albedo / 노말 / 깊이 보조 이미지, 시간 분산)
+ * - 동적 해상도 (GPU 시간 → 추적 영역 크기) + edge-aware 확대, 평탄한 타일의 가변 밀도 추적
  * - 그림자 광선 (Shadow Rays)
  * - Phong 조명 모델
  * - 반사 (Reflection)
@@ -25,6 +32,12 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "acceleration.h"
+#include "cpu_tracer.h"
+#include "scene.h"
+#include "task_pool.h"
+#include "trace_params.h"
+
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -32,9 +45,13 @@
 #include <set>
 #include <stdexcept>
 #include <cstring>
+#include <cstddef>
 #include <cstdint>
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
 
 // ============================================================================
 // Constants
@@ -44,6 +61,34 @@ const uint32_t HEIGHT = 600;
 const uint32_t RT_WIDTH = 512;   // Ray trace render target size
 const uint32_t RT_HEIGHT = 384;
 const int MAX_FRAMES_IN_FLIGHT = 2;
+const int MAX_DEFAULT_SAMPLES = 256;     // 누적 상한 기본값 (넘으면 지수 이동 평균)
+const int MAX_RANDOM_OBJECTS = 4096;      // 성능 측정용 무작위 오브젝트 상한 (UI 슬라이더)
+const uint32_t RANDOM_SCENE_SEED = 1234;
+const glm::vec3 LOADED_MESH_POSITION = glm::vec3(-1.8f, 0.0f, 2.8f);  // --mesh: 바닥 중심 위치
+const float LOADED_MESH_SIZE = 1.5f;                                  // 가장 긴 변 (월드 단위)
+
+// GPU ↔ CPU 레퍼런스 비교 (--compare): 채널 오차가 허용치를 넘는 픽셀이 이 비율 이하면 통과
+// 같은 식이라도 GPU의 sqrt / pow / 나눗셈 정밀도와 FMA 때문에 경계 픽셀 몇 개는 다른 primitive를 맞힐 수 있음
+const int CPU_COMPARE_CHANNEL_TOLERANCE = 2;          // rgba8 단위
+const double CPU_COMPARE_MAX_MISMATCH_RATIO = 0.005;
+const int CPU_BENCHMARK_RUNS = 3;                     // 스레드 수마다 가장 빠른 실행을 보고
+
+// 경로 추적 megakernel ↔ wavefront ↔ 정렬한 wavefront 비교 (--path-benchmark): 튕김 횟수마다 가장 빠른 프레임을 보고
+// 세 구현은 같은 난수를 쓰므로 이미지도 비교 (다른 pipeline의 FMA 차이로 갈라지는 경로 몇 개만 허용)
+const std::array<uint32_t, 5> PATH_BENCHMARK_BOUNCES = {0, 1, 2, 4, 8};
+const int PATH_BENCHMARK_FRAMES = 16;
+const double PATH_COMPARE_MAX_MISMATCH_RATIO = 0.01;
+const int DEFAULT_PATH_BOUNCES = 2;
+const int MAX_DENOISE_ITERATIONS = 5;   // à-trous 탭 간격 1, 2, 4, 8, 16 → 지름 최대 125 픽셀
+const uint32_t TIMESTAMPS_PER_FRAME = 3; // 시작, ray trace 끝, 잡음 제거 끝
+
+// 동적 해상도: 측정한 GPU 시간 (ray trace + 잡음 제거)이 목표에 맞도록 추적 영역의 가로 / 세로 배율을 조절
+// 비용 ∝ 픽셀 수 = 배율² → 새 배율 = 측정 배율 × √(목표 / 측정), 바뀔 때마다 누적이 리셋되므로 작은 변화는 무시
+const float DEFAULT_TARGET_GPU_MS = 4.0f;
+const float MIN_RENDER_SCALE = 0.5f;
+const float RENDER_SCALE_HYSTERESIS = 0.05f;  // 상대 변화가 이보다 작으면 유지
+const float RENDER_SCALE_DAMPING = 0.5f;      // 목표까지의 이 비율만큼 이동 (timestamp 잡음 / 프레임 지연 완충)
+const uint32_t RENDER_SIZE_ALIGNMENT = 8;     // 추적 영역 크기 단위 (픽셀)
 
 const std::vector<const char*> validationLayers = {
     "VK_LAYER_KHRONOS_validation"
@@ -59,16 +104,81 @@ const bool enableValidationLayers = true;
 // Structures
 // ============================================================================
 
-// Push Constants for ray tracing compute shader
-struct RayTracePushConstants {
-    glm::vec4 cameraPos;     // xyz = position, w = fov
-    glm::vec4 lightPos;      // xyz = position, w = intensity
-    glm::vec4 spherePos;     // xyz = position, w = radius
-    glm::vec4 sphereColor;   // rgb = color, a = shininess
-    float time;
-    float shadowIntensity;
-    int showShadows;
-    int reflections;
+// 누적 history용 storage image (GENERAL 레이아웃 고정)
+struct StorageImage {
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+};
+
+// host visible + 항상 map된 storage buffer (부족하면 2배로 다시 만듦)
+struct MappedBuffer {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    void* mapped = nullptr;
+    VkDeviceSize capacity = 0;
+};
+
+// Denoise compute push constants (denoise.comp)
+struct DenoisePushConstants {
+    int mode;              // 0 prepare, 1 à-trous 반복, 2 resolve
+    int stepSize;
+    float phiColor;
+    float phiNormal;
+    float phiDepth;
+    int temporalVariance;
+    int renderWidth;
+    int renderHeight;
+};
+
+// Fullscreen fragment push constants (fullscreen.frag)
+struct UpscalePushConstants {
+    int renderWidth;       // rtImage 안에서 이번 프레임이 채운 영역
+    int renderHeight;
+    int upscaleMode;       // 0 bilinear, 1 edge-aware
+};
+
+// device local buffer (wavefront 큐)
+struct GpuBuffer {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+};
+
+// wavefront 경로 추적 큐 (원소 수 = 픽셀 수, 광선 큐는 2배: 튕김 홀짝 ping-pong)
+// 큐는 프레임 사이 공유: 프레임 첫 dispatch 앞의 compute barrier가 이전 제출의 쓰기와 순서를 맞춤
+// 카운터는 프레임별 host visible (fence 뒤 큐 길이 / traversal 통계를 UI에 표시, 기록할 때 host에서 0으로)
+// 정렬 버퍼의 bin 개수는 생성할 때 0으로 채우고 이후 scan 단계가 다시 0으로 되돌림
+struct WavefrontBuffers {
+    GpuBuffer paths;
+    GpuBuffer rays;
+    GpuBuffer hits;
+    GpuBuffer shadows;
+    GpuBuffer raySort;
+    std::array<MappedBuffer, MAX_FRAMES_IN_FLIGHT> counters;
+};
+
+// 재질 텍스처 (sampled image, SHADER_READ_ONLY_OPTIMAL 레이아웃 고정)
+struct TextureImage {
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+};
+
+// 프레임별 장면 버퍼
+// TLAS / instance 변환과 메인 구 재질은 매 프레임 바뀌므로 in-flight 프레임과 겹치지 않도록 프레임마다 따로 둠
+// mesh 정점 / 인덱스는 정적이지만 primitive와 같이 장면이 바뀔 때 다시 채우므로 같은 방식으로
+struct SceneBuffers {
+    MappedBuffer primitives;
+    MappedBuffer materials;
+    MappedBuffer blasNodes;
+    MappedBuffer tlasNodes;
+    MappedBuffer instances;
+    MappedBuffer vertexPositions;
+    MappedBuffer vertexNormals;
+    MappedBuffer vertexUvs;
+    MappedBuffer triangleIndices;
+    uint64_t uploadedVersion = 0;          // 0 = 아직 업로드 안 함
+    uint64_t uploadedInstanceVersion = 0;
 };
 
 // ============================================================================
@@ -83,6 +193,69 @@ public:
         cleanup();
     }
 
+    // GPU 없이 CPU 레퍼런스 트레이서로 정지 장면 (time 0, 애니메이션 끔) 한 장을 그려 저장하고 처리량 측정
+    bool runCpuTrace(const std::string& outputPath, int objects) {
+        randomObjectCount = std::clamp(objects, 0, MAX_RANDOM_OBJECTS);
+        freezeAnimation();
+        rebuildScene();
+        updateInstanceTransforms(0.0f);
+        updateMainMaterial();
+
+        rt::RayTracePushConstants pc = makePushConstants(0.0f);
+        std::vector<uint8_t> pixels;
+        rt::CpuTraceStats stats = rt::traceImage(accel, scene, pc, RT_WIDTH, RT_HEIGHT, buildPool, pixels);
+        printCpuTraceStats(rt::bestTracePath(), stats);
+
+        if (!rt::writePpm(outputPath, RT_WIDTH, RT_HEIGHT, pixels)) {
+            std::cerr << "Failed to write " << outputPath << std::endl;
+            return false;
+        }
+        std::cout << "Wrote " << outputPath << std::endl;
+
+        measureCpuTraceThroughput(pc);
+        return true;
+    }
+
+    // 같은 프레임을 GPU로 한 번 dispatch해 읽어 오고 CPU 레퍼런스와 픽셀 단위로 비교
+    bool runGpuComparison(const std::string& outputPrefix, int objects) {
+        randomObjectCount = std::clamp(objects, 0, MAX_RANDOM_OBJECTS);
+        freezeAnimation();
+        initWindow();
+        initVulkan();
+
+        bool ok = compareWithCpuTrace(outputPrefix);
+
+        vkDeviceWaitIdle(device);
+        cleanup();
+        return ok;
+    }
+
+    // 경로 추적을 튕김 횟수별로 megakernel / wavefront / 정렬한 wavefront로 그려 GPU 시간, 일관성, 이미지를 비교
+    bool runPathBenchmark(int objects) {
+        randomObjectCount = std::clamp(objects, 0, MAX_RANDOM_OBJECTS);
+        freezeAnimation();
+        initWindow();
+        initVulkan();
+
+        bool ok = comparePathTracers();
+
+        vkDeviceWaitIdle(device);
+        cleanup();
+        return ok;
+    }
+
+    // --mesh: 기본 장면에 추가할 OBJ (장면을 다시 만들 때마다 같이 넣음)
+    bool loadMesh(const std::string& path) {
+        std::string error;
+        if (!rt::loadObj(path, loadedMesh, error)) {
+            std::cerr << "Failed to load mesh: " << error << std::endl;
+            return false;
+        }
+        std::cout << "Loaded " << path << ": " << loadedMesh.positions.size() << " vertices, "
+                  << loadedMesh.indices.size() / 3 << " triangles" << std::endl;
+        return true;
+    }
+
 private:
     // Window
     GLFWwindow* window = nullptr;
@@ -113,6 +286,29 @@ private:
     VkImageView rtImageView = VK_NULL_HANDLE;
     VkSampler rtSampler = VK_NULL_HANDLE;
 
+    // Accumulation History (ping-pong: 프레임 슬롯 i가 [i]에 쓰고 이전 프레임이 쓴 [i ^ 1]을 읽음)
+    static_assert(MAX_FRAMES_IN_FLIGHT == 2, "History ping-pong follows the frame slot");
+    std::array<StorageImage, MAX_FRAMES_IN_FLIGHT> historyColorImages;  // rgba32f: 선형 색 + 샘플 수
+    std::array<StorageImage, MAX_FRAMES_IN_FLIGHT> historyDepthImages;  // r32f: 주 광선 거리
+    std::array<StorageImage, MAX_FRAMES_IN_FLIGHT> historyMomentsImages;  // rg32f: 휘도 1차 / 2차 모멘트
+
+    // Denoise (denoise.comp): 이번 프레임의 주 광선 표면 + ping-pong 필터 이미지 (조명, 분산)
+    StorageImage albedoImage;  // rgba8
+    StorageImage normalImage;  // rgba16f
+    std::array<StorageImage, 2> denoiseImages;  // rgba16f
+    VkDescriptorSetLayout denoiseDescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool denoiseDescriptorPool = VK_NULL_HANDLE;
+    // [프레임][방향]: 방향 0 = denoiseImages[0] → [1], 1 = [1] → [0]
+    std::array<std::array<VkDescriptorSet, 2>, MAX_FRAMES_IN_FLIGHT> denoiseDescriptorSets{};
+    VkPipelineLayout denoisePipelineLayout = VK_NULL_HANDLE;
+    VkPipeline denoisePipeline = VK_NULL_HANDLE;
+
+    // 가변 밀도: 16x16 타일마다 rt::TileRate, 프레임마다 이전 프레임 판정을 읽고 새 판정을 씀 (host visible)
+    std::array<MappedBuffer, MAX_FRAMES_IN_FLIGHT> tileRateBuffers;
+    std::vector<bool> tileRatesIssued;
+    uint32_t halfRateTiles = 0;
+    uint32_t renderTiles = 0;
+
     // Render Pass & Framebuffers
     VkRenderPass renderPass = VK_NULL_HANDLE;
     std::vector<VkFramebuffer> framebuffers;
@@ -120,9 +316,16 @@ private:
     // Compute Pipeline
     VkDescriptorSetLayout computeDescriptorSetLayout = VK_NULL_HANDLE;
     VkDescriptorPool computeDescriptorPool = VK_NULL_HANDLE;
-    VkDescriptorSet computeDescriptorSet = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> computeDescriptorSets;  // 프레임별 (장면 버퍼가 프레임별)
     VkPipelineLayout computePipelineLayout = VK_NULL_HANDLE;
-    VkPipeline computePipeline = VK_NULL_HANDLE;
+    // 같은 raytrace.comp를 STAGE specialization constant만 바꿔 만든 pipeline (rt::TraceStage 순서)
+    std::array<VkPipeline, rt::TRACE_STAGE_COUNT> computePipelines{};
+
+    // Wavefront Path Tracing
+    WavefrontBuffers wavefront;
+    std::vector<bool> countersIssued;  // 프레임 슬롯이 ray trace를 제출했는지 (카운터 읽기, megakernel도 traversal 통계)
+    rt::WavefrontCounters wavefrontStats{};
+    bool wavefrontStatsValid = false;
 
     // Graphics Pipeline
     VkDescriptorSetLayout graphicsDescriptorSetLayout = VK_NULL_HANDLE;
@@ -141,6 +344,28 @@ private:
     std::vector<VkFence> inFlightFences;
     uint32_t currentFrame = 0;
 
+    // Scene
+    rt::Scene scene;
+    rt::TaskPool buildPool;                     // BVH 빌드 작업 풀 (하드웨어 스레드 수)
+    rt::AccelerationStructure accel;            // mesh별 BLAS + instance TLAS
+    std::vector<glm::mat4> instanceTransforms;  // 마지막으로 TLAS에 반영한 변환 (scene.instances 순서)
+    std::vector<glm::mat4> frameTransforms;     // 이번 프레임 변환 (비교용, 매 프레임 재사용)
+    uint64_t sceneVersion = 1;     // 장면 구조가 바뀔 때마다 증가 → 프레임별 버퍼 전체 재업로드
+    uint64_t instanceVersion = 1;  // instance가 움직여 TLAS를 갱신할 때마다 증가 → TLAS / instance 재업로드
+    uint64_t materialVersion = 1;  // 메인 구 재질이 바뀔 때마다 증가 (누적 리셋용)
+    std::vector<SceneBuffers> sceneBuffers;
+    rt::TriangleMesh loadedMesh;   // --mesh (비었으면 없음)
+    std::vector<TextureImage> textureImages;  // scene.textures 순서 (장면을 다시 만들어도 같음)
+    VkSampler textureSampler = VK_NULL_HANDLE;
+
+    // GPU timing (프레임마다 timestamp 3개: ray trace 앞, ray trace 뒤, 잡음 제거 뒤)
+    VkQueryPool timestampQueryPool = VK_NULL_HANDLE;
+    float timestampPeriod = 1.0f;  // ns / tick
+    std::vector<bool> timestampQueryIssued;
+    std::array<float, MAX_FRAMES_IN_FLIGHT> issuedRenderScale{};  // timestamp를 찍은 프레임의 배율
+    double traceGpuMs = 0.0;
+    double denoiseGpuMs = 0.0;
+
     // ImGui
     VkDescriptorPool imguiDescriptorPool = VK_NULL_HANDLE;
 
@@ -153,11 +378,41 @@ private:
     float sphereRadius = 1.0f;
     glm::vec3 sphereColor = glm::vec3(0.2f, 0.4f, 0.9f);
     float sphereShininess = 64.0f;
+    float sphereReflectivity = 0.3f;
     float shadowIntensity = 0.3f;
     bool showShadows = true;
     bool showReflections = true;
     bool animateLight = true;
     bool animateSphere = true;
+    bool animateInstances = true;
+    int randomObjectCount = 0;
+    bool useBvh = true;
+    bool rebuildTlas = false;  // false = 매 프레임 refit (TLAS 구조는 장면을 만들 때 한 번)
+    bool accumulate = true;
+    int maxSamples = MAX_DEFAULT_SAMPLES;
+    int renderMode = rt::RENDER_WHITTED;
+    int pathBounces = DEFAULT_PATH_BOUNCES;
+    bool denoise = false;
+    int denoiseIterations = 4;
+    bool denoiseTemporalVariance = true;
+    float denoisePhiColor = 4.0f;
+    float denoisePhiNormal = 128.0f;
+    float denoisePhiDepth = 0.02f;
+    bool dynamicResolution = false;
+    float targetGpuMs = DEFAULT_TARGET_GPU_MS;
+    float renderScale = 1.0f;
+    uint32_t renderWidth = RT_WIDTH;
+    uint32_t renderHeight = RT_HEIGHT;
+    int upscaleMode = 1;
+    bool variableRate = false;
+    bool sortRays = false;
+    uint32_t frameCounter = 0;
+
+    // Accumulation State
+    rt::RayTracePushConstants lastShading{};  // 카메라 / 누적 필드를 뺀 지난 프레임 설정
+    uint64_t accumulatedVersion = 0;      // 지난 프레임의 sceneVersion + instanceVersion + materialVersion
+    glm::vec4 prevCameraPos = glm::vec4(0.0f);
+    uint32_t accumulatedFrames = 0;       // 0 = 다음 프레임은 history 리셋
 
     // Timing
     std::chrono::high_resolution_clock::time_point startTime;
@@ -185,7 +440,12 @@ private:
         createFramebuffers();
         createCommandPool();
         createRenderTarget();
+        createScene();
+        createWavefrontBuffers();
+        createTileRateBuffers();
         createComputePipeline();
+        createDenoisePipeline();
+        createQueryPool();
         createGraphicsPipeline();
         createCommandBuffers();
         createSyncObjects();
@@ -301,6 +561,7 @@ private:
         VkPhysicalDeviceProperties props;
         vkGetPhysicalDeviceProperties(physicalDevice, &props);
         std::cout << "Selected GPU: " << props.deviceName << std::endl;
+        timestampPeriod = props.limits.timestampPeriod;
     }
 
     bool isDeviceSuitable(VkPhysicalDevice dev) {
@@ -328,7 +589,34 @@ private:
             }
         }
 
-        return foundGraphics && foundCompute && foundPresent;
+        // 재질 텍스처 배열을 재질 번호 (invocation마다 다름)로 고름 → non-uniform 인덱싱 (Vulkan 1.2)
+        VkPhysicalDeviceProperties props;
+        vkGetPhysicalDeviceProperties(dev, &props);
+        if (props.apiVersion < VK_API_VERSION_1_2) {
+            return false;
+        }
+
+        // traversal 일관성 통계 (subgroupAdd / subgroupMax)
+        VkPhysicalDeviceSubgroupProperties subgroup{};
+        subgroup.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+        VkPhysicalDeviceProperties2 props2{};
+        props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        props2.pNext = &subgroup;
+        vkGetPhysicalDeviceProperties2(dev, &props2);
+        if (!(subgroup.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT) ||
+            !(subgroup.supportedOperations & VK_SUBGROUP_FEATURE_ARITHMETIC_BIT)) {
+            return false;
+        }
+
+        VkPhysicalDeviceVulkan12Features features12{};
+        features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        VkPhysicalDeviceFeatures2 features{};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &features12;
+        vkGetPhysicalDeviceFeatures2(dev, &features);
+
+        return foundGraphics && foundCompute && foundPresent &&
+               features12.shaderSampledImageArrayNonUniformIndexing == VK_TRUE;
     }
 
     void createLogicalDevice() {
@@ -346,6 +634,9 @@ private:
         }
 
         VkPhysicalDeviceFeatures deviceFeatures{};
+        VkPhysicalDeviceVulkan12Features features12{};
+        features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        features12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;  // isDeviceSuitable에서 확인
 
         std::vector<const char*> deviceExtensions = {
             VK_KHR_SWAPCHAIN_EXTENSION_NAME
@@ -357,6 +648,7 @@ private:
 
         VkDeviceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        createInfo.pNext = &features12;
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
         createInfo.pEnabledFeatures = &deviceFeatures;
@@ -535,7 +827,8 @@ private:
         imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
         imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
         imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        // TRANSFER_SRC: --compare에서 CPU 레퍼런스와 비교하려고 읽어 옴
+        imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
         imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
 
         vkCreateImage(device, &imageInfo, nullptr, &rtImage);
@@ -568,6 +861,60 @@ private:
 
         // Transition image layout
         transitionImageLayout(rtImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL);
+
+        // 누적 history (내용은 첫 프레임의 HISTORY_RESET으로 채워짐)
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            createStorageImage(VK_FORMAT_R32G32B32A32_SFLOAT, historyColorImages[i]);
+            createStorageImage(VK_FORMAT_R32_SFLOAT, historyDepthImages[i]);
+            createStorageImage(VK_FORMAT_R32G32_SFLOAT, historyMomentsImages[i]);
+        }
+
+        // 잡음 제거 입력 / 중간 결과 (ray trace와 같은 해상도)
+        createStorageImage(VK_FORMAT_R8G8B8A8_UNORM, albedoImage);
+        createStorageImage(VK_FORMAT_R16G16B16A16_SFLOAT, normalImage);
+        for (StorageImage& image : denoiseImages) {
+            createStorageImage(VK_FORMAT_R16G16B16A16_SFLOAT, image);
+        }
+    }
+
+    void createStorageImage(VkFormat format, StorageImage& target) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = {RT_WIDTH, RT_HEIGHT, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+        if (vkCreateImage(device, &imageInfo, nullptr, &target.image) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create storage image!");
+        }
+
+        VkMemoryRequirements memReqs;
+        vkGetImageMemoryRequirements(device, target.image, &memReqs);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memReqs.size;
+        allocInfo.memoryTypeIndex = findMemoryType(memReqs.memoryTypeBits,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        vkAllocateMemory(device, &allocInfo, nullptr, &target.memory);
+        vkBindImageMemory(device, target.image, target.memory, 0);
+
+        target.view = createImageView(target.image, format);
+        transitionImageLayout(target.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL);
+    }
+
+    void destroyStorageImage(StorageImage& target) {
+        vkDestroyImageView(device, target.view, nullptr);
+        vkDestroyImage(device, target.image, nullptr);
+        vkFreeMemory(device, target.memory, nullptr);
+        target = StorageImage{};
     }
 
     void transitionImageLayout(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout) {
@@ -641,63 +988,67 @@ private:
     // Compute Pipeline
     // ========================================================================
     void createComputePipeline() {
-        // Descriptor set layout
-        VkDescriptorSetLayoutBinding storageImageBinding{};
-        storageImageBinding.binding = 0;
-        storageImageBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-        storageImageBinding.descriptorCount = 1;
-        storageImageBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        // Descriptor set layout: 0 = 출력 이미지, 1 = primitives, 2 = materials,
+        // 3 = BLAS 노드, 4 = TLAS 노드, 5 = instances,
+        // 6 / 7 = 이전 history (색 / 깊이), 8 / 9 = 이번 history,
+        // 10 = 경로 상태, 11 = 광선 큐, 12 = hit 큐, 13 = 그림자 큐, 14 = 큐 카운터,
+        // 15 / 16 = 이전 / 이번 휘도 모멘트, 17 = albedo, 18 = 노말, 19 / 20 = 이전 / 이번 타일 밀도,
+        // 21 ~ 24 = mesh 정점 위치 / 노말 / uv / 삼각형 인덱스, 25 = 재질 텍스처 배열, 26 = 2차 광선 정렬
+        std::array<VkDescriptorSetLayoutBinding, 27> bindings{};
+        for (uint32_t i = 0; i < bindings.size(); i++) {
+            bool image = i == 0 || (i >= 6 && i <= 9) || (i >= 15 && i <= 18);
+            bindings[i].binding = i;
+            bindings[i].descriptorType = image ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+        bindings[25].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[25].descriptorCount = rt::MAX_SCENE_TEXTURES;
 
         VkDescriptorSetLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        layoutInfo.bindingCount = 1;
-        layoutInfo.pBindings = &storageImageBinding;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
 
         vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &computeDescriptorSetLayout);
 
         // Descriptor pool
-        VkDescriptorPoolSize poolSize{};
-        poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-        poolSize.descriptorCount = 1;
+        std::array<VkDescriptorPoolSize, 3> poolSizes{};
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        poolSizes[0].descriptorCount = 9 * MAX_FRAMES_IN_FLIGHT;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSizes[1].descriptorCount = 17 * MAX_FRAMES_IN_FLIGHT;
+        poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSizes[2].descriptorCount = rt::MAX_SCENE_TEXTURES * MAX_FRAMES_IN_FLIGHT;
 
         VkDescriptorPoolCreateInfo poolInfo{};
         poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        poolInfo.poolSizeCount = 1;
-        poolInfo.pPoolSizes = &poolSize;
-        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+        poolInfo.maxSets = MAX_FRAMES_IN_FLIGHT;
 
         vkCreateDescriptorPool(device, &poolInfo, nullptr, &computeDescriptorPool);
 
-        // Allocate descriptor set
+        // Allocate descriptor sets
+        std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, computeDescriptorSetLayout);
         VkDescriptorSetAllocateInfo allocInfo{};
         allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
         allocInfo.descriptorPool = computeDescriptorPool;
-        allocInfo.descriptorSetCount = 1;
-        allocInfo.pSetLayouts = &computeDescriptorSetLayout;
-
-        vkAllocateDescriptorSets(device, &allocInfo, &computeDescriptorSet);
+        allocInfo.descriptorSetCount = MAX_FRAMES_IN_FLIGHT;
+        allocInfo.pSetLayouts = layouts.data();
 
-        // Update descriptor set
-        VkDescriptorImageInfo imageInfo{};
-        imageInfo.imageView = rtImageView;
-        imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        computeDescriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
+        vkAllocateDescriptorSets(device, &allocInfo, computeDescriptorSets.data());
 
-        VkWriteDescriptorSet descriptorWrite{};
-        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrite.dstSet = computeDescriptorSet;
-        descriptorWrite.dstBinding = 0;
-        descriptorWrite.dstArrayElement = 0;
-        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-        descriptorWrite.descriptorCount = 1;
-        descriptorWrite.pImageInfo = &imageInfo;
-
-        vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            writeComputeDescriptorSet(i);
+        }
 
         // Push constants
         VkPushConstantRange pushConstantRange{};
         pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
         pushConstantRange.offset = 0;
-        pushConstantRange.size = sizeof(RayTracePushConstants);
+        pushConstantRange.size = sizeof(rt::RayTracePushConstants);
 
         // Pipeline layout
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
@@ -713,6 +1064,217 @@ private:
         auto compCode = readFile("shaders/raytrace_comp.spv");
         VkShaderModule compModule = createShaderModule(compCode);
 
+        // 단계마다 pipeline 하나: STAGE (constant_id 0)로 쓰지 않는 단계 코드를 잘라냄
+        // → wavefront 단계는 자기 코드만큼의 레지스터로 컴파일 (megakernel 전체의 최댓값이 아님)
+        for (uint32_t stage = 0; stage < rt::TRACE_STAGE_COUNT; stage++) {
+            VkSpecializationMapEntry entry{0, 0, sizeof(uint32_t)};
+            VkSpecializationInfo specialization{};
+            specialization.mapEntryCount = 1;
+            specialization.pMapEntries = &entry;
+            specialization.dataSize = sizeof(uint32_t);
+            specialization.pData = &stage;
+
+            VkPipelineShaderStageCreateInfo compStage{};
+            compStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            compStage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+            compStage.module = compModule;
+            compStage.pName = "main";
+            compStage.pSpecializationInfo = &specialization;
+
+            VkComputePipelineCreateInfo pipelineInfo{};
+            pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            pipelineInfo.stage = compStage;
+            pipelineInfo.layout = computePipelineLayout;
+
+            if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
+                                         &computePipelines[stage]) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create ray trace pipeline!");
+            }
+        }
+
+        vkDestroyShaderModule(device, compModule, nullptr);
+    }
+
+    void writeComputeDescriptorSet(int frame) {
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.imageView = rtImageView;
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+        const SceneBuffers& buffers = sceneBuffers[frame];
+        VkDescriptorBufferInfo primitiveInfo{buffers.primitives.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo materialInfo{buffers.materials.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo blasInfo{buffers.blasNodes.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo tlasInfo{buffers.tlasNodes.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo instanceInfo{buffers.instances.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo positionInfo{buffers.vertexPositions.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo normalInfo{buffers.vertexNormals.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo uvInfo{buffers.vertexUvs.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo indexInfo{buffers.triangleIndices.buffer, 0, VK_WHOLE_SIZE};
+
+        // 장면 텍스처보다 남는 칸은 텍스처 0 (모든 원소가 유효한 descriptor여야 함)
+        std::array<VkDescriptorImageInfo, rt::MAX_SCENE_TEXTURES> textureInfos{};
+        for (uint32_t i = 0; i < textureInfos.size(); i++) {
+            textureInfos[i].sampler = textureSampler;
+            textureInfos[i].imageView = textureImages[i < textureImages.size() ? i : 0].view;
+            textureInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+
+        int previous = frame ^ 1;
+        std::array<VkDescriptorImageInfo, 4> historyInfos{};
+        historyInfos[0].imageView = historyColorImages[previous].view;
+        historyInfos[1].imageView = historyDepthImages[previous].view;
+        historyInfos[2].imageView = historyColorImages[frame].view;
+        historyInfos[3].imageView = historyDepthImages[frame].view;
+        std::array<VkDescriptorImageInfo, 4> denoiseInputInfos{};
+        denoiseInputInfos[0].imageView = historyMomentsImages[previous].view;
+        denoiseInputInfos[1].imageView = historyMomentsImages[frame].view;
+        denoiseInputInfos[2].imageView = albedoImage.view;
+        denoiseInputInfos[3].imageView = normalImage.view;
+        for (auto& info : denoiseInputInfos) {
+            info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        }
+        for (auto& info : historyInfos) {
+            info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        }
+
+        VkDescriptorBufferInfo pathInfo{wavefront.paths.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo rayQueueInfo{wavefront.rays.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo hitQueueInfo{wavefront.hits.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo shadowQueueInfo{wavefront.shadows.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo counterInfo{wavefront.counters[frame].buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo raySortInfo{wavefront.raySort.buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo prevTileRateInfo{tileRateBuffers[previous].buffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo tileRateInfo{tileRateBuffers[frame].buffer, 0, VK_WHOLE_SIZE};
+
+        std::array<VkWriteDescriptorSet, 27> writes{};
+        for (uint32_t i = 0; i < writes.size(); i++) {
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = computeDescriptorSets[frame];
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        }
+        for (uint32_t i = 6; i <= 9; i++) {
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[i].pImageInfo = &historyInfos[i - 6];
+        }
+        for (uint32_t i = 15; i <= 18; i++) {
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[i].pImageInfo = &denoiseInputInfos[i - 15];
+        }
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[0].pImageInfo = &imageInfo;
+        writes[1].pBufferInfo = &primitiveInfo;
+        writes[2].pBufferInfo = &materialInfo;
+        writes[3].pBufferInfo = &blasInfo;
+        writes[4].pBufferInfo = &tlasInfo;
+        writes[5].pBufferInfo = &instanceInfo;
+        writes[10].pBufferInfo = &pathInfo;
+        writes[11].pBufferInfo = &rayQueueInfo;
+        writes[12].pBufferInfo = &hitQueueInfo;
+        writes[13].pBufferInfo = &shadowQueueInfo;
+        writes[14].pBufferInfo = &counterInfo;
+        writes[19].pBufferInfo = &prevTileRateInfo;
+        writes[20].pBufferInfo = &tileRateInfo;
+        writes[21].pBufferInfo = &positionInfo;
+        writes[22].pBufferInfo = &normalInfo;
+        writes[23].pBufferInfo = &uvInfo;
+        writes[24].pBufferInfo = &indexInfo;
+        writes[25].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[25].descriptorCount = rt::MAX_SCENE_TEXTURES;
+        writes[25].pImageInfo = textureInfos.data();
+        writes[26].pBufferInfo = &raySortInfo;
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    // ========================================================================
+    // Denoise Pipeline
+    // ========================================================================
+    void createDenoisePipeline() {
+        // 0 = 누적 색, 1 = 주 광선 거리, 2 = 휘도 모멘트 (프레임별 history), 3 = albedo, 4 = 노말,
+        // 5 = filterIn, 6 = filterOut, 7 = 출력 이미지
+        std::array<VkDescriptorSetLayoutBinding, 8> bindings{};
+        for (uint32_t i = 0; i < bindings.size(); i++) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &denoiseDescriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create denoise descriptor set layout!");
+        }
+
+        const uint32_t setCount = 2 * MAX_FRAMES_IN_FLIGHT;
+        VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 8 * setCount};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        poolInfo.maxSets = setCount;
+
+        if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &denoiseDescriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create denoise descriptor pool!");
+        }
+
+        for (int frame = 0; frame < MAX_FRAMES_IN_FLIGHT; frame++) {
+            std::array<VkDescriptorSetLayout, 2> layouts = {denoiseDescriptorSetLayout, denoiseDescriptorSetLayout};
+            VkDescriptorSetAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocInfo.descriptorPool = denoiseDescriptorPool;
+            allocInfo.descriptorSetCount = 2;
+            allocInfo.pSetLayouts = layouts.data();
+            if (vkAllocateDescriptorSets(device, &allocInfo, denoiseDescriptorSets[frame].data()) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to allocate denoise descriptor sets!");
+            }
+
+            for (int direction = 0; direction < 2; direction++) {
+                std::array<VkImageView, 8> views = {
+                    historyColorImages[frame].view, historyDepthImages[frame].view, historyMomentsImages[frame].view,
+                    albedoImage.view, normalImage.view,
+                    denoiseImages[direction].view, denoiseImages[direction ^ 1].view, rtImageView};
+
+                std::array<VkDescriptorImageInfo, 8> imageInfos{};
+                std::array<VkWriteDescriptorSet, 8> writes{};
+                for (uint32_t i = 0; i < writes.size(); i++) {
+                    imageInfos[i].imageView = views[i];
+                    imageInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+                    writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                    writes[i].dstSet = denoiseDescriptorSets[frame][direction];
+                    writes[i].dstBinding = i;
+                    writes[i].descriptorCount = 1;
+                    writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                    writes[i].pImageInfo = &imageInfos[i];
+                }
+                vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+            }
+        }
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(DenoisePushConstants);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &denoiseDescriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &denoisePipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create denoise pipeline layout!");
+        }
+
+        auto compCode = readFile("shaders/denoise_comp.spv");
+        VkShaderModule compModule = createShaderModule(compCode);
+
         VkPipelineShaderStageCreateInfo compStage{};
         compStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
         compStage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
@@ -722,13 +1284,435 @@ private:
         VkComputePipelineCreateInfo pipelineInfo{};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
         pipelineInfo.stage = compStage;
-        pipelineInfo.layout = computePipelineLayout;
+        pipelineInfo.layout = denoisePipelineLayout;
 
-        vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &computePipeline);
+        if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &denoisePipeline) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create denoise pipeline!");
+        }
 
         vkDestroyShaderModule(device, compModule, nullptr);
     }
 
+    // ========================================================================
+    // Wavefront Queues
+    // ========================================================================
+    void createWavefrontBuffers() {
+        VkDeviceSize pixelCount = VkDeviceSize(RT_WIDTH) * RT_HEIGHT;
+        VkMemoryPropertyFlags deviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        createBuffer(pixelCount * sizeof(rt::WavefrontPath), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal,
+                     wavefront.paths.buffer, wavefront.paths.memory);
+        createBuffer(2 * pixelCount * sizeof(rt::WavefrontRay), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal,
+                     wavefront.rays.buffer, wavefront.rays.memory);
+        createBuffer(pixelCount * sizeof(rt::WavefrontHit), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal,
+                     wavefront.hits.buffer, wavefront.hits.memory);
+        createBuffer(pixelCount * sizeof(rt::WavefrontShadow), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal,
+                     wavefront.shadows.buffer, wavefront.shadows.memory);
+
+        VkDeviceSize sortBytes = rt::raySortBufferSize(pixelCount);
+        createBuffer(sortBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, deviceLocal,
+                     wavefront.raySort.buffer, wavefront.raySort.memory);
+        VkCommandBuffer cmd = beginSingleTimeCommands();
+        vkCmdFillBuffer(cmd, wavefront.raySort.buffer, 0, VK_WHOLE_SIZE, 0);
+        endSingleTimeCommands(cmd);
+
+        // 셰이더가 atomicAdd로 큐 길이를 세고 dispatch 크기를 써 넣음 → INDIRECT_BUFFER로 다음 단계 dispatch
+        for (MappedBuffer& counters : wavefront.counters) {
+            counters.capacity = sizeof(rt::WavefrontCounters);
+            createBuffer(counters.capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         counters.buffer, counters.memory);
+            vkMapMemory(device, counters.memory, 0, VK_WHOLE_SIZE, 0, &counters.mapped);
+        }
+        countersIssued.assign(MAX_FRAMES_IN_FLIGHT, false);
+    }
+
+    // 이 프레임 슬롯의 fence를 기다린 뒤 호출 (readTimestamps와 같음)
+    void readWavefrontStats() {
+        if (!countersIssued[currentFrame]) {
+            return;
+        }
+        memcpy(&wavefrontStats, wavefront.counters[currentFrame].mapped, sizeof(rt::WavefrontCounters));
+        wavefrontStatsValid = true;
+    }
+
+    // ========================================================================
+    // Variable Rate Tiles
+    // ========================================================================
+    // 최대 해상도 기준 타일 격자 (work group ID = 타일), 0 = 전부 TILE_RATE_FULL
+    void createTileRateBuffers() {
+        uint32_t tilesX = (RT_WIDTH + rt::RATE_TILE_SIZE - 1) / rt::RATE_TILE_SIZE;
+        uint32_t tilesY = (RT_HEIGHT + rt::RATE_TILE_SIZE - 1) / rt::RATE_TILE_SIZE;
+        for (MappedBuffer& rates : tileRateBuffers) {
+            rates.capacity = VkDeviceSize(tilesX) * tilesY * sizeof(uint32_t);
+            createBuffer(rates.capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         rates.buffer, rates.memory);
+            vkMapMemory(device, rates.memory, 0, VK_WHOLE_SIZE, 0, &rates.mapped);
+            memset(rates.mapped, 0, static_cast<size_t>(rates.capacity));
+        }
+        tileRatesIssued.assign(MAX_FRAMES_IN_FLIGHT, false);
+    }
+
+    // 이 프레임 슬롯의 fence를 기다린 뒤 호출, 추적 영역 안 타일 중 half 판정 수 (UI)
+    void readTileRateStats() {
+        if (!tileRatesIssued[currentFrame]) {
+            return;
+        }
+        uint32_t tilesX = (RT_WIDTH + rt::RATE_TILE_SIZE - 1) / rt::RATE_TILE_SIZE;
+        uint32_t usedX = (renderWidth + rt::RATE_TILE_SIZE - 1) / rt::RATE_TILE_SIZE;
+        uint32_t usedY = (renderHeight + rt::RATE_TILE_SIZE - 1) / rt::RATE_TILE_SIZE;
+        const uint32_t* rates = static_cast<const uint32_t*>(tileRateBuffers[currentFrame].mapped);
+
+        halfRateTiles = 0;
+        for (uint32_t y = 0; y < usedY; y++) {
+            for (uint32_t x = 0; x < usedX; x++) {
+                halfRateTiles += rates[y * tilesX + x] == rt::TILE_RATE_HALF ? 1 : 0;
+            }
+        }
+        renderTiles = usedX * usedY;
+    }
+
+    // ========================================================================
+    // Scene Buffers
+    // ========================================================================
+    void createScene() {
+        rebuildScene();
+        sceneBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            ensureSceneCapacity(i);
+        }
+        createSceneTextures();
+    }
+
+    // 텍스처는 기본 장면 + --mesh에서만 나오므로 무작위 오브젝트 수를 바꿔 장면을 다시 만들어도 같음 → 한 번만 업로드
+    void createSceneTextures() {
+        std::vector<rt::Texture> textures = scene.textures;
+        if (textures.empty()) {
+            textures.push_back(rt::makeCheckerTexture(1, 1, glm::vec3(1.0f), glm::vec3(1.0f)));  // 빈 칸 채우기용
+        }
+
+        for (const rt::Texture& texture : textures) {
+            TextureImage target;
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageInfo.extent = {texture.width, texture.height, 1};
+            imageInfo.mipLevels = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;  // 선형 값 (CPU 레퍼런스도 /255 그대로)
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+            if (vkCreateImage(device, &imageInfo, nullptr, &target.image) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create texture image!");
+            }
+
+            VkMemoryRequirements memReqs;
+            vkGetImageMemoryRequirements(device, target.image, &memReqs);
+
+            VkMemoryAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocInfo.allocationSize = memReqs.size;
+            allocInfo.memoryTypeIndex = findMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+            vkAllocateMemory(device, &allocInfo, nullptr, &target.memory);
+            vkBindImageMemory(device, target.image, target.memory, 0);
+
+            // staging buffer → image (UNDEFINED → TRANSFER_DST → SHADER_READ_ONLY)
+            VkBuffer staging;
+            VkDeviceMemory stagingMemory;
+            createBuffer(texture.rgba.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         staging, stagingMemory);
+            void* mapped;
+            vkMapMemory(device, stagingMemory, 0, VK_WHOLE_SIZE, 0, &mapped);
+            memcpy(mapped, texture.rgba.data(), texture.rgba.size());
+
+            VkCommandBuffer cmd = beginSingleTimeCommands();
+            VkImageMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = target.image;
+            barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                                 0, nullptr, 0, nullptr, 1, &barrier);
+
+            VkBufferImageCopy region{};
+            region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            region.imageExtent = {texture.width, texture.height, 1};
+            vkCmdCopyBufferToImage(cmd, staging, target.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                                 0, nullptr, 0, nullptr, 1, &barrier);
+            endSingleTimeCommands(cmd);
+            destroyBuffer(staging, stagingMemory);
+
+            target.view = createImageView(target.image, VK_FORMAT_R8G8B8A8_UNORM);
+            textureImages.push_back(target);
+        }
+
+        // CPU 레퍼런스의 sampleTexture와 같은 필터 (repeat + bilinear, mip 0)
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+
+        if (vkCreateSampler(device, &samplerInfo, nullptr, &textureSampler) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create texture sampler!");
+        }
+    }
+
+    // 기본 장면 (+ --mesh) + 무작위 오브젝트 → BLAS / TLAS 빌드 → 모든 프레임 버퍼를 다시 채우도록 버전 증가
+    void rebuildScene() {
+        scene = rt::createDefaultScene();
+        if (!loadedMesh.indices.empty()) {
+            rt::addLoadedMesh(scene, loadedMesh, LOADED_MESH_POSITION, LOADED_MESH_SIZE);
+        }
+        rt::addRandomObjects(scene, static_cast<uint32_t>(randomObjectCount), RANDOM_SCENE_SEED);
+
+        accel.build(scene, buildPool);
+
+        // TLAS는 정지 상태 변환으로 처음 빌드, 이후 프레임은 refit (rebuildTlas면 rebuild)
+        instanceTransforms.clear();
+        for (const rt::Instance& instance : scene.instances) {
+            instanceTransforms.push_back(instance.transform);
+        }
+        accel.updateInstances(instanceTransforms, true, buildPool);
+
+        const rt::BlasStats& blasStats = accel.blasStats;
+        const rt::BvhStats& tlasStats = accel.tlas.stats;
+        std::cout << "BLAS: " << blasStats.meshCount << " meshes, " << blasStats.primitiveCount << " primitives, "
+                  << blasStats.nodeCount << " nodes, " << blasStats.buildMs << " ms | TLAS: "
+                  << scene.instances.size() << " instances, " << tlasStats.nodeCount << " nodes, depth "
+                  << tlasStats.maxDepth << ", " << tlasStats.buildMs << " ms | mesh: " << scene.meshTriangleCount()
+                  << " triangles, " << scene.vertexPositions.size() << " vertices, " << scene.textures.size()
+                  << " textures" << std::endl;
+
+        sceneVersion++;
+        instanceVersion++;
+    }
+
+    bool ensureMappedBuffer(MappedBuffer& mapped, VkDeviceSize size) {
+        if (size <= mapped.capacity) {
+            return false;
+        }
+        destroyBuffer(mapped.buffer, mapped.memory);
+        mapped.capacity = std::max<VkDeviceSize>(size * 2, 4096);
+        createBuffer(mapped.capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     mapped.buffer, mapped.memory);
+        vkMapMemory(device, mapped.memory, 0, VK_WHOLE_SIZE, 0, &mapped.mapped);
+        return true;
+    }
+
+    // 장면이 프레임 버퍼보다 커지면 2배 여유를 두고 다시 만듦
+    // 이 프레임 슬롯의 fence를 기다린 뒤에만 호출 → 이전 제출이 버퍼를 쓰고 있지 않음
+    // 반환값: 버퍼를 새로 만들었는지 (descriptor set 갱신 필요)
+    bool ensureSceneCapacity(int frame) {
+        SceneBuffers& buffers = sceneBuffers[frame];
+        bool recreated = ensureMappedBuffer(buffers.primitives, accel.primitives.size() * sizeof(rt::Primitive));
+        recreated |= ensureMappedBuffer(buffers.materials, scene.materials.size() * sizeof(rt::Material));
+        recreated |= ensureMappedBuffer(buffers.blasNodes, accel.blasNodes.size() * sizeof(rt::BvhNode));
+        recreated |= ensureMappedBuffer(buffers.tlasNodes, accel.tlas.nodes.size() * sizeof(rt::BvhNode));
+        recreated |= ensureMappedBuffer(buffers.instances, accel.instances.size() * sizeof(rt::GpuInstance));
+        recreated |= ensureMappedBuffer(buffers.vertexPositions, scene.vertexPositions.size() * sizeof(glm::vec4));
+        recreated |= ensureMappedBuffer(buffers.vertexNormals, scene.vertexNormals.size() * sizeof(glm::vec4));
+        recreated |= ensureMappedBuffer(buffers.vertexUvs, scene.vertexUvs.size() * sizeof(glm::vec2));
+        recreated |= ensureMappedBuffer(buffers.triangleIndices, scene.triangleIndices.size() * sizeof(uint32_t));
+
+        if (recreated) {
+            buffers.uploadedVersion = 0;
+        }
+        return recreated;
+    }
+
+    // 이번 프레임의 instance 변환 (메인 구 = instance 0, 단위 구 mesh를 UI 위치 / 반지름으로 변환)
+    // 하나라도 바뀌었으면 TLAS만 refit (또는 rebuild): 비용은 instance 수에 비례, BLAS는 그대로
+    void updateInstanceTransforms(float time) {
+        frameTransforms.resize(scene.instances.size());
+
+        glm::vec3 center = spherePos;
+        if (animateSphere) {
+            center.y += std::sin(time * 2.0f) * 0.5f;  // 바운스 애니메이션
+        }
+        frameTransforms[0] = glm::scale(glm::translate(glm::mat4(1.0f), center), glm::vec3(sphereRadius));
+        for (size_t i = 1; i < scene.instances.size(); i++) {
+            const rt::Instance& instance = scene.instances[i];
+            frameTransforms[i] = animateInstances ? rt::animatedTransform(instance, time) : instance.transform;
+        }
+
+        if (memcmp(frameTransforms.data(), instanceTransforms.data(), frameTransforms.size() * sizeof(glm::mat4)) == 0) {
+            return;
+        }
+        instanceTransforms.swap(frameTransforms);
+        accel.updateInstances(instanceTransforms, rebuildTlas, buildPool);
+        instanceVersion++;
+    }
+
+    // 메인 구 재질 (material 0)을 UI 값으로
+    void updateMainMaterial() {
+        rt::Material& mainMaterial = scene.materials[0];
+        rt::Material previousMaterial = mainMaterial;
+        mainMaterial.color = sphereColor;
+        mainMaterial.color2 = sphereColor;
+        mainMaterial.shininess = sphereShininess;
+        mainMaterial.reflectivity = sphereReflectivity;
+        if (memcmp(&previousMaterial, &mainMaterial, sizeof(rt::Material)) != 0) {
+            materialVersion++;
+        }
+    }
+
+    // instance 변환과 메인 구 재질을 UI 값과 애니메이션으로 갱신하고 이 프레임 버퍼에 반영
+    void updateSceneBuffers(float time) {
+        updateInstanceTransforms(time);
+        updateMainMaterial();
+        const rt::Material& mainMaterial = scene.materials[0];
+
+        if (ensureSceneCapacity(currentFrame)) {
+            writeComputeDescriptorSet(currentFrame);
+        }
+
+        // 정적인 BLAS / primitive는 구조가 바뀐 뒤 처음 쓰는 프레임 버퍼에만 복사
+        SceneBuffers& buffers = sceneBuffers[currentFrame];
+        if (buffers.uploadedVersion != sceneVersion) {
+            memcpy(buffers.primitives.mapped, accel.primitives.data(), accel.primitives.size() * sizeof(rt::Primitive));
+            memcpy(buffers.materials.mapped, scene.materials.data(), scene.materials.size() * sizeof(rt::Material));
+            memcpy(buffers.blasNodes.mapped, accel.blasNodes.data(), accel.blasNodes.size() * sizeof(rt::BvhNode));
+            memcpy(buffers.vertexPositions.mapped, scene.vertexPositions.data(),
+                   scene.vertexPositions.size() * sizeof(glm::vec4));
+            memcpy(buffers.vertexNormals.mapped, scene.vertexNormals.data(), scene.vertexNormals.size() * sizeof(glm::vec4));
+            memcpy(buffers.vertexUvs.mapped, scene.vertexUvs.data(), scene.vertexUvs.size() * sizeof(glm::vec2));
+            memcpy(buffers.triangleIndices.mapped, scene.triangleIndices.data(),
+                   scene.triangleIndices.size() * sizeof(uint32_t));
+            buffers.uploadedVersion = sceneVersion;
+            buffers.uploadedInstanceVersion = 0;
+        } else {
+            memcpy(buffers.materials.mapped, &mainMaterial, sizeof(rt::Material));
+        }
+
+        // 움직이는 것: TLAS 노드 (instance 수 * 2 - 1개 이하) + instance (96 byte씩)
+        if (buffers.uploadedInstanceVersion != instanceVersion) {
+            memcpy(buffers.tlasNodes.mapped, accel.tlas.nodes.data(), accel.tlas.nodes.size() * sizeof(rt::BvhNode));
+            memcpy(buffers.instances.mapped, accel.instances.data(), accel.instances.size() * sizeof(rt::GpuInstance));
+            buffers.uploadedInstanceVersion = instanceVersion;
+        }
+    }
+
+    // 카메라를 뺀 나머지 (장면, 조명, 토글)가 그대로면 누적을 이어가고, 카메라만 바뀌었으면 재투영
+    // useBvh는 결과가 같으므로 리셋하지 않음
+    void updateAccumulation(rt::RayTracePushConstants& pc) {
+        rt::RayTracePushConstants shading = pc;
+        shading.cameraPos = glm::vec4(0.0f);
+        shading.useBvh = 0;
+        shading.frameCounter = 0;
+        shading.sortRays = 0;  // 정렬은 추적 순서만 바꿈
+        if (shading.renderMode == rt::RENDER_PATH_WAVEFRONT) {
+            shading.renderMode = rt::RENDER_PATH_MEGAKERNEL;  // 같은 경로를 그리므로 누적을 이어감
+        }
+
+        uint64_t version = sceneVersion + instanceVersion + materialVersion;  // 셋 다 증가만 함
+        bool reset = !accumulate || accumulatedFrames == 0 || version != accumulatedVersion ||
+                     memcmp(&shading, &lastShading, sizeof(rt::RayTracePushConstants)) != 0;
+        bool cameraMoved = pc.cameraPos != prevCameraPos;
+
+        if (reset) {
+            pc.historyMode = rt::HISTORY_RESET;
+            accumulatedFrames = 0;
+        } else {
+            pc.historyMode = cameraMoved ? rt::HISTORY_REPROJECT : rt::HISTORY_STATIC;
+        }
+        pc.prevCameraPos = prevCameraPos;
+        pc.frameIndex = accumulatedFrames;
+        pc.maxSamples = static_cast<uint32_t>(accumulate ? maxSamples : 1);
+        pc.jitter = pc.historyMode != rt::HISTORY_RESET ? 1 : 0;  // 리셋 프레임은 픽셀 중심 (매 프레임 리셋될 때 떨림 방지)
+
+        accumulatedFrames = accumulate ? (cameraMoved ? 1 : accumulatedFrames + 1) : 0;
+        lastShading = shading;
+        accumulatedVersion = version;
+        prevCameraPos = pc.cameraPos;
+    }
+
+    // ========================================================================
+    // GPU Timing
+    // ========================================================================
+    void createQueryPool() {
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+        if (queueFamilies[graphicsFamily].timestampValidBits == 0 || timestampPeriod <= 0.0f) {
+            std::cout << "Timestamps not supported - GPU timing disabled" << std::endl;
+            return;
+        }
+
+        VkQueryPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        poolInfo.queryCount = TIMESTAMPS_PER_FRAME * MAX_FRAMES_IN_FLIGHT;
+
+        if (vkCreateQueryPool(device, &poolInfo, nullptr, &timestampQueryPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create timestamp query pool!");
+        }
+        timestampQueryIssued.assign(MAX_FRAMES_IN_FLIGHT, false);
+    }
+
+    // 이 프레임 슬롯의 fence를 기다린 뒤 호출 → 결과가 이미 있음
+    // 새 값을 읽었으면 true
+    bool readTimestamps() {
+        if (timestampQueryPool == VK_NULL_HANDLE || !timestampQueryIssued[currentFrame]) {
+            return false;
+        }
+
+        uint64_t ticks[TIMESTAMPS_PER_FRAME] = {};
+        VkResult result = vkGetQueryPoolResults(device, timestampQueryPool, currentFrame * TIMESTAMPS_PER_FRAME,
+            TIMESTAMPS_PER_FRAME, sizeof(ticks), ticks, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+        if (result == VK_SUCCESS) {
+            traceGpuMs = static_cast<double>(ticks[1] - ticks[0]) * timestampPeriod * 1e-6;
+            denoiseGpuMs = static_cast<double>(ticks[2] - ticks[1]) * timestampPeriod * 1e-6;
+        }
+        return result == VK_SUCCESS;
+    }
+
+    // 이 슬롯이 마지막으로 그린 프레임의 배율과 GPU 시간으로 다음 배율을 정함
+    void updateRenderScale() {
+        double gpuMs = traceGpuMs + denoiseGpuMs;
+        if (dynamicResolution && gpuMs > 0.0) {
+            float measuredScale = issuedRenderScale[currentFrame];
+            float desired = measuredScale * static_cast<float>(std::sqrt(targetGpuMs / gpuMs));
+            desired = std::clamp(desired, MIN_RENDER_SCALE, 1.0f);
+            if (std::abs(desired - renderScale) > RENDER_SCALE_HYSTERESIS * renderScale) {
+                renderScale += (desired - renderScale) * RENDER_SCALE_DAMPING;
+            }
+        }
+        applyRenderScale();
+    }
+
+    // 배율 → 추적 영역 (RENDER_SIZE_ALIGNMENT 단위, 크기가 바뀌면 push constant 비교로 누적이 리셋됨)
+    void applyRenderScale() {
+        auto scaled = [&](uint32_t size) {
+            uint32_t aligned = static_cast<uint32_t>(std::lround(size * renderScale / RENDER_SIZE_ALIGNMENT)) *
+                               RENDER_SIZE_ALIGNMENT;
+            return std::clamp(aligned, RENDER_SIZE_ALIGNMENT, size);
+        };
+        renderWidth = scaled(RT_WIDTH);
+        renderHeight = scaled(RT_HEIGHT);
+    }
+
     // ========================================================================
     // Graphics Pipeline
     // ========================================================================
@@ -786,11 +1770,18 @@ private:
 
         vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
 
-        // Pipeline layout
+        // Pipeline layout (추적 영역 크기 / 확대 방식 push constant)
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(UpscalePushConstants);
+
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
         pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         pipelineLayoutInfo.setLayoutCount = 1;
         pipelineLayoutInfo.pSetLayouts = &graphicsDescriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
 
         vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &graphicsPipelineLayout);
 
@@ -992,6 +1983,11 @@ private:
 
         vkResetFences(device, 1, &inFlightFences[currentFrame]);
 
+        if (readTimestamps()) {
+            updateRenderScale();
+        }
+        readWavefrontStats();
+        readTileRateStats();
         recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
 
         VkSubmitInfo submitInfo{};
@@ -1021,45 +2017,208 @@ private:
 
         vkQueuePresentKHR(presentQueue, &presentInfo);
         currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+        frameCounter++;
     }
 
-    void recordCommandBuffer(VkCommandBuffer cmd, uint32_t imageIndex) {
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        vkBeginCommandBuffer(cmd, &beginInfo);
-
-        // Calculate time
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        float time = std::chrono::duration<float>(currentTime - startTime).count();
-
-        // Animate light and sphere
+    // 카메라 / 조명 / 토글 / 장면 범위 (누적 필드는 updateAccumulation에서)
+    // 메인 구 바운스와 instance 애니메이션은 updateSceneBuffers에서
+    rt::RayTracePushConstants makePushConstants(float time) const {
         glm::vec3 animLightPos = lightPos;
         if (animateLight) {
             animLightPos.x = sin(time * 0.5f) * 5.0f;
             animLightPos.z = cos(time * 0.5f) * 5.0f;
         }
 
-        // Push constants
-        RayTracePushConstants pc{};
+        rt::RayTracePushConstants pc{};
         pc.cameraPos = glm::vec4(cameraPos, cameraFov);
         pc.lightPos = glm::vec4(animLightPos, lightIntensity);
-        pc.spherePos = glm::vec4(spherePos, sphereRadius);
-        pc.sphereColor = glm::vec4(sphereColor, sphereShininess);
-        pc.time = animateSphere ? time : 0.0f;
         pc.shadowIntensity = shadowIntensity;
         pc.showShadows = showShadows ? 1 : 0;
         pc.reflections = showReflections ? 1 : 0;
+        pc.useBvh = useBvh ? 1 : 0;
+        pc.tlasNodeCount = static_cast<uint32_t>(accel.tlas.nodes.size());
+        pc.instanceCount = static_cast<uint32_t>(accel.instances.size());
+        pc.planeFirst = accel.planeFirst;
+        pc.planeCount = accel.planeCount;
+        pc.renderMode = static_cast<uint32_t>(renderMode);
+        pc.maxBounces = static_cast<uint32_t>(pathBounces);
+        pc.renderWidth = renderWidth;
+        pc.renderHeight = renderHeight;
+        pc.variableRate = variableRate ? 1 : 0;
+        pc.frameCounter = frameCounter;
+        pc.sortRays = sortRays ? 1 : 0;
+        return pc;
+    }
+
+    void recordRayTrace(VkCommandBuffer cmd, const rt::RayTracePushConstants& pc) {
+        // 이전 프레임 dispatch가 쓴 history를 읽고, 그 프레임이 읽던 history에 씀
+        VkMemoryBarrier historyBarrier{};
+        historyBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        historyBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        historyBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &historyBarrier, 0, nullptr, 0, nullptr);
 
-        // ==================== COMPUTE PASS ====================
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
         vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
-                                 0, 1, &computeDescriptorSet, 0, nullptr);
+                                 0, 1, &computeDescriptorSets[currentFrame], 0, nullptr);
         vkCmdPushConstants(cmd, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
-                           0, sizeof(RayTracePushConstants), &pc);
+                           0, sizeof(rt::RayTracePushConstants), &pc);
+
+        // 이 슬롯의 이전 제출은 fence로 끝났고 host coherent → 제출 시점에 GPU에 보임
+        memset(wavefront.counters[currentFrame].mapped, 0, sizeof(rt::WavefrontCounters));
+        countersIssued[currentFrame] = true;
+        tileRatesIssued[currentFrame] = pc.renderMode != rt::RENDER_PATH_WAVEFRONT && pc.variableRate != 0;
+        if (pc.renderMode == rt::RENDER_PATH_WAVEFRONT) {
+            recordWavefront(cmd, pc);
+            return;
+        }
+
+        uint32_t groupX = (pc.renderWidth + 15) / 16;
+        uint32_t groupY = (pc.renderHeight + 15) / 16;
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[rt::STAGE_MEGAKERNEL]);
+        vkCmdDispatch(cmd, groupX, groupY, 1);
+    }
+
+    // 앞 단계의 큐 / 카운터 / dispatch 크기 쓰기 → 다음 단계의 셰이더 읽기와 indirect 읽기
+    // 다음 튕김의 dispatch args 쓰기가 앞 indirect 읽기를 덮지 않도록 DRAW_INDIRECT도 source에 포함
+    void recordWavefrontBarrier(VkCommandBuffer cmd) {
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+                                VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        VkPipelineStageFlags stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+        vkCmdPipelineBarrier(cmd, stages, stages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    // 큐 카운터 → dispatch 크기 (1 invocation) → 그 크기로 indirect dispatch
+    void recordQueueDispatch(VkCommandBuffer cmd, rt::TraceStage stage, VkDeviceSize argsOffset) {
+        VkBuffer counters = wavefront.counters[currentFrame].buffer;
+
+        recordWavefrontBarrier(cmd);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[rt::STAGE_DISPATCH_ARGS]);
+        vkCmdDispatch(cmd, 1, 1, 1);
+
+        recordWavefrontBarrier(cmd);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[stage]);
+        vkCmdDispatchIndirect(cmd, counters, argsOffset);
+    }
+
+    // generate → 튕김마다 extend / shade / connect → resolve
+    // 큐 길이는 GPU에만 있으므로 튕김 수만큼 고정으로 기록하고, 빈 큐는 0 그룹 dispatch가 됨
+    void recordWavefront(VkCommandBuffer cmd, rt::RayTracePushConstants pc) {
+        uint32_t groupX = (pc.renderWidth + 15) / 16;
+        uint32_t groupY = (pc.renderHeight + 15) / 16;
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[rt::STAGE_GENERATE]);
+        vkCmdDispatch(cmd, groupX, groupY, 1);
+
+        for (uint32_t bounce = 0; bounce <= pc.maxBounces; bounce++) {
+            pc.bounce = bounce;
+            vkCmdPushConstants(cmd, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                               0, sizeof(rt::RayTracePushConstants), &pc);
+
+            recordQueueDispatch(cmd, rt::STAGE_EXTEND, offsetof(rt::WavefrontCounters, extendArgs));
+            recordQueueDispatch(cmd, rt::STAGE_SHADE, offsetof(rt::WavefrontCounters, shadeArgs));
+            if (pc.sortRays != 0) {
+                recordRaySort(cmd);
+            }
+            recordQueueDispatch(cmd, rt::STAGE_CONNECT, offsetof(rt::WavefrontCounters, connectArgs));
+        }
 
-        uint32_t groupX = (RT_WIDTH + 15) / 16;
-        uint32_t groupY = (RT_HEIGHT + 15) / 16;
+        recordWavefrontBarrier(cmd);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[rt::STAGE_RESOLVE]);
         vkCmdDispatch(cmd, groupX, groupY, 1);
+    }
+
+    // shade가 채운 다음 튕김 광선 / 그림자 큐 → bin 개수 세기 → 표마다 scan (work group 하나씩) → 정렬된 순서
+    // scatter는 count와 같은 큐 길이라 dispatch args를 다시 계산하지 않음
+    void recordRaySort(VkCommandBuffer cmd) {
+        recordQueueDispatch(cmd, rt::STAGE_SORT_COUNT, offsetof(rt::WavefrontCounters, sortArgs));
+
+        recordWavefrontBarrier(cmd);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[rt::STAGE_SORT_SCAN]);
+        vkCmdDispatch(cmd, rt::SORT_TABLES, 1, 1);
+
+        recordWavefrontBarrier(cmd);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[rt::STAGE_SORT_SCATTER]);
+        vkCmdDispatchIndirect(cmd, wavefront.counters[currentFrame].buffer, offsetof(rt::WavefrontCounters, sortArgs));
+    }
+
+    // ray trace가 쓴 누적 색 / 보조 이미지 → prepare → à-trous 반복 (간격 1, 2, 4, ...) → resolve (rtImage를 덮어씀)
+    void recordDenoise(VkCommandBuffer cmd) {
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        DenoisePushConstants pc{};
+        pc.phiColor = denoisePhiColor;
+        pc.phiNormal = denoisePhiNormal;
+        pc.phiDepth = denoisePhiDepth;
+        pc.temporalVariance = denoiseTemporalVariance ? 1 : 0;
+        pc.renderWidth = static_cast<int>(renderWidth);
+        pc.renderHeight = static_cast<int>(renderHeight);
+
+        uint32_t groupX = (renderWidth + 15) / 16;
+        uint32_t groupY = (renderHeight + 15) / 16;
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, denoisePipeline);
+
+        // pass마다 앞 pass의 결과를 읽음 (prepare는 방향 1로 denoiseImages[0]에 씀)
+        auto dispatch = [&](int mode, int direction) {
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 1, &barrier, 0, nullptr, 0, nullptr);
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, denoisePipelineLayout,
+                                     0, 1, &denoiseDescriptorSets[currentFrame][direction], 0, nullptr);
+            pc.mode = mode;
+            vkCmdPushConstants(cmd, denoisePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                               0, sizeof(DenoisePushConstants), &pc);
+            vkCmdDispatch(cmd, groupX, groupY, 1);
+        };
+
+        dispatch(0, 1);
+        for (int i = 0; i < denoiseIterations; i++) {
+            pc.stepSize = 1 << i;
+            dispatch(1, i & 1);
+        }
+        dispatch(2, denoiseIterations & 1);
+    }
+
+    void recordCommandBuffer(VkCommandBuffer cmd, uint32_t imageIndex) {
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        vkBeginCommandBuffer(cmd, &beginInfo);
+
+        // Calculate time
+        auto currentTime = std::chrono::high_resolution_clock::now();
+        float time = std::chrono::duration<float>(currentTime - startTime).count();
+
+        updateSceneBuffers(time);
+        rt::RayTracePushConstants pc = makePushConstants(time);
+        updateAccumulation(pc);
+
+        // ==================== COMPUTE PASS ====================
+        uint32_t firstQuery = currentFrame * TIMESTAMPS_PER_FRAME;
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            vkCmdResetQueryPool(cmd, timestampQueryPool, firstQuery, TIMESTAMPS_PER_FRAME);
+            vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampQueryPool, firstQuery);
+        }
+
+        recordRayTrace(cmd, pc);
+
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, timestampQueryPool, firstQuery + 1);
+        }
+
+        if (denoise) {
+            recordDenoise(cmd);
+        }
+
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, timestampQueryPool, firstQuery + 2);
+            timestampQueryIssued[currentFrame] = true;
+            issuedRenderScale[currentFrame] = renderScale;
+        }
 
         // Image barrier: GENERAL -> SHADER_READ_ONLY_OPTIMAL
         VkImageMemoryBarrier barrier{};
@@ -1100,6 +2259,9 @@ private:
         vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
         vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipelineLayout,
                                  0, 1, &graphicsDescriptorSet, 0, nullptr);
+        UpscalePushConstants upscale{static_cast<int>(renderWidth), static_cast<int>(renderHeight), upscaleMode};
+        vkCmdPushConstants(cmd, graphicsPipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT,
+                           0, sizeof(UpscalePushConstants), &upscale);
         vkCmdDraw(cmd, 3, 1, 0, 0);
 
         // ImGui
@@ -1127,25 +2289,116 @@ private:
         ImGui::NewFrame();
 
         ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_FirstUseEver);
-        ImGui::SetNextWindowSize(ImVec2(300, 380), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSize(ImVec2(300, 540), ImGuiCond_FirstUseEver);
 
         ImGui::Begin("Ray Tracing Shadows");
 
         ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
-        ImGui::Text("Resolution: %dx%d", RT_WIDTH, RT_HEIGHT);
+        ImGui::Text("Resolution: %ux%u / %ux%u", renderWidth, renderHeight, RT_WIDTH, RT_HEIGHT);
+        if (timestampQueryPool != VK_NULL_HANDLE && traceGpuMs > 0.0) {
+            // 주 광선 기준 (그림자/반사 광선 제외, 가변 밀도에서는 복사한 픽셀도 셈)
+            double mrays = static_cast<double>(renderWidth) * renderHeight / (traceGpuMs * 1e3);
+            ImGui::Text("Trace: %.2f ms (%.1f Mrays/s primary)", traceGpuMs, mrays);
+            if (denoise) {
+                ImGui::Text("Denoise: %.2f ms", denoiseGpuMs);
+            }
+        }
+        ImGui::Separator();
+
+        ImGui::Text("Scene");
+        ImGui::Text("Meshes: %zu  Instances: %zu  Materials: %zu",
+                    scene.meshes.size(), scene.instances.size(), scene.materials.size());
+        ImGui::Text("Primitives: %u stored, %u instanced", accel.blasStats.primitiveCount,
+                    scene.primitiveCountInInstances());
+        ImGui::Text("Mesh: %u triangles, %zu vertices, %zu textures", scene.meshTriangleCount(),
+                    scene.vertexPositions.size(), scene.textures.size());
+        if (ImGui::SliderInt("Random Objects", &randomObjectCount, 0, MAX_RANDOM_OBJECTS)) {
+            rebuildScene();
+        }
+        ImGui::Checkbox("Use BVH", &useBvh);
+        const rt::BlasStats& blasStats = accel.blasStats;
+        ImGui::Text("BLAS: %.2f ms (%u threads), %u nodes, depth %u",
+                    blasStats.buildMs, buildPool.threadCount(), blasStats.nodeCount, blasStats.maxDepth);
+        const rt::BvhStats& tlasStats = accel.tlas.stats;
+        ImGui::Text("TLAS: %u nodes, depth %u, SAH cost %.1f", tlasStats.nodeCount, tlasStats.maxDepth, tlasStats.sahCost);
+        ImGui::Checkbox("Rebuild TLAS", &rebuildTlas);
+        ImGui::Text("TLAS %s: %.3f ms", accel.lastUpdateRebuilt ? "rebuild" : "refit", accel.updateMs);
+        ImGui::Separator();
+
+        ImGui::Text("Accumulation");
+        ImGui::Checkbox("Accumulate", &accumulate);
+        if (accumulate) {
+            ImGui::SliderInt("Max Samples", &maxSamples, 1, 4096);
+            ImGui::Text("Samples: %u", std::min<uint32_t>(accumulatedFrames, static_cast<uint32_t>(maxSamples)));
+            if (ImGui::Button("Reset Accumulation")) {
+                accumulatedFrames = 0;
+            }
+        }
         ImGui::Separator();
 
         ImGui::Text("Ray Tracing Features");
+        const char* renderModes[] = {"Whitted", "Path (megakernel)", "Path (wavefront)"};
+        ImGui::Combo("Renderer", &renderMode, renderModes, IM_ARRAYSIZE(renderModes));
+        if (renderMode != rt::RENDER_WHITTED) {
+            ImGui::SliderInt("Max Bounces", &pathBounces, 0, static_cast<int>(rt::MAX_PATH_BOUNCES));
+        }
+        if (renderMode == rt::RENDER_PATH_WAVEFRONT) {
+            ImGui::Checkbox("Sort Secondary Rays", &sortRays);
+        }
+        if (renderMode == rt::RENDER_PATH_WAVEFRONT && wavefrontStatsValid) {
+            // 튕김마다 살아 있는 광선 / 맞은 광선 / 그림자 광선 (끝난 경로는 큐에서 빠짐)
+            for (int bounce = 0; bounce <= pathBounces; bounce++) {
+                ImGui::Text("Bounce %d: %u rays, %u hits, %u shadow", bounce, wavefrontStats.rayCount[bounce],
+                            wavefrontStats.hitCount[bounce], wavefrontStats.shadowCount[bounce]);
+            }
+            ImGui::Text("Traversal SIMD: primary %.0f%%, secondary %.0f%%, shadow %.0f%%",
+                        100.0 * wavefrontStats.simdEfficiency(rt::COHERENCE_PRIMARY),
+                        100.0 * wavefrontStats.simdEfficiency(rt::COHERENCE_SECONDARY),
+                        100.0 * wavefrontStats.simdEfficiency(rt::COHERENCE_SHADOW));
+        } else if (wavefrontStatsValid) {
+            // megakernel: subgroup 안 invocation마다 광선 수 / 경로 길이가 달라 가장 긴 lane을 기다림
+            ImGui::Text("Traversal SIMD: %.0f%% (inline)", 100.0 * wavefrontStats.simdEfficiency(rt::COHERENCE_MEGAKERNEL));
+        }
         ImGui::Checkbox("Show Shadows", &showShadows);
-        if (showShadows) {
+        if (showShadows && renderMode == rt::RENDER_WHITTED) {
             ImGui::SliderFloat("Shadow Intensity", &shadowIntensity, 0.0f, 1.0f);
         }
         ImGui::Checkbox("Reflections", &showReflections);
 
+        ImGui::Separator();
+        ImGui::Text("Denoiser");
+        ImGui::Checkbox("Denoise", &denoise);
+        if (denoise) {
+            ImGui::SliderInt("Iterations", &denoiseIterations, 1, MAX_DENOISE_ITERATIONS);
+            ImGui::Checkbox("Temporal Variance", &denoiseTemporalVariance);
+            ImGui::SliderFloat("Color Sigma", &denoisePhiColor, 0.5f, 16.0f);
+            ImGui::SliderFloat("Normal Power", &denoisePhiNormal, 1.0f, 256.0f);
+            ImGui::SliderFloat("Depth Sigma", &denoisePhiDepth, 0.001f, 0.2f);
+        }
+
+        ImGui::Separator();
+        ImGui::Text("Resolution");
+        ImGui::Checkbox("Dynamic Resolution", &dynamicResolution);
+        if (dynamicResolution) {
+            ImGui::SliderFloat("Target GPU ms", &targetGpuMs, 0.5f, 33.0f);
+            ImGui::Text("Render Scale: %.2f", renderScale);
+        } else if (ImGui::SliderFloat("Render Scale", &renderScale, MIN_RENDER_SCALE, 1.0f)) {
+            applyRenderScale();
+        }
+        const char* upscaleModes[] = {"Bilinear", "Edge-aware"};
+        ImGui::Combo("Upscale", &upscaleMode, upscaleModes, IM_ARRAYSIZE(upscaleModes));
+        if (renderMode != rt::RENDER_PATH_WAVEFRONT) {
+            ImGui::Checkbox("Variable Rate", &variableRate);
+            if (variableRate && renderTiles > 0) {
+                ImGui::Text("Half-rate tiles: %u / %u", halfRateTiles, renderTiles);
+            }
+        }
+
         ImGui::Separator();
         ImGui::Text("Animation");
         ImGui::Checkbox("Animate Light", &animateLight);
         ImGui::Checkbox("Animate Sphere", &animateSphere);
+        ImGui::Checkbox("Animate Instances", &animateInstances);
 
         ImGui::Separator();
         ImGui::Text("Camera");
@@ -1164,12 +2417,253 @@ private:
         ImGui::ColorEdit3("Color", &sphereColor.x);
         ImGui::SliderFloat("Radius", &sphereRadius, 0.1f, 3.0f);
         ImGui::SliderFloat("Shininess", &sphereShininess, 1.0f, 128.0f);
+        ImGui::SliderFloat("Reflectivity", &sphereReflectivity, 0.0f, 1.0f);
 
         ImGui::End();
 
         ImGui::Render();
     }
 
+    // ========================================================================
+    // CPU Reference Tracer
+    // ========================================================================
+    // 검증 / 벤치마크는 움직이지 않는 장면으로 (GPU와 CPU가 같은 time의 같은 변환을 보도록)
+    void freezeAnimation() {
+        animateLight = false;
+        animateSphere = false;
+        animateInstances = false;
+        accumulate = false;  // 리셋 프레임 = 픽셀 중심 1 샘플 (CPU 트레이서와 같은 광선)
+    }
+
+    void printCpuTraceStats(rt::TracePath path, const rt::CpuTraceStats& stats) {
+        std::cout << "CPU trace (" << rt::tracePathName(path) << ", " << stats.threadCount << " threads): "
+                  << stats.ms << " ms, " << stats.totalRays << " rays (" << stats.primaryRays << " primary), "
+                  << stats.totalRays / (stats.ms * 1e3) << " Mrays/s, "
+                  << stats.stolenTiles << "/" << stats.tileCount << " tiles stolen" << std::endl;
+    }
+
+    // 스레드 수 1, 2, 4, ... , 하드웨어 스레드 수 × 경로 (스칼라 / AVX2)
+    void measureCpuTraceThroughput(const rt::RayTracePushConstants& pc) {
+        unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<unsigned> threadCounts;
+        for (unsigned threads = 1; threads < hardwareThreads; threads *= 2) {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(hardwareThreads);
+
+        std::vector<rt::TracePath> paths = {rt::TracePath::Scalar};
+        if (rt::bestTracePath() == rt::TracePath::Avx2) {
+            paths.push_back(rt::TracePath::Avx2);
+        }
+
+        std::vector<uint8_t> pixels;
+        for (rt::TracePath path : paths) {
+            for (unsigned threads : threadCounts) {
+                rt::TaskPool pool(threads);
+                rt::CpuTraceStats best;
+                for (int run = 0; run < CPU_BENCHMARK_RUNS; run++) {
+                    rt::CpuTraceStats stats = rt::traceImage(accel, scene, pc, RT_WIDTH, RT_HEIGHT,
+                                                             pool, pixels, path);
+                    if (run == 0 || stats.ms < best.ms) {
+                        best = stats;
+                    }
+                }
+                printCpuTraceStats(path, best);
+            }
+        }
+    }
+
+    // pc로 frame 0 슬롯에 한 프레임 dispatch하고 끝날 때까지 기다림
+    // 반환값: GPU 시간 (timestamp, 지원하지 않으면 제출부터 완료까지의 벽시계 시간)
+    // pixels가 있으면 rtImage를 host로 복사해 옴
+    double traceOnce(const rt::RayTracePushConstants& pc, std::vector<uint8_t>* pixels) {
+        currentFrame = 0;
+        VkDeviceSize readbackBytes = VkDeviceSize(RT_WIDTH) * RT_HEIGHT * 4;
+        VkBuffer readback = VK_NULL_HANDLE;
+        VkDeviceMemory readbackMemory = VK_NULL_HANDLE;
+        if (pixels) {
+            createBuffer(readbackBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         readback, readbackMemory);
+        }
+
+        VkCommandBuffer cmd = beginSingleTimeCommands();
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            vkCmdResetQueryPool(cmd, timestampQueryPool, 0, 2);
+            vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampQueryPool, 0);
+        }
+        recordRayTrace(cmd, pc);
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, timestampQueryPool, 1);
+        }
+
+        if (pixels) {
+            VkImageMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = rtImage;
+            barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+            barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            vkCmdPipelineBarrier(cmd,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            VkBufferImageCopy region{};
+            region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            region.imageExtent = {RT_WIDTH, RT_HEIGHT, 1};
+            vkCmdCopyImageToBuffer(cmd, rtImage, VK_IMAGE_LAYOUT_GENERAL, readback, 1, &region);
+        }
+
+        auto submitTime = std::chrono::high_resolution_clock::now();
+        endSingleTimeCommands(cmd);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - submitTime).count();
+
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            uint64_t ticks[2] = {};
+            if (vkGetQueryPoolResults(device, timestampQueryPool, 0, 2, sizeof(ticks), ticks, sizeof(uint64_t),
+                                      VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) == VK_SUCCESS) {
+                ms = static_cast<double>(ticks[1] - ticks[0]) * timestampPeriod * 1e-6;
+            }
+        }
+
+        if (pixels) {
+            pixels->resize(readbackBytes);
+            void* mapped;
+            vkMapMemory(device, readbackMemory, 0, readbackBytes, 0, &mapped);
+            memcpy(pixels->data(), mapped, pixels->size());
+            vkUnmapMemory(device, readbackMemory);
+            destroyBuffer(readback, readbackMemory);
+        }
+        return ms;
+    }
+
+    // 채널 오차가 tolerance를 넘는 픽셀 수 (maxError = 가장 큰 채널 오차)
+    size_t countMismatches(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, int tolerance, int& maxError) {
+        size_t pixelCount = size_t(RT_WIDTH) * RT_HEIGHT;
+        size_t mismatches = 0;
+        maxError = 0;
+        for (size_t i = 0; i < pixelCount; i++) {
+            int error = 0;
+            for (int c = 0; c < 3; c++) {
+                error = std::max(error, std::abs(int(a[i * 4 + c]) - int(b[i * 4 + c])));
+            }
+            maxError = std::max(maxError, error);
+            if (error > tolerance) {
+                mismatches++;
+            }
+        }
+        return mismatches;
+    }
+
+    // time 0 프레임을 frame 0 슬롯으로 한 번 dispatch → rtImage를 host 버퍼로 복사 → CPU 결과와 비교
+    bool compareWithCpuTrace(const std::string& outputPrefix) {
+        currentFrame = 0;
+        updateSceneBuffers(0.0f);
+        rt::RayTracePushConstants pc = makePushConstants(0.0f);
+        updateAccumulation(pc);
+
+        std::vector<uint8_t> gpuPixels;
+        traceOnce(pc, &gpuPixels);
+
+        std::vector<uint8_t> cpuPixels;
+        rt::CpuTraceStats stats = rt::traceImage(accel, scene, pc, RT_WIDTH, RT_HEIGHT, buildPool, cpuPixels);
+        printCpuTraceStats(rt::bestTracePath(), stats);
+
+        size_t pixelCount = size_t(RT_WIDTH) * RT_HEIGHT;
+        int maxError = 0;
+        size_t mismatches = countMismatches(gpuPixels, cpuPixels, CPU_COMPARE_CHANNEL_TOLERANCE, maxError);
+
+        if (!outputPrefix.empty()) {
+            bool written = rt::writePpm(outputPrefix + "_gpu.ppm", RT_WIDTH, RT_HEIGHT, gpuPixels) &&
+                           rt::writePpm(outputPrefix + "_cpu.ppm", RT_WIDTH, RT_HEIGHT, cpuPixels);
+            std::cout << (written ? "Wrote " : "Failed to write ") << outputPrefix << "_gpu.ppm / "
+                      << outputPrefix << "_cpu.ppm" << std::endl;
+        }
+
+        double ratio = static_cast<double>(mismatches) / pixelCount;
+        bool ok = ratio <= CPU_COMPARE_MAX_MISMATCH_RATIO;
+        std::cout << "GPU vs CPU reference (" << scene.instances.size() << " instances): " << mismatches << "/"
+                  << pixelCount << " pixels differ by more than " << CPU_COMPARE_CHANNEL_TOLERANCE
+                  << " (max error " << maxError << ") - " << (ok ? "PASS" : "FAIL") << std::endl;
+        return ok;
+    }
+
+    // ========================================================================
+    // Path Tracing Benchmark
+    // ========================================================================
+    // 튕김 횟수마다 megakernel / wavefront / 정렬한 wavefront를 PATH_BENCHMARK_FRAMES번씩 그려 가장 빠른 GPU 시간을 비교
+    // 광선 수는 wavefront 카운터 (세 방식이 같은 광선을 쏨), 이미지는 마지막 프레임을 megakernel과 비교
+    // traversal SIMD 효율 = 마지막 프레임 카운터 (정렬 전 / 후의 2차 광선 일관성 차이, inline megakernel과 비교)
+    bool comparePathTracers() {
+        currentFrame = 0;
+        updateSceneBuffers(0.0f);
+        rt::RayTracePushConstants pc = makePushConstants(0.0f);
+        updateAccumulation(pc);
+
+        std::cout << "Path tracing " << RT_WIDTH << "x" << RT_HEIGHT << ", " << scene.instances.size()
+                  << " instances, best of " << PATH_BENCHMARK_FRAMES << " frames" << std::endl;
+
+        const char* names[3] = {"megakernel", "wavefront", "sorted"};
+        const rt::RenderMode modes[3] = {rt::RENDER_PATH_MEGAKERNEL, rt::RENDER_PATH_WAVEFRONT, rt::RENDER_PATH_WAVEFRONT};
+        const int sorted[3] = {0, 0, 1};
+
+        bool ok = true;
+        for (uint32_t bounces : PATH_BENCHMARK_BOUNCES) {
+            pc.maxBounces = bounces;
+
+            double bestMs[3] = {0.0, 0.0, 0.0};
+            std::array<std::vector<uint8_t>, 3> pixels;
+            std::array<rt::WavefrontCounters, 3> counters;
+            for (int m = 0; m < 3; m++) {
+                pc.renderMode = modes[m];
+                pc.sortRays = sorted[m];
+                for (int frame = 0; frame < PATH_BENCHMARK_FRAMES; frame++) {
+                    bool last = frame == PATH_BENCHMARK_FRAMES - 1;
+                    double ms = traceOnce(pc, last ? &pixels[m] : nullptr);
+                    if (frame == 0 || ms < bestMs[m]) {
+                        bestMs[m] = ms;
+                    }
+                }
+                memcpy(&counters[m], wavefront.counters[0].mapped, sizeof(rt::WavefrontCounters));
+            }
+
+            uint64_t rays = 0;
+            for (uint32_t bounce = 0; bounce <= bounces; bounce++) {
+                rays += counters[1].rayCount[bounce] + counters[1].shadowCount[bounce];
+            }
+
+            std::cout << "Bounces " << bounces << ": " << rays << " rays (last bounce " << counters[1].rayCount[bounces]
+                      << " rays)" << std::endl;
+            for (int m = 0; m < 3; m++) {
+                std::cout << "  " << names[m] << " " << bestMs[m] << " ms (" << rays / (bestMs[m] * 1e3)
+                          << " Mrays/s, " << bestMs[0] / bestMs[m] << "x) | traversal SIMD ";
+                if (m == 0) {
+                    std::cout << 100.0 * counters[m].simdEfficiency(rt::COHERENCE_MEGAKERNEL) << "% (inline)";
+                } else {
+                    std::cout << "primary " << 100.0 * counters[m].simdEfficiency(rt::COHERENCE_PRIMARY)
+                              << "%, secondary " << 100.0 * counters[m].simdEfficiency(rt::COHERENCE_SECONDARY)
+                              << "%, shadow " << 100.0 * counters[m].simdEfficiency(rt::COHERENCE_SHADOW) << "%";
+                }
+
+                if (m > 0) {
+                    int maxError = 0;
+                    size_t mismatches = countMismatches(pixels[0], pixels[m], CPU_COMPARE_CHANNEL_TOLERANCE, maxError);
+                    double ratio = static_cast<double>(mismatches) / (size_t(RT_WIDTH) * RT_HEIGHT);
+                    bool match = ratio <= PATH_COMPARE_MAX_MISMATCH_RATIO;
+                    ok &= match;
+                    std::cout << " | " << mismatches << " pixels differ (max error " << maxError << ") - "
+                              << (match ? "PASS" : "FAIL");
+                }
+                std::cout << std::endl;
+            }
+        }
+        return ok;
+    }
+
     // ========================================================================
     // Helpers
     // ========================================================================
@@ -1197,6 +2691,42 @@ private:
         return shaderModule;
     }
 
+    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                      VkBuffer& buffer, VkDeviceMemory& memory) {
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = usage;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create buffer!");
+        }
+
+        VkMemoryRequirements memReqs;
+        vkGetBufferMemoryRequirements(device, buffer, &memReqs);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memReqs.size;
+        allocInfo.memoryTypeIndex = findMemoryType(memReqs.memoryTypeBits, properties);
+
+        if (vkAllocateMemory(device, &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate buffer memory!");
+        }
+        vkBindBufferMemory(device, buffer, memory, 0);
+    }
+
+    // map된 메모리는 vkFreeMemory가 함께 해제
+    void destroyBuffer(VkBuffer& buffer, VkDeviceMemory& memory) {
+        if (buffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(device, buffer, nullptr);
+            vkFreeMemory(device, memory, nullptr);
+        }
+        buffer = VK_NULL_HANDLE;
+        memory = VK_NULL_HANDLE;
+    }
+
     uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
         VkPhysicalDeviceMemoryProperties memProps;
         vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProps);
@@ -1229,12 +2759,61 @@ private:
         vkDestroyImageView(device, rtImageView, nullptr);
         vkDestroyImage(device, rtImage, nullptr);
         vkFreeMemory(device, rtImageMemory, nullptr);
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            destroyStorageImage(historyColorImages[i]);
+            destroyStorageImage(historyDepthImages[i]);
+            destroyStorageImage(historyMomentsImages[i]);
+        }
+        destroyStorageImage(albedoImage);
+        destroyStorageImage(normalImage);
+        for (StorageImage& image : denoiseImages) {
+            destroyStorageImage(image);
+        }
+        for (TextureImage& texture : textureImages) {
+            vkDestroyImageView(device, texture.view, nullptr);
+            vkDestroyImage(device, texture.image, nullptr);
+            vkFreeMemory(device, texture.memory, nullptr);
+        }
+        vkDestroySampler(device, textureSampler, nullptr);
+
+        for (auto& buffers : sceneBuffers) {
+            destroyBuffer(buffers.primitives.buffer, buffers.primitives.memory);
+            destroyBuffer(buffers.materials.buffer, buffers.materials.memory);
+            destroyBuffer(buffers.blasNodes.buffer, buffers.blasNodes.memory);
+            destroyBuffer(buffers.tlasNodes.buffer, buffers.tlasNodes.memory);
+            destroyBuffer(buffers.instances.buffer, buffers.instances.memory);
+            destroyBuffer(buffers.vertexPositions.buffer, buffers.vertexPositions.memory);
+            destroyBuffer(buffers.vertexNormals.buffer, buffers.vertexNormals.memory);
+            destroyBuffer(buffers.vertexUvs.buffer, buffers.vertexUvs.memory);
+            destroyBuffer(buffers.triangleIndices.buffer, buffers.triangleIndices.memory);
+        }
+        destroyBuffer(wavefront.paths.buffer, wavefront.paths.memory);
+        destroyBuffer(wavefront.rays.buffer, wavefront.rays.memory);
+        destroyBuffer(wavefront.hits.buffer, wavefront.hits.memory);
+        destroyBuffer(wavefront.shadows.buffer, wavefront.shadows.memory);
+        destroyBuffer(wavefront.raySort.buffer, wavefront.raySort.memory);
+        for (MappedBuffer& counters : wavefront.counters) {
+            destroyBuffer(counters.buffer, counters.memory);
+        }
+        for (MappedBuffer& rates : tileRateBuffers) {
+            destroyBuffer(rates.buffer, rates.memory);
+        }
+        if (timestampQueryPool != VK_NULL_HANDLE) {
+            vkDestroyQueryPool(device, timestampQueryPool, nullptr);
+        }
 
-        vkDestroyPipeline(device, computePipeline, nullptr);
+        for (VkPipeline pipeline : computePipelines) {
+            vkDestroyPipeline(device, pipeline, nullptr);
+        }
         vkDestroyPipelineLayout(device, computePipelineLayout, nullptr);
         vkDestroyDescriptorPool(device, computeDescriptorPool, nullptr);
         vkDestroyDescriptorSetLayout(device, computeDescriptorSetLayout, nullptr);
 
+        vkDestroyPipeline(device, denoisePipeline, nullptr);
+        vkDestroyPipelineLayout(device, denoisePipelineLayout, nullptr);
+        vkDestroyDescriptorPool(device, denoiseDescriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(device, denoiseDescriptorSetLayout, nullptr);
+
         vkDestroyPipeline(device, graphicsPipeline, nullptr);
         vkDestroyPipelineLayout(device, graphicsPipelineLayout, nullptr);
         vkDestroyDescriptorPool(device, graphicsDescriptorPool, nullptr);
@@ -1272,9 +2851,38 @@ private:
 // ============================================================================
 // Main
 // ============================================================================
-int main() {
+// 사용법:
+//   ch02-10
+//   ch02-10 --cpu-trace <out.ppm> [randomObjects=0]   (GPU 없이 CPU 레퍼런스 + 스레드별 처리량)
+//   ch02-10 --compare [outPrefix] [randomObjects=0]   (GPU 결과를 CPU 레퍼런스와 비교)
+//   ch02-10 --path-benchmark [randomObjects=0]        (경로 추적 megakernel vs wavefront vs 정렬, 튕김 횟수별)
+// 모든 모드 앞에 --mesh <file.obj>를 붙이면 OBJ를 기본 장면에 추가 (삼각형 처리량 측정)
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+
     try {
         SoftwareRayTracerApp app;
+        if (args.size() >= 2 && args[0] == "--mesh") {
+            if (!app.loadMesh(args[1])) {
+                return EXIT_FAILURE;
+            }
+            args.erase(args.begin(), args.begin() + 2);
+        }
+
+        if (args.size() >= 2 && args[0] == "--cpu-trace") {
+            int objects = args.size() >= 3 ? std::stoi(args[2]) : 0;
+            return app.runCpuTrace(args[1], objects) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        if (args.size() >= 1 && args[0] == "--compare") {
+            std::string prefix = args.size() >= 2 ? args[1] : std::string();
+            int objects = args.size() >= 3 ? std::stoi(args[2]) : 0;
+            return app.runGpuComparison(prefix, objects) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        if (args.size() >= 1 && args[0] == "--path-benchmark") {
+            int objects = args.size() >= 2 ? std::stoi(args[1]) : 0;
+            return app.runPathBenchmark(objects) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
         app.run();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -0,0 +1,504 @@
+#include "scene.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <random>
+#include <sstream>
+
+namespace rt {
+
+namespace {
+
+// 토러스 (y축 둘레, xz 평면에 누움) 인덱스 삼각형 mesh: 2 * majorSegments * minorSegments개
+// 정점은 (majorSegments + 1) x (minorSegments + 1) 격자 (uv 이음매에서 위치는 같고 uv만 다른 정점을 둠)
+// 노말 = 관 중심선에서 바깥 방향 (해석적), uv = (큰 원 방향 uRepeat번, 관 둘레 1번)
+TriangleMesh makeTorus(float majorRadius, float minorRadius, uint32_t majorSegments, uint32_t minorSegments,
+                       float uRepeat) {
+    TriangleMesh mesh;
+    for (uint32_t i = 0; i <= majorSegments; i++) {
+        for (uint32_t j = 0; j <= minorSegments; j++) {
+            float u = 6.2831853f * static_cast<float>(i % majorSegments) / majorSegments;
+            float v = 6.2831853f * static_cast<float>(j % minorSegments) / minorSegments;
+            glm::vec3 normal(std::cos(v) * std::cos(u), std::sin(v), std::cos(v) * std::sin(u));
+            glm::vec3 ring(majorRadius * std::cos(u), 0.0f, majorRadius * std::sin(u));
+            mesh.positions.push_back(ring + minorRadius * normal);
+            mesh.normals.push_back(normal);
+            mesh.uvs.push_back(glm::vec2(uRepeat * static_cast<float>(i) / majorSegments,
+                                         static_cast<float>(j) / minorSegments));
+        }
+    }
+
+    uint32_t stride = minorSegments + 1;
+    for (uint32_t i = 0; i < majorSegments; i++) {
+        for (uint32_t j = 0; j < minorSegments; j++) {
+            uint32_t a = i * stride + j;
+            uint32_t b = (i + 1) * stride + j;
+            uint32_t c = (i + 1) * stride + j + 1;
+            uint32_t d = i * stride + j + 1;
+            mesh.indices.insert(mesh.indices.end(), {a, b, c, a, c, d});
+        }
+    }
+    return mesh;
+}
+
+Primitive makeMeshTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, uint32_t triangle,
+                           uint32_t material) {
+    Primitive primitive{glm::min(glm::min(a, b), c), PRIMITIVE_MESH_TRIANGLE, glm::max(glm::max(a, b), c),
+                        material, glm::vec3(0.0f), 0.0f};
+    std::memcpy(&primitive.param, &triangle, sizeof(triangle));
+    return primitive;
+}
+
+glm::vec3 toColor8(const glm::vec3& color) {
+    return glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+}
+
+// OBJ 면 정점 "v", "v/vt", "v//vn", "v/vt/vn" → 0부터 시작하는 인덱스 (없으면 -1)
+// 음수 = 지금까지 읽은 배열의 끝에서부터
+bool parseObjIndex(const std::string& token, size_t start, size_t end, size_t count, int64_t& index) {
+    if (start >= end) {
+        index = -1;
+        return true;
+    }
+    char* parsedEnd = nullptr;
+    long long value = std::strtoll(token.c_str() + start, &parsedEnd, 10);
+    if (parsedEnd != token.c_str() + end || value == 0) {
+        return false;
+    }
+    index = value > 0 ? value - 1 : static_cast<int64_t>(count) + value;
+    return index >= 0 && index < static_cast<int64_t>(count);
+}
+
+glm::mat4 translateScale(const glm::vec3& position, const glm::vec3& scale) {
+    return glm::scale(glm::translate(glm::mat4(1.0f), position), scale);
+}
+
+} // namespace
+
+uint32_t Scene::addMaterial(const Material& material) {
+    materials.push_back(material);
+    return static_cast<uint32_t>(materials.size() - 1);
+}
+
+uint32_t Scene::addTexture(const Texture& texture) {
+    textures.push_back(texture);
+    return static_cast<uint32_t>(textures.size() - 1);
+}
+
+uint32_t Scene::addMesh(const std::vector<Primitive>& meshPrimitives) {
+    Mesh mesh{static_cast<uint32_t>(primitives.size()), 0};
+    for (const Primitive& primitive : meshPrimitives) {
+        if (primitive.type != PRIMITIVE_PLANE) {
+            primitives.push_back(primitive);
+            mesh.primitiveCount++;
+        }
+    }
+    meshes.push_back(mesh);
+    return static_cast<uint32_t>(meshes.size() - 1);
+}
+
+uint32_t Scene::addTriangleMesh(const TriangleMesh& mesh, uint32_t material) {
+    uint32_t baseVertex = static_cast<uint32_t>(vertexPositions.size());
+    size_t vertexCount = mesh.positions.size();
+
+    // 노말이 없으면 정점에 닿은 면 노말을 넓이 가중으로 더함 (cross 길이 = 넓이 2배)
+    std::vector<glm::vec3> normals = mesh.normals;
+    if (normals.size() != vertexCount) {
+        normals.assign(vertexCount, glm::vec3(0.0f));
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const uint32_t* tri = &mesh.indices[i];
+            glm::vec3 faceNormal = glm::cross(mesh.positions[tri[1]] - mesh.positions[tri[0]],
+                                              mesh.positions[tri[2]] - mesh.positions[tri[0]]);
+            for (int k = 0; k < 3; k++) {
+                normals[tri[k]] += faceNormal;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < vertexCount; i++) {
+        glm::vec3 normal = normals[i];
+        float length = glm::length(normal);
+        normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+        vertexPositions.push_back(glm::vec4(mesh.positions[i], 0.0f));
+        vertexNormals.push_back(glm::vec4(normal, 0.0f));
+        vertexUvs.push_back(i < mesh.uvs.size() ? mesh.uvs[i] : glm::vec2(0.0f));
+    }
+
+    std::vector<Primitive> triangles;
+    triangles.reserve(mesh.indices.size() / 3);
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        const uint32_t* tri = &mesh.indices[i];
+        const glm::vec3& a = mesh.positions[tri[0]];
+        const glm::vec3& b = mesh.positions[tri[1]];
+        const glm::vec3& c = mesh.positions[tri[2]];
+        if (glm::cross(b - a, c - a) == glm::vec3(0.0f)) {
+            continue;  // 넓이 0: watertight 검사도 항상 놓치므로 BVH에서 뺌
+        }
+        uint32_t triangle = static_cast<uint32_t>(triangleIndices.size() / 3);
+        triangleIndices.insert(triangleIndices.end(), {baseVertex + tri[0], baseVertex + tri[1], baseVertex + tri[2]});
+        triangles.push_back(makeMeshTriangle(a, b, c, triangle, material));
+    }
+    return addMesh(triangles);
+}
+
+uint32_t Scene::addInstance(uint32_t mesh, const glm::mat4& transform, uint32_t material,
+                            const InstanceAnimation& animation) {
+    instances.push_back({transform, mesh, material, animation});
+    return static_cast<uint32_t>(instances.size() - 1);
+}
+
+uint32_t Scene::addPlane(const glm::vec3& normal, float offset, uint32_t material) {
+    planes.push_back({glm::normalize(normal), PRIMITIVE_PLANE, glm::vec3(0.0f), material, glm::vec3(0.0f), offset});
+    return static_cast<uint32_t>(planes.size() - 1);
+}
+
+uint32_t Scene::primitiveCountInInstances() const {
+    uint32_t count = 0;
+    for (const Instance& instance : instances) {
+        count += meshes[instance.mesh].primitiveCount;
+    }
+    return count;
+}
+
+uint32_t Scene::meshTriangleCount() const {
+    return static_cast<uint32_t>(triangleIndices.size() / 3);
+}
+
+Primitive makeSphere(const glm::vec3& center, float radius, uint32_t material) {
+    return {center, PRIMITIVE_SPHERE, glm::vec3(0.0f), material, glm::vec3(0.0f), radius};
+}
+
+Primitive makeTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, uint32_t material) {
+    return {a, PRIMITIVE_TRIANGLE, b, material, c, 0.0f};
+}
+
+Primitive makeBox(const glm::vec3& min, const glm::vec3& max, uint32_t material) {
+    return {min, PRIMITIVE_BOX, max, material, glm::vec3(0.0f), 0.0f};
+}
+
+Material solidMaterial(const glm::vec3& color, float shininess, float reflectivity) {
+    Material material{};
+    material.color = color;
+    material.shininess = shininess;
+    material.color2 = color;
+    material.reflectivity = reflectivity;
+    material.pattern = PATTERN_SOLID;
+    material.patternScale = 1.0f;
+    material.textureIndex = NO_TEXTURE;
+    return material;
+}
+
+Texture makeCheckerTexture(uint32_t size, uint32_t cells, const glm::vec3& colorA, const glm::vec3& colorB) {
+    Texture texture;
+    texture.width = size;
+    texture.height = size;
+    texture.rgba.resize(size_t(size) * size * 4);
+    glm::vec3 a = toColor8(colorA);
+    glm::vec3 b = toColor8(colorB);
+    uint32_t cellSize = std::max(size / cells, 1u);
+    for (uint32_t y = 0; y < size; y++) {
+        for (uint32_t x = 0; x < size; x++) {
+            const glm::vec3& color = ((x / cellSize + y / cellSize) & 1) == 0 ? a : b;
+            uint8_t* texel = &texture.rgba[(size_t(y) * size + x) * 4];
+            texel[0] = static_cast<uint8_t>(color.x);
+            texel[1] = static_cast<uint8_t>(color.y);
+            texel[2] = static_cast<uint8_t>(color.z);
+            texel[3] = 255;
+        }
+    }
+    return texture;
+}
+
+Texture makeStripeTexture(uint32_t size, uint32_t stripes, const glm::vec3& colorA, const glm::vec3& colorB) {
+    Texture texture;
+    texture.width = size;
+    texture.height = size;
+    texture.rgba.resize(size_t(size) * size * 4);
+    glm::vec3 a = toColor8(colorA);
+    glm::vec3 b = toColor8(colorB);
+    for (uint32_t y = 0; y < size; y++) {
+        // 경계를 한 텍셀 섞어 bilinear로 확대해도 계단이 덜 보이게
+        float phase = static_cast<float>(y) * stripes / size;
+        float f = phase - std::floor(phase);
+        float blend = glm::clamp((std::abs(f - 0.5f) - 0.25f) * size / stripes + 0.5f, 0.0f, 1.0f);
+        glm::vec3 color = glm::mix(b, a, blend);
+        for (uint32_t x = 0; x < size; x++) {
+            uint8_t* texel = &texture.rgba[(size_t(y) * size + x) * 4];
+            texel[0] = static_cast<uint8_t>(color.x);
+            texel[1] = static_cast<uint8_t>(color.y);
+            texel[2] = static_cast<uint8_t>(color.z);
+            texel[3] = 255;
+        }
+    }
+    return texture;
+}
+
+bool loadObj(const std::string& path, TriangleMesh& mesh, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> uvs;
+    std::vector<glm::vec3> normals;
+    std::map<std::array<int64_t, 3>, uint32_t> vertexMap;  // (v, vt, vn) → mesh 정점
+    std::vector<std::array<int64_t, 3>> corners;
+    bool allNormals = true;
+    bool anyUv = false;
+    mesh = TriangleMesh{};
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream stream(line);
+        std::string keyword;
+        stream >> keyword;
+
+        if (keyword == "v") {
+            glm::vec3 p;
+            stream >> p.x >> p.y >> p.z;
+            positions.push_back(p);
+        } else if (keyword == "vt") {
+            glm::vec2 uv;
+            stream >> uv.x >> uv.y;
+            uvs.push_back(uv);
+        } else if (keyword == "vn") {
+            glm::vec3 n;
+            stream >> n.x >> n.y >> n.z;
+            normals.push_back(n);
+        } else if (keyword != "f") {
+            continue;  // 주석, o / g / s / usemtl / mtllib 등
+        }
+        if (stream.fail()) {
+            error = path + ":" + std::to_string(lineNumber) + ": malformed '" + keyword + "' line";
+            return false;
+        }
+        if (keyword != "f") {
+            continue;
+        }
+
+        corners.clear();
+        std::string token;
+        while (stream >> token) {
+            size_t slash1 = token.find('/');
+            size_t slash2 = slash1 == std::string::npos ? std::string::npos : token.find('/', slash1 + 1);
+            size_t end0 = slash1 == std::string::npos ? token.size() : slash1;
+            size_t end1 = slash2 == std::string::npos ? token.size() : slash2;
+
+            std::array<int64_t, 3> corner{-1, -1, -1};
+            bool ok = parseObjIndex(token, 0, end0, positions.size(), corner[0]) && corner[0] >= 0;
+            if (ok && slash1 != std::string::npos) {
+                ok = parseObjIndex(token, slash1 + 1, end1, uvs.size(), corner[1]);
+            }
+            if (ok && slash2 != std::string::npos) {
+                ok = parseObjIndex(token, slash2 + 1, token.size(), normals.size(), corner[2]);
+            }
+            if (!ok) {
+                error = path + ":" + std::to_string(lineNumber) + ": bad face index '" + token + "'";
+                return false;
+            }
+            corners.push_back(corner);
+        }
+        if (corners.size() < 3) {
+            error = path + ":" + std::to_string(lineNumber) + ": face with fewer than 3 vertices";
+            return false;
+        }
+
+        uint32_t first = 0;
+        uint32_t previous = 0;
+        for (size_t i = 0; i < corners.size(); i++) {
+            const std::array<int64_t, 3>& corner = corners[i];
+            auto found = vertexMap.find(corner);
+            uint32_t vertex;
+            if (found != vertexMap.end()) {
+                vertex = found->second;
+            } else {
+                vertex = static_cast<uint32_t>(mesh.positions.size());
+                vertexMap.emplace(corner, vertex);
+                mesh.positions.push_back(positions[corner[0]]);
+                mesh.uvs.push_back(corner[1] >= 0 ? uvs[corner[1]] : glm::vec2(0.0f));
+                mesh.normals.push_back(corner[2] >= 0 ? normals[corner[2]] : glm::vec3(0.0f));
+                anyUv |= corner[1] >= 0;
+                allNormals &= corner[2] >= 0;
+            }
+
+            // fan: (0, i - 1, i)
+            if (i == 0) {
+                first = vertex;
+            } else if (i >= 2) {
+                mesh.indices.insert(mesh.indices.end(), {first, previous, vertex});
+            }
+            previous = vertex;
+        }
+    }
+
+    if (mesh.indices.empty()) {
+        error = path + ": no faces";
+        return false;
+    }
+    if (!allNormals) {
+        mesh.normals.clear();
+    }
+    if (!anyUv) {
+        mesh.uvs.clear();
+    }
+    return true;
+}
+
+glm::mat4 animatedTransform(const Instance& instance, float time) {
+    const InstanceAnimation& animation = instance.animation;
+    if (animation.spinSpeed == 0.0f && animation.bobHeight == 0.0f) {
+        return instance.transform;
+    }
+
+    glm::vec3 bob(0.0f, animation.bobHeight * (std::sin(time * 2.0f + animation.phase) + 1.0f), 0.0f);
+    glm::mat4 spin = glm::rotate(glm::mat4(1.0f), time * animation.spinSpeed + animation.phase,
+                                 glm::vec3(0.0f, 1.0f, 0.0f));
+    return glm::translate(glm::mat4(1.0f), bob) * instance.transform * spin;
+}
+
+Scene createDefaultScene() {
+    Scene scene;
+
+    // 단위 구 mesh를 구 세 개가 공유 (재질은 instance마다)
+    uint32_t mainMaterial = scene.addMaterial(solidMaterial(glm::vec3(0.2f, 0.4f, 0.9f), 64.0f, 0.3f));
+    uint32_t unitSphere = scene.addMesh({makeSphere(glm::vec3(0.0f), 1.0f, mainMaterial)});
+
+    // 메인 구: 변환/색은 매 프레임 UI 값으로 덮어씀
+    scene.addInstance(unitSphere, translateScale(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(1.0f)), mainMaterial);
+
+    uint32_t green = scene.addMaterial(solidMaterial(glm::vec3(0.2f, 0.8f, 0.2f), 64.0f, 0.3f));
+    scene.addInstance(unitSphere, translateScale(glm::vec3(-2.0f, 0.8f, -1.0f), glm::vec3(0.8f)), green);
+
+    uint32_t red = scene.addMaterial(solidMaterial(glm::vec3(0.8f, 0.2f, 0.2f), 32.0f));
+    scene.addInstance(unitSphere, translateScale(glm::vec3(2.0f, 0.5f, 1.0f), glm::vec3(0.5f)), red);
+
+    Material checker = solidMaterial(glm::vec3(0.9f), 32.0f);
+    checker.color2 = glm::vec3(0.2f);
+    checker.pattern = PATTERN_CHECKER;
+    checker.patternScale = 0.5f;
+    scene.addPlane(glm::vec3(0.0f, 1.0f, 0.0f), 0.0f, scene.addMaterial(checker));
+
+    uint32_t gold = scene.addMaterial(solidMaterial(glm::vec3(0.9f, 0.7f, 0.2f), 16.0f));
+    uint32_t unitBox = scene.addMesh({makeBox(glm::vec3(-0.5f), glm::vec3(0.5f), gold)});
+    scene.addInstance(unitBox, translateScale(glm::vec3(2.9f, 0.35f, -2.1f), glm::vec3(1.0f, 0.7f, 1.0f)));
+
+    // 사각뿔 (옆면 4개)
+    uint32_t purple = scene.addMaterial(solidMaterial(glm::vec3(0.6f, 0.3f, 0.8f), 64.0f, 0.2f));
+    glm::vec3 apex(0.0f, 1.2f, 0.0f);
+    glm::vec3 base[4] = {
+        glm::vec3(-0.6f, 0.0f, -0.6f), glm::vec3(0.6f, 0.0f, -0.6f),
+        glm::vec3(0.6f, 0.0f, 0.6f), glm::vec3(-0.6f, 0.0f, 0.6f)
+    };
+    std::vector<Primitive> pyramid;
+    for (int i = 0; i < 4; i++) {
+        pyramid.push_back(makeTriangle(base[i], base[(i + 1) % 4], apex, purple));
+    }
+    scene.addInstance(scene.addMesh(pyramid), glm::translate(glm::mat4(1.0f), glm::vec3(-2.8f, 0.0f, 1.8f)));
+
+    // 토러스 (인덱스 삼각형 1536개) instance 2개: 세워서 회전 / 눕혀서 회전
+    // 세운 것은 mesh 재질 (uv 체커 텍스처), 눕힌 것은 instance 재질 (텍스처 없는 구리색)
+    Material tealChecker = solidMaterial(glm::vec3(1.0f), 96.0f, 0.4f);
+    tealChecker.textureIndex = scene.addTexture(makeCheckerTexture(64, 8, glm::vec3(0.1f, 0.7f, 0.7f),
+                                                              glm::vec3(0.9f, 0.9f, 0.85f)));
+    uint32_t teal = scene.addMaterial(tealChecker);
+    uint32_t torus = scene.addTriangleMesh(makeTorus(0.6f, 0.2f, 48, 16, 3.0f), teal);
+
+    InstanceAnimation spin;
+    spin.spinSpeed = 0.8f;
+    glm::mat4 upright = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.85f, -3.2f)),
+                                    1.5707963f, glm::vec3(1.0f, 0.0f, 0.0f));
+    scene.addInstance(torus, upright, MATERIAL_FROM_MESH, spin);
+
+    uint32_t copper = scene.addMaterial(solidMaterial(glm::vec3(0.85f, 0.45f, 0.25f), 48.0f, 0.2f));
+    spin.spinSpeed = -0.5f;
+    scene.addInstance(torus, glm::translate(glm::mat4(1.0f), glm::vec3(0.8f, 0.2f, 2.6f)), copper, spin);
+
+    return scene;
+}
+
+uint32_t addLoadedMesh(Scene& scene, const TriangleMesh& mesh, const glm::vec3& position, float size) {
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(-std::numeric_limits<float>::max());
+    for (const glm::vec3& p : mesh.positions) {
+        boundsMin = glm::min(boundsMin, p);
+        boundsMax = glm::max(boundsMax, p);
+    }
+    glm::vec3 extent = boundsMax - boundsMin;
+    float scale = size / std::max(std::max(extent.x, extent.y), std::max(extent.z, 1e-6f));
+
+    // uv가 있으면 줄무늬 텍스처 (보간 uv 확인용)
+    Material material = solidMaterial(glm::vec3(0.85f), 64.0f, 0.1f);
+    if (!mesh.uvs.empty() && scene.textures.size() < MAX_SCENE_TEXTURES) {
+        material.textureIndex = scene.addTexture(makeStripeTexture(64, 8, glm::vec3(0.95f, 0.9f, 0.8f),
+                                                              glm::vec3(0.55f, 0.3f, 0.2f)));
+    }
+
+    uint32_t firstTriangle = scene.meshTriangleCount();
+    uint32_t meshIndex = scene.addTriangleMesh(mesh, scene.addMaterial(material));
+
+    // 바닥 중심을 원점으로 → 크기 맞춤 → position
+    glm::vec3 pivot((boundsMin.x + boundsMax.x) * 0.5f, boundsMin.y, (boundsMin.z + boundsMax.z) * 0.5f);
+    glm::mat4 transform = glm::translate(glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(scale)),
+                                         -pivot);
+    InstanceAnimation spin;
+    spin.spinSpeed = 0.3f;
+    scene.addInstance(meshIndex, transform, MATERIAL_FROM_MESH, spin);
+    return scene.meshTriangleCount() - firstTriangle;
+}
+
+void addRandomObjects(Scene& scene, uint32_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // 재질은 16개를 돌려 씀 (재질 수가 아니라 instance 수에 따른 비용만 보기 위해)
+    const uint32_t materialCount = 16;
+    uint32_t firstMaterial = static_cast<uint32_t>(scene.materials.size());
+    for (uint32_t i = 0; i < materialCount; i++) {
+        glm::vec3 color(0.2f + 0.7f * unit(rng), 0.2f + 0.7f * unit(rng), 0.2f + 0.7f * unit(rng));
+        bool shiny = unit(rng) < 0.3f;
+        scene.addMaterial(solidMaterial(color, shiny ? 96.0f : 16.0f, shiny ? 0.3f : 0.0f));
+    }
+
+    // 바닥에 닿는 단위 크기 mesh 3개 (y = 0 ~ 2)
+    uint32_t sphereMesh = scene.addMesh({makeSphere(glm::vec3(0.0f, 1.0f, 0.0f), 1.0f, firstMaterial)});
+    uint32_t boxMesh = scene.addMesh({makeBox(glm::vec3(-1.0f, 0.0f, -1.0f), glm::vec3(1.0f, 2.0f, 1.0f), firstMaterial)});
+    uint32_t triangleMesh = scene.addMesh({makeTriangle(glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f),
+                                                        glm::vec3(0.0f, 2.0f, 0.0f), firstMaterial)});
+    const uint32_t meshes[3] = {sphereMesh, boxMesh, triangleMesh};
+
+    // 데모 오브젝트를 가리지 않도록 반지름 4 ~ 4 + 면적 비례 고리 안에 배치
+    float innerRadius = 4.0f;
+    float outerRadius = innerRadius + std::sqrt(static_cast<float>(count)) * 0.35f;
+
+    for (uint32_t i = 0; i < count; i++) {
+        float angle = unit(rng) * 6.2831853f;
+        float radius = std::sqrt(glm::mix(innerRadius * innerRadius, outerRadius * outerRadius, unit(rng)));
+        glm::vec3 center(std::cos(angle) * radius, 0.0f, std::sin(angle) * radius);
+        float size = 0.1f + 0.2f * unit(rng);
+        float facing = unit(rng) * 6.2831853f;
+        uint32_t material = firstMaterial + static_cast<uint32_t>(unit(rng) * materialCount) % materialCount;
+
+        InstanceAnimation animation;
+        animation.bobHeight = 0.1f + 0.2f * unit(rng);
+        animation.phase = unit(rng) * 6.2831853f;
+        animation.spinSpeed = (i % 3 == 0) ? 0.0f : 0.5f + unit(rng);
+
+        glm::mat4 transform = glm::scale(
+            glm::rotate(glm::translate(glm::mat4(1.0f), center), facing, glm::vec3(0.0f, 1.0f, 0.0f)),
+            glm::vec3(size));
+        scene.addInstance(meshes[i % 3], transform, material, animation);
+    }
+}
+
+} // namespace rt
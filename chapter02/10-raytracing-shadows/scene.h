@@ -0,0 +1,171 @@
+#pragma once
+
+/**
+ * 레이 트레이서 장면 설명
+ *
+ * Primitive / Material은 raytrace.comp의 storage buffer와 같은 std430 레이아웃
+ * → C++에서 배열을 만들어 그대로 업로드
+ *
+ * 2단계 구성 (acceleration.h가 BLAS / TLAS로 변환)
+ * - Mesh: object space primitive 묶음 (정적, BLAS 하나)
+ * - Instance: mesh + 변환 (+ 재질 덮어쓰기), 움직이는 것은 instance 변환뿐
+ * - 평면은 무한이라 instance 없이 월드 공간 목록으로 따로
+ *
+ * 인덱스 삼각형 mesh (addTriangleMesh): 정점 위치 / 노말 / uv와 인덱스는 장면 전체가 공유하는 배열
+ * (raytrace.comp binding 21 ~ 24), primitive는 삼각형마다 AABB와 삼각형 번호만 가짐
+ * → BVH 빌드 / refit은 다른 primitive와 같고, 교차 검사가 인덱스로 정점을 읽음
+ * 텍스처는 CPU에서 만든 RGBA8 이미지 (binding 25의 sampler 배열), 재질이 번호로 가리킴
+ */
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace rt {
+
+enum PrimitiveType : uint32_t {
+    PRIMITIVE_SPHERE = 0,    // p0 = 중심, param = 반지름
+    PRIMITIVE_PLANE = 1,     // p0 = 단위 노말, param = dot(노말, 평면 위의 점)
+    PRIMITIVE_TRIANGLE = 2,  // p0, p1, p2 = 꼭짓점 (양면)
+    PRIMITIVE_BOX = 3,       // p0 = min, p1 = max (축 정렬)
+    PRIMITIVE_MESH_TRIANGLE = 4  // p0 / p1 = AABB, param 비트 = 삼각형 번호 (triangleIndices[3 * 번호 ..]), 양면
+};
+
+// std430에서 vec3 뒤의 스칼라는 같은 16 byte에 들어감 → 48 byte
+struct Primitive {
+    glm::vec3 p0;
+    uint32_t type;
+    glm::vec3 p1;
+    uint32_t material;
+    glm::vec3 p2;
+    float param;
+};
+static_assert(sizeof(Primitive) == 48, "Primitive must match raytrace.comp (std430)");
+
+// PRIMITIVE_MESH_TRIANGLE의 삼각형 번호 (param의 비트, 셰이더는 floatBitsToUint)
+inline uint32_t meshTriangleIndex(const Primitive& primitive) {
+    uint32_t index;
+    std::memcpy(&index, &primitive.param, sizeof(index));
+    return index;
+}
+
+enum MaterialPattern : uint32_t {
+    PATTERN_SOLID = 0,
+    PATTERN_CHECKER = 1  // 월드 xz 체커보드 (color / color2)
+};
+
+struct Material {
+    glm::vec3 color;
+    float shininess;
+    glm::vec3 color2;    // 체커보드의 두 번째 색
+    float reflectivity;  // 반사색과 섞는 비율 (0 = 반사 광선 없음)
+    uint32_t pattern;    // MaterialPattern
+    float patternScale;
+    uint32_t textureIndex;  // Scene::textures 번호 (NO_TEXTURE = 없음), uv가 있는 mesh 삼각형에서 색에 곱함
+    float padding;
+};
+static_assert(sizeof(Material) == 48, "Material must match raytrace.comp (std430)");
+
+constexpr uint32_t NO_TEXTURE = 0xFFFFFFFFu;
+constexpr uint32_t MAX_SCENE_TEXTURES = 16;  // raytrace.comp의 sampler 배열 크기
+
+// RGBA8 텍스처 (선형 값, repeat + bilinear, mip 없음)
+struct Texture {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> rgba;
+};
+
+// 인덱스 삼각형 mesh 입력 (object space)
+struct TriangleMesh {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;  // 비었으면 addTriangleMesh가 면 노말의 면적 가중 평균으로 만듦
+    std::vector<glm::vec2> uvs;      // 비었으면 (0, 0)
+    std::vector<uint32_t> indices;   // 삼각형마다 3개
+};
+
+// Mesh = scene.primitives의 연속 범위 (object space)
+struct Mesh {
+    uint32_t firstPrimitive;
+    uint32_t primitiveCount;
+};
+
+// instance가 mesh의 primitive 재질을 그대로 쓸 때
+constexpr uint32_t MATERIAL_FROM_MESH = 0xFFFFFFFFu;
+
+// CPU 쪽 애니메이션 (GPU에는 계산된 변환만 올라감)
+struct InstanceAnimation {
+    float spinSpeed = 0.0f;  // local y축 회전 (rad/s)
+    float bobHeight = 0.0f;  // 월드 y 상하 진폭
+    float phase = 0.0f;
+};
+
+struct Instance {
+    glm::mat4 transform;  // object → world (정지 상태)
+    uint32_t mesh;
+    uint32_t material;    // MATERIAL_FROM_MESH = primitive 재질
+    InstanceAnimation animation;
+};
+
+struct Scene {
+    std::vector<Primitive> primitives;  // mesh별로 연속 (object space)
+    std::vector<Mesh> meshes;
+    std::vector<Instance> instances;
+    std::vector<Primitive> planes;      // 월드 공간
+    std::vector<Material> materials;
+    std::vector<Texture> textures;      // MAX_SCENE_TEXTURES개까지
+
+    // 인덱스 삼각형 mesh의 정점 (모든 mesh를 이어 붙임, std430 배열: vec4 / vec4 / vec2 / uint)
+    std::vector<glm::vec4> vertexPositions;  // w = 0
+    std::vector<glm::vec4> vertexNormals;    // w = 0
+    std::vector<glm::vec2> vertexUvs;
+    std::vector<uint32_t> triangleIndices;   // 삼각형마다 3개, 절대 정점 번호
+
+    uint32_t addMaterial(const Material& material);
+    uint32_t addTexture(const Texture& texture);
+    // 평면은 mesh에 넣을 수 없음 (무한 → BLAS를 만들 수 없음)
+    uint32_t addMesh(const std::vector<Primitive>& meshPrimitives);
+    // 정점을 공유 배열에 붙이고 삼각형마다 PRIMITIVE_MESH_TRIANGLE 하나인 mesh를 만듦 (넓이 0인 삼각형은 버림)
+    uint32_t addTriangleMesh(const TriangleMesh& mesh, uint32_t material);
+    uint32_t addInstance(uint32_t mesh, const glm::mat4& transform, uint32_t material = MATERIAL_FROM_MESH,
+                         const InstanceAnimation& animation = {});
+    uint32_t addPlane(const glm::vec3& normal, float offset, uint32_t material);
+
+    uint32_t primitiveCountInInstances() const;  // instance를 펼쳤을 때 primitive 수
+    uint32_t meshTriangleCount() const;          // 인덱스 삼각형 수 (instance 중복 없이)
+};
+
+Primitive makeSphere(const glm::vec3& center, float radius, uint32_t material);
+Primitive makeTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, uint32_t material);
+Primitive makeBox(const glm::vec3& min, const glm::vec3& max, uint32_t material);
+
+Material solidMaterial(const glm::vec3& color, float shininess, float reflectivity = 0.0f);
+
+// 절차적 텍스처: uv 체커 (cells x cells칸), 가로 줄무늬 (stripes개)
+Texture makeCheckerTexture(uint32_t size, uint32_t cells, const glm::vec3& colorA, const glm::vec3& colorB);
+Texture makeStripeTexture(uint32_t size, uint32_t stripes, const glm::vec3& colorA, const glm::vec3& colorB);
+
+// Wavefront OBJ (v / vt / vn / f, 다각형은 fan으로 삼각형 분할, 음수 인덱스 지원, 재질 / 그룹은 무시)
+// 면마다 정점 (v / vt / vn 조합)을 새로 만들지 않고 같은 조합은 공유
+// 노말이 없는 파일은 normals를 비워 둠 (addTriangleMesh가 생성)
+bool loadObj(const std::string& path, TriangleMesh& mesh, std::string& error);
+
+// 애니메이션을 적용한 object → world 변환
+glm::mat4 animatedTransform(const Instance& instance, float time);
+
+// 기존 데모 장면 (메인 구 = instance 0 / material 0, 녹색/빨간 구, 체커보드 바닥)
+// + 박스, 삼각형 사각뿔, 회전하는 토러스 (부드러운 노말 + uv 체커 텍스처 인덱스 mesh) 2개
+Scene createDefaultScene();
+
+// mesh를 바닥 (y = 0) 위 position에 가장 긴 변이 size가 되도록 놓는 instance 하나 추가 (천천히 회전)
+// 반환 = 삼각형 수 (넓이 0인 삼각형을 뺀 것)
+uint32_t addLoadedMesh(Scene& scene, const TriangleMesh& mesh, const glm::vec3& position, float size);
+
+// 바닥 위 고리 영역에 무작위 구/박스/삼각형 instance를 count개 추가 (seed가 같으면 같은 장면)
+// 세 종류 모두 단위 mesh 하나를 공유하고 instance 변환과 재질만 다름
+void addRandomObjects(Scene& scene, uint32_t count, uint32_t seed);
+
+} // namespace rt
@@ -1,13 +1,61 @@
 #version 450
 
 // Fullscreen quad fragment shader
+// 동적 해상도: rtImage의 왼쪽 아래 renderSize 영역만 이번 프레임 결과 → 그 영역을 화면 전체로 확대
+// upscaleMode 0 = bilinear, 1 = edge-aware (Catmull-Rom 4x4, 가까운 2x2 텍셀의 최소 / 최대로 clamp)
+// Catmull-Rom은 가장자리를 선명하게 살리고, clamp가 가장자리 양옆의 overshoot (링잉)을 막음
 
 layout(location = 0) in vec2 inUV;
 layout(location = 0) out vec4 outColor;
 
 layout(binding = 0) uniform sampler2D texSampler;
 
+layout(push_constant) uniform UpscalePushConstants {
+    ivec2 renderSize;
+    int upscaleMode;
+} pc;
+
+const int UPSCALE_BILINEAR = 0;
+
+vec3 fetch(ivec2 p) {
+    return texelFetch(texSampler, clamp(p, ivec2(0), pc.renderSize - 1), 0).rgb;
+}
+
+// Catmull-Rom 가중치 (t = 텍셀 사이 위치, 탭 -1, 0, 1, 2)
+vec4 catmullRom(float t) {
+    return vec4(
+        t * (-0.5 + t * (1.0 - 0.5 * t)),
+        1.0 + t * t * (-2.5 + 1.5 * t),
+        t * (0.5 + t * (2.0 - 1.5 * t)),
+        t * t * (-0.5 + 0.5 * t));
+}
+
 void main() {
     vec2 uv = vec2(inUV.x, 1.0 - inUV.y);  // Y flip
-    outColor = texture(texSampler, uv);
+    vec2 pixel = uv * vec2(pc.renderSize) - 0.5;  // 텍셀 중심 기준
+    ivec2 base = ivec2(floor(pixel));
+    vec2 f = pixel - vec2(base);
+
+    vec3 c00 = fetch(base);
+    vec3 c10 = fetch(base + ivec2(1, 0));
+    vec3 c01 = fetch(base + ivec2(0, 1));
+    vec3 c11 = fetch(base + ivec2(1, 1));
+
+    if (pc.upscaleMode == UPSCALE_BILINEAR) {
+        outColor = vec4(mix(mix(c00, c10, f.x), mix(c01, c11, f.x), f.y), 1.0);
+        return;
+    }
+
+    vec4 wx = catmullRom(f.x);
+    vec4 wy = catmullRom(f.y);
+    vec3 color = vec3(0.0);
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            color += fetch(base + ivec2(x - 1, y - 1)) * (wx[x] * wy[y]);
+        }
+    }
+
+    vec3 lo = min(min(c00, c10), min(c01, c11));
+    vec3 hi = max(max(c00, c10), max(c01, c11));
+    outColor = vec4(clamp(color, lo, hi), 1.0);
 }
@@ -0,0 +1,71 @@
+#include "task_pool.h"
+
+#include <algorithm>
+
+namespace rt {
+
+TaskPool::TaskPool(unsigned threadCount) {
+    threadCount = std::max(threadCount, 1u);
+    for (unsigned i = 1; i < threadCount; i++) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void TaskPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+        pending++;
+    }
+    taskAvailable.notify_one();
+    allDone.notify_all();  // wait() 중인 스레드도 새 작업을 가져갈 수 있도록
+}
+
+void TaskPool::runTask(std::function<void()>& task, std::unique_lock<std::mutex>& lock) {
+    lock.unlock();
+    task();
+    lock.lock();
+    if (--pending == 0) {
+        allDone.notify_all();
+    }
+}
+
+void TaskPool::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+        if (tasks.empty()) {
+            return;  // stopping
+        }
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        runTask(task, lock);
+    }
+}
+
+void TaskPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (pending > 0) {
+        if (!tasks.empty()) {
+            // 나중에 들어온 (작은) 작업부터 → 큐 앞의 큰 작업은 워커가 가져감
+            std::function<void()> task = std::move(tasks.back());
+            tasks.pop_back();
+            runTask(task, lock);
+        } else {
+            allDone.wait(lock, [this] { return pending == 0 || !tasks.empty(); });
+        }
+    }
+}
+
+} // namespace rt
@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * 작은 작업 풀 (BVH 빌드처럼 작업이 작업을 만드는 재귀 분할용)
+ *
+ * submit()은 작업 안에서도 호출 가능, wait()을 부른 스레드도 큐의 작업을 함께 실행
+ * → 재귀 빌드가 자식 작업을 기다리며 스레드를 놀리지 않음
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rt {
+
+class TaskPool {
+public:
+    // threadCount = 작업을 실행하는 전체 스레드 수 (wait()을 호출하는 스레드 포함)
+    explicit TaskPool(unsigned threadCount = std::thread::hardware_concurrency());
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // 지금까지 제출된 (그리고 그 작업들이 제출한) 작업이 모두 끝날 때까지
+    void wait();
+
+    unsigned threadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+private:
+    void workerLoop();
+    void runTask(std::function<void()>& task, std::unique_lock<std::mutex>& lock);
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable allDone;
+    size_t pending = 0;  // 큐에 있거나 실행 중인 작업 수
+    bool stopping = false;
+};
+
+} // namespace rt
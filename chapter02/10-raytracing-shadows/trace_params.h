@@ -0,0 +1,158 @@
+#pragma once
+
+/**
+ * raytrace.comp의 push constant (카메라 / 조명 / 토글 / 누적 상태)
+ *
+ * GPU와 CPU 레퍼런스 트레이서 (cpu_tracer.h)가 같은 구조체를 그대로 받음
+ * 장면 자체는 storage buffer (acceleration.h)
+ *
+ * wavefront 경로 추적의 큐 원소 / 카운터 레이아웃도 여기 (raytrace.comp의 binding 10 ~ 14)
+ * 가변 밀도 타일 값도 여기 (binding 19 / 20)
+ * 2차 광선 정렬 버퍼 크기도 여기 (binding 26)
+ */
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace rt {
+
+struct RayTracePushConstants {
+    glm::vec4 cameraPos;     // xyz = position, w = fov
+    glm::vec4 lightPos;      // xyz = position, w = intensity
+    float shadowIntensity;
+    int showShadows;
+    int reflections;
+    int useBvh;
+    uint32_t tlasNodeCount;
+    uint32_t instanceCount;
+    uint32_t planeFirst;     // 평면 = primitives[planeFirst ..] (BLAS primitive 뒤)
+    uint32_t planeCount;
+    glm::vec4 prevCameraPos; // 이전 프레임 카메라 (재투영)
+    uint32_t frameIndex;     // jitter 시퀀스 인덱스 (누적 프레임 수)
+    uint32_t historyMode;    // HistoryMode
+    uint32_t maxSamples;
+    int jitter;
+    uint32_t renderMode;     // RenderMode
+    uint32_t maxBounces;     // 경로 추적 튕김 횟수 (0 = 직접광만)
+    uint32_t bounce;         // wavefront 단계의 튕김 번호 (호스트가 단계마다 다시 push)
+    uint32_t renderWidth;    // 동적 해상도: 이번 프레임에 추적하는 영역 (이미지 왼쪽 아래 부분)
+    uint32_t renderHeight;
+    int variableRate;        // 평탄한 16x16 타일은 2x2마다 광선 하나 (megakernel만)
+    uint32_t frameCounter;   // 누적과 무관하게 매 프레임 증가 (타일 밀도 주기적 재검사)
+    int sortRays;            // wavefront: 다음 튕김 광선 / 그림자 광선 큐를 방향 + 원점으로 정렬해서 추적
+};
+static_assert(sizeof(RayTracePushConstants) <= 128, "Push constants must fit the guaranteed 128 bytes");
+
+// raytrace.comp의 HISTORY_*
+enum HistoryMode : uint32_t {
+    HISTORY_RESET = 0,      // history 무시 (장면 / 설정 변경, 누적 끔)
+    HISTORY_STATIC = 1,     // 카메라 그대로 → 같은 픽셀에 누적
+    HISTORY_REPROJECT = 2   // 카메라만 움직임 → 이전 카메라로 재투영
+};
+
+// raytrace.comp의 RENDER_* (CPU 레퍼런스는 Whitted만)
+enum RenderMode : uint32_t {
+    RENDER_WHITTED = 0,          // 직접광 + 반사 1번
+    RENDER_PATH_MEGAKERNEL = 1,  // 경로 추적, 픽셀당 invocation 하나가 모든 튕김
+    RENDER_PATH_WAVEFRONT = 2    // 같은 경로 추적을 단계별 pipeline + 광선 큐로
+};
+
+// raytrace.comp의 specialization constant STAGE
+enum TraceStage : uint32_t {
+    STAGE_MEGAKERNEL = 0,
+    STAGE_GENERATE = 1,
+    STAGE_EXTEND = 2,
+    STAGE_SHADE = 3,
+    STAGE_CONNECT = 4,
+    STAGE_RESOLVE = 5,
+    STAGE_DISPATCH_ARGS = 6,
+    STAGE_SORT_COUNT = 7,
+    STAGE_SORT_SCAN = 8,
+    STAGE_SORT_SCATTER = 9,
+    TRACE_STAGE_COUNT = 10
+};
+
+constexpr uint32_t MAX_PATH_BOUNCES = 8;
+
+// raytrace.comp의 TILE_RATE_* (binding 19 / 20, 16x16 work group 타일마다 하나)
+enum TileRate : uint32_t {
+    TILE_RATE_FULL = 0,  // 모든 픽셀 추적 (0으로 초기화된 버퍼 = 전부 full)
+    TILE_RATE_HALF = 1   // 2x2마다 왼쪽 아래 픽셀만 추적, 나머지 셋은 그 결과를 복사
+};
+constexpr uint32_t RATE_TILE_SIZE = 16;
+
+// 큐 원소 (경로 인덱스 = 픽셀 인덱스)
+struct WavefrontPath {
+    glm::vec3 throughput;
+    float primaryT;
+    glm::vec3 radiance;
+    uint32_t padding;
+};
+
+struct WavefrontRay {
+    glm::vec3 origin;
+    uint32_t pathIndex;
+    glm::vec3 direction;
+    uint32_t padding;
+};
+
+struct WavefrontHit {
+    glm::vec3 origin;
+    uint32_t pathIndex;
+    glm::vec3 direction;
+    float t;
+    uint32_t primitive;
+    uint32_t instance;
+    uint32_t padding0;
+    uint32_t padding1;
+};
+
+struct WavefrontShadow {
+    glm::vec3 origin;
+    uint32_t pathIndex;
+    glm::vec3 direction;
+    float tMax;
+    glm::vec3 contribution;
+    uint32_t padding;
+};
+static_assert(sizeof(WavefrontPath) == 32 && sizeof(WavefrontRay) == 32, "Must match raytrace.comp");
+static_assert(sizeof(WavefrontHit) == 48 && sizeof(WavefrontShadow) == 48, "Must match raytrace.comp");
+
+// raytrace.comp의 COHERENCE_* (traversal SIMD 효율 통계 종류)
+enum CoherenceKind : uint32_t {
+    COHERENCE_PRIMARY = 0,     // wavefront 주 광선
+    COHERENCE_SECONDARY = 1,   // wavefront 튕긴 광선 (반사 / 난반사)
+    COHERENCE_SHADOW = 2,      // wavefront 그림자 광선
+    COHERENCE_MEGAKERNEL = 3,  // megakernel (한 invocation이 모든 광선을 inline으로)
+    COHERENCE_KINDS = 4
+};
+
+// 튕김별 큐 길이 + 단계별 VkDispatchIndirectCommand (x, y, z, padding)
+// traversal 통계는 megakernel도 씀 (subgroup마다 Σ 방문 노드, Σ 최대 방문 노드 × 활성 lane)
+struct WavefrontCounters {
+    uint32_t extendArgs[4];
+    uint32_t shadeArgs[4];
+    uint32_t connectArgs[4];
+    uint32_t sortArgs[4];
+    uint32_t rayCount[MAX_PATH_BOUNCES + 1];
+    uint32_t hitCount[MAX_PATH_BOUNCES + 1];
+    uint32_t shadowCount[MAX_PATH_BOUNCES + 1];
+    uint32_t traversalSteps[COHERENCE_KINDS];
+    uint32_t traversalLaneSteps[COHERENCE_KINDS];
+
+    // SIMD 효율 (1 = subgroup의 모든 lane이 같은 수의 노드 방문), 통계가 없으면 0
+    double simdEfficiency(CoherenceKind kind) const {
+        return traversalLaneSteps[kind] ? double(traversalSteps[kind]) / traversalLaneSteps[kind] : 0.0;
+    }
+};
+
+// 2차 광선 정렬 (raytrace.comp의 RaySortBuffer): key = 방향 8분면 (3비트) + 원점 Morton 코드 (축마다 3비트)
+// 표 2개 (다음 튕김 광선 / 그림자) × bin 개수 / 시작 위치, 그 뒤 표마다 큐 용량만큼 bin 안 순번과 정렬된 순서
+constexpr uint32_t SORT_BIN_COUNT = 8u << 9;
+constexpr uint32_t SORT_TABLES = 2;
+inline uint64_t raySortBufferSize(uint64_t queueCapacity) {
+    return (2ull * SORT_TABLES * SORT_BIN_COUNT + 2ull * SORT_TABLES * queueCapacity) * sizeof(uint32_t);
+}
+
+} // namespace rt
@@ -0,0 +1,355 @@
+#include "vk_mipmap.h"
+#include "vk_pipeline.h"
+#include <stdexcept>
+#include <array>
+#include <algorithm>
+
+namespace vk
+{
+    VulkanMipGenerator::~VulkanMipGenerator()
+    {
+        destroy();
+    }
+
+    void VulkanMipGenerator::create(VkPhysicalDevice physDevice,
+                                    VkDevice dev,
+                                    const std::string& shaderPath,
+                                    uint32_t maxTargets)
+    {
+        physicalDevice = physDevice;
+        device = dev;
+
+        createDescriptorSetLayout();
+        createDescriptorPool(maxTargets);
+        createPipeline(shaderPath);
+
+        std::cout << "✓ Mip generator created\n";
+    }
+
+    void VulkanMipGenerator::createDescriptorSetLayout()
+    {
+        std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+
+        // 0: level별 storage image
+        bindings[0].binding = 0;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[0].descriptorCount = MAX_MIP_LEVELS;
+        bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        // 1: 완료한 workgroup 카운터
+        bindings[1].binding = 1;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create mip generator descriptor set layout!");
+        }
+    }
+
+    void VulkanMipGenerator::createDescriptorPool(uint32_t maxTargets)
+    {
+        std::array<VkDescriptorPoolSize, 2> poolSizes{};
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        poolSizes[0].descriptorCount = MAX_MIP_LEVELS * maxTargets;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSizes[1].descriptorCount = maxTargets;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;  // target 단위 해제
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+        poolInfo.maxSets = maxTargets;
+
+        if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create mip generator descriptor pool!");
+        }
+    }
+
+    void VulkanMipGenerator::createPipeline(const std::string& shaderPath)
+    {
+        auto shaderCode = VulkanPipeline::readShaderFile(shaderPath);
+
+        VkShaderModuleCreateInfo moduleInfo{};
+        moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleInfo.codeSize = shaderCode.size();
+        moduleInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
+
+        VkShaderModule shaderModule;
+        if (vkCreateShaderModule(device, &moduleInfo, nullptr, &shaderModule) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create mip generator shader module!");
+        }
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(PushConstants);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create mip generator pipeline layout!");
+        }
+
+        VkPipelineShaderStageCreateInfo stageInfo{};
+        stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        stageInfo.module = shaderModule;
+        stageInfo.pName = "main";
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage = stageInfo;
+        pipelineInfo.layout = pipelineLayout;
+
+        if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create mip generator pipeline!");
+        }
+
+        vkDestroyShaderModule(device, shaderModule, nullptr);
+    }
+
+    MipChainTarget VulkanMipGenerator::createTarget(VkImage image, VkExtent2D extent, uint32_t mipLevels)
+    {
+        if (extent.width > MAX_EXTENT || extent.height > MAX_EXTENT)
+        {
+            throw std::runtime_error("Mip generator supports images up to 4096x4096!");
+        }
+        if (mipLevels < 2 || mipLevels > mipLevelCount(extent))
+        {
+            throw std::runtime_error("Invalid mip level count for mip generator!");
+        }
+
+        MipChainTarget target;
+        target.image = image;
+        target.extent = extent;
+        target.mipLevels = mipLevels;
+
+        // Level별 storage view (R8G8B8A8_UNORM, sRGB 이미지도 mutable format으로 같은 view 사용)
+        target.levelViews.resize(mipLevels);
+        for (uint32_t level = 0; level < mipLevels; level++)
+        {
+            VkImageViewCreateInfo viewInfo{};
+            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.image = image;
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+            viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            viewInfo.subresourceRange.baseMipLevel = level;
+            viewInfo.subresourceRange.levelCount = 1;
+            viewInfo.subresourceRange.baseArrayLayer = 0;
+            viewInfo.subresourceRange.layerCount = 1;
+
+            if (vkCreateImageView(device, &viewInfo, nullptr, &target.levelViews[level]) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to create mip level image view!");
+            }
+        }
+
+        // 완료 카운터 (device local, 매 generate마다 0으로 초기화)
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = sizeof(uint32_t);
+        bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (vkCreateBuffer(device, &bufferInfo, nullptr, &target.counterBuffer) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create mip generator counter buffer!");
+        }
+
+        VkMemoryRequirements memRequirements;
+        vkGetBufferMemoryRequirements(device, target.counterBuffer, &memRequirements);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        if (vkAllocateMemory(device, &allocInfo, nullptr, &target.counterMemory) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to allocate mip generator counter memory!");
+        }
+        vkBindBufferMemory(device, target.counterBuffer, target.counterMemory, 0);
+
+        // Descriptor set
+        VkDescriptorSetAllocateInfo setAllocInfo{};
+        setAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        setAllocInfo.descriptorPool = descriptorPool;
+        setAllocInfo.descriptorSetCount = 1;
+        setAllocInfo.pSetLayouts = &descriptorSetLayout;
+
+        if (vkAllocateDescriptorSets(device, &setAllocInfo, &target.descriptorSet) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to allocate mip generator descriptor set!");
+        }
+
+        // 배열 전체가 유효해야 하므로 없는 level 슬롯은 마지막 level view로 채움 (셰이더가 쓰지 않음)
+        std::array<VkDescriptorImageInfo, MAX_MIP_LEVELS> imageInfos{};
+        for (uint32_t level = 0; level < MAX_MIP_LEVELS; level++)
+        {
+            imageInfos[level].imageView = target.levelViews[std::min(level, mipLevels - 1)];
+            imageInfos[level].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        }
+
+        VkDescriptorBufferInfo counterInfo{};
+        counterInfo.buffer = target.counterBuffer;
+        counterInfo.range = VK_WHOLE_SIZE;
+
+        std::array<VkWriteDescriptorSet, 2> writes{};
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = target.descriptorSet;
+        writes[0].dstBinding = 0;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[0].descriptorCount = MAX_MIP_LEVELS;
+        writes[0].pImageInfo = imageInfos.data();
+
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = target.descriptorSet;
+        writes[1].dstBinding = 1;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[1].descriptorCount = 1;
+        writes[1].pBufferInfo = &counterInfo;
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+        return target;
+    }
+
+    void VulkanMipGenerator::destroyTarget(MipChainTarget& target)
+    {
+        if (target.descriptorSet != VK_NULL_HANDLE)
+        {
+            vkFreeDescriptorSets(device, descriptorPool, 1, &target.descriptorSet);
+            target.descriptorSet = VK_NULL_HANDLE;
+        }
+        for (VkImageView view : target.levelViews)
+        {
+            vkDestroyImageView(device, view, nullptr);
+        }
+        target.levelViews.clear();
+
+        if (target.counterBuffer != VK_NULL_HANDLE)
+        {
+            vkDestroyBuffer(device, target.counterBuffer, nullptr);
+            vkFreeMemory(device, target.counterMemory, nullptr);
+            target.counterBuffer = VK_NULL_HANDLE;
+            target.counterMemory = VK_NULL_HANDLE;
+        }
+        target.image = VK_NULL_HANDLE;
+    }
+
+    void VulkanMipGenerator::generate(VkCommandBuffer commandBuffer,
+                                      const MipChainTarget& target,
+                                      MipFilter filter,
+                                      bool srgb) const
+    {
+        // 1. 카운터 초기화 (이전 generate의 atomicAdd가 끝난 뒤 덮어씀)
+        VkMemoryBarrier reuseBarrier{};
+        reuseBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        reuseBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        reuseBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 1, &reuseBarrier, 0, nullptr, 0, nullptr);
+
+        vkCmdFillBuffer(commandBuffer, target.counterBuffer, 0, VK_WHOLE_SIZE, 0);
+
+        VkMemoryBarrier fillBarrier{};
+        fillBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        fillBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        fillBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &fillBarrier, 0, nullptr, 0, nullptr);
+
+        // 2. Dispatch: mip 0의 64x64 tile마다 workgroup 1개
+        uint32_t groupCountX = (target.extent.width + TILE_SIZE - 1) / TILE_SIZE;
+        uint32_t groupCountY = (target.extent.height + TILE_SIZE - 1) / TILE_SIZE;
+
+        PushConstants pc{};
+        pc.mipLevels = static_cast<int>(target.mipLevels);
+        pc.filterMode = static_cast<int>(filter);
+        pc.srgb = srgb ? 1 : 0;
+        pc.workGroupCount = static_cast<int>(groupCountX * groupCountY);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout,
+            0, 1, &target.descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(PushConstants), &pc);
+        vkCmdDispatch(commandBuffer, groupCountX, groupCountY, 1);
+    }
+
+    uint32_t VulkanMipGenerator::mipLevelCount(VkExtent2D extent)
+    {
+        uint32_t size = std::max(extent.width, extent.height);
+        uint32_t levels = 1;
+        while (size > 1)
+        {
+            size >>= 1;
+            levels++;
+        }
+        return levels;
+    }
+
+    uint32_t VulkanMipGenerator::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const
+    {
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
+        {
+            if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties)
+            {
+                return i;
+            }
+        }
+
+        throw std::runtime_error("Failed to find suitable memory type!");
+    }
+
+    void VulkanMipGenerator::destroy()
+    {
+        if (device != VK_NULL_HANDLE)
+        {
+            if (pipeline != VK_NULL_HANDLE)
+            {
+                vkDestroyPipeline(device, pipeline, nullptr);
+                pipeline = VK_NULL_HANDLE;
+            }
+            if (pipelineLayout != VK_NULL_HANDLE)
+            {
+                vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+                pipelineLayout = VK_NULL_HANDLE;
+            }
+            if (descriptorPool != VK_NULL_HANDLE)
+            {
+                vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+                descriptorPool = VK_NULL_HANDLE;
+            }
+            if (descriptorSetLayout != VK_NULL_HANDLE)
+            {
+                vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+                descriptorSetLayout = VK_NULL_HANDLE;
+            }
+            device = VK_NULL_HANDLE;
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <string>
+#include <iostream>
+
+namespace vk
+{
+    /**
+     * Mip 축소 필터
+     * - Box: 2x2 평균
+     * - Kaiser: 첫 축소 단계에 8x8 Kaiser-windowed sinc (고주파 텍스처의 aliasing 감소)
+     */
+    enum class MipFilter : int
+    {
+        Box = 0,
+        Kaiser = 1
+    };
+
+    /**
+     * Mip chain을 생성할 이미지 하나의 리소스
+     * (level별 storage view, descriptor set, 완료 카운터)
+     */
+    struct MipChainTarget
+    {
+        VkImage image = VK_NULL_HANDLE;  // Reference (not owned)
+        VkExtent2D extent{};
+        uint32_t mipLevels = 0;
+        std::vector<VkImageView> levelViews;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        VkBuffer counterBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory counterMemory = VK_NULL_HANDLE;
+    };
+
+    /**
+     * VulkanMipGenerator 모듈
+     *
+     * 학습 목표:
+     * 1. Compute shader로 mip chain 생성 (vkCmdBlitImage chain 대체)
+     * 2. Shared memory를 이용한 다단계 reduction
+     * 3. Global atomic counter로 "마지막 workgroup" 판별
+     * 4. sRGB 데이터의 선형 공간 평균
+     *
+     * Blit chain: level마다 blit + barrier → N level이면 N번의 GPU 동기화
+     * Single-pass: dispatch 1번
+     * - workgroup마다 mip 0의 64x64 tile → mip 1~6 (shared memory)
+     * - 마지막으로 끝난 workgroup이 mip 6 → mip 7~12
+     *
+     * 이미지 요구사항:
+     * - usage: VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+     * - mipLevels: mipLevelCount(extent), 최대 4096x4096
+     * - storage format은 R8G8B8A8_UNORM
+     *   (sRGB 텍스처는 VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT로 만들고 srgb = true로 생성)
+     */
+    class VulkanMipGenerator
+    {
+    public:
+        VulkanMipGenerator() = default;
+        virtual ~VulkanMipGenerator();
+
+        // Delete copy
+        VulkanMipGenerator(const VulkanMipGenerator&) = delete;
+        VulkanMipGenerator& operator=(const VulkanMipGenerator&) = delete;
+
+        /**
+         * Compute pipeline 생성
+         * @param shaderPath mip_downsample.comp SPIR-V 파일 경로
+         * @param maxTargets 동시에 등록할 수 있는 이미지 수 (descriptor pool 크기)
+         */
+        void create(VkPhysicalDevice physicalDevice,
+                    VkDevice device,
+                    const std::string& shaderPath,
+                    uint32_t maxTargets = 8);
+
+        /**
+         * 이미지를 등록하고 level별 view / descriptor set을 생성
+         */
+        MipChainTarget createTarget(VkImage image, VkExtent2D extent, uint32_t mipLevels);
+
+        void destroyTarget(MipChainTarget& target);
+
+        /**
+         * Mip 1 ~ (mipLevels - 1) 생성 명령 기록
+         * 호출 전: 모든 level이 GENERAL layout, mip 0 쓰기 완료 (compute read 가능)
+         * 호출 후: 사용하는 쪽에서 compute write → 샘플링 barrier 필요
+         */
+        void generate(VkCommandBuffer commandBuffer,
+                      const MipChainTarget& target,
+                      MipFilter filter,
+                      bool srgb) const;
+
+        /**
+         * 정리
+         */
+        void destroy();
+
+        /**
+         * extent에 필요한 전체 mip level 수 (mip 0 포함)
+         */
+        static uint32_t mipLevelCount(VkExtent2D extent);
+
+        static constexpr uint32_t MAX_MIP_LEVELS = 13;   // 4096 → 1
+        static constexpr uint32_t MAX_EXTENT = 4096;
+        static constexpr uint32_t TILE_SIZE = 64;         // workgroup 하나가 처리하는 mip 0 영역
+
+    protected:
+        VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;  // Reference (not owned)
+        VkDevice device = VK_NULL_HANDLE;                  // Reference (not owned)
+        VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+        VkPipeline pipeline = VK_NULL_HANDLE;
+
+    private:
+        struct PushConstants
+        {
+            int mipLevels;
+            int filterMode;
+            int srgb;
+            int workGroupCount;
+        };
+
+        void createDescriptorSetLayout();
+        void createDescriptorPool(uint32_t maxTargets);
+        void createPipeline(const std::string& shaderPath);
+        uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+    };
+}